@@ -2,6 +2,7 @@
 
 layout (location = 0) in vec2 a_quad_vertex;  // The corner of our quad (-0.5 to 0.5)
 layout (location = 1) in vec3 a_particle_position;
+layout (location = 2) in float a_particle_scale;  // 1 for a single particle, larger for merged ones
 
 uniform mat4 u_projection_matrix;
 uniform mat4 u_view_matrix;
@@ -15,7 +16,7 @@ void main() {
     vec4 camera_space_pos = u_view_matrix * vec4(a_particle_position, 1.0);
     v_distance_to_camera = length(camera_space_pos.xyz);
     
-    camera_space_pos.xy += a_quad_vertex * u_particle_size;
+    camera_space_pos.xy += a_quad_vertex * u_particle_size * a_particle_scale;
     
     v_quad_coord = a_quad_vertex;
 
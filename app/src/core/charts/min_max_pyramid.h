@@ -0,0 +1,125 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief An append-only series of data points with an incrementally maintained min/max pyramid.
+ *
+ * Level k of the pyramid splits the series into buckets of 2^(k+1) consecutive points and stores
+ * the indices of the minimum and maximum point of each bucket. A bucket is added once all of its
+ * points are known, by merging two buckets of the level below, so append() is O(1) amortized and
+ * the pyramid adds less memory than the points themselves.
+ *
+ * downsample() picks the finest level with at most one bucket per output column and emits the
+ * first, minimum, maximum and last point of each bucket (the M4 aggregation). For a line chart
+ * with one column per pixel this draws the same pixels as the full series, at a cost that depends
+ * only on the number of columns and not on the length of the series.
+ *
+ * @tparam PointT The type of the points in the data series. Must provide .x() and .y() methods.
+ *         Points must be appended in ascending order of x.
+ */
+template <typename PointT>
+class MinMaxPyramid {
+public:
+    /**
+     * @brief Appends a point to the end of the series.
+     */
+    void append(const PointT& point) {
+        points_.push_back(point);
+
+        // Every completed pair of buckets completes a bucket on the next level.
+        size_t count = points_.size();
+        for (size_t level = 0; count % 2 == 0; ++level, count /= 2) {
+            if (level == levels_.size()) levels_.emplace_back();
+
+            const auto last = static_cast<uint32_t>(points_.size() - 1);
+            if (level == 0) {
+                levels_[0].push_back(merge({last - 1, last - 1}, {last, last}));
+            } else {
+                const auto& below = levels_[level - 1];
+                levels_[level].push_back(merge(below[below.size() - 2], below.back()));
+            }
+        }
+    }
+
+    /**
+     * @brief Removes all points.
+     */
+    void clear() {
+        points_.clear();
+        levels_.clear();
+    }
+
+    /**
+     * @brief Returns the number of points in the series.
+     */
+    [[nodiscard]] size_t size() const { return points_.size(); }
+
+    /**
+     * @brief Returns all points of the series.
+     */
+    [[nodiscard]] const std::vector<PointT>& points() const { return points_; }
+
+    /**
+     * @brief Reduces the series to about @p columns buckets for drawing.
+     * @param columns The number of columns the series is drawn into, e.g. the chart width in
+     *        pixels.
+     * @return At most four points per column, plus a few points for the most recent part of the
+     *         series that does not fill a bucket yet. The full series if it is small enough.
+     */
+    [[nodiscard]] std::vector<PointT> downsample(size_t columns) const {
+        if (points_.size() <= kPointsPerBucket * std::max<size_t>(columns, 1)) return points_;
+
+        // The coarsest level is never empty here, so a level with few enough buckets exists.
+        size_t level = 0;
+        while (level + 1 < levels_.size() && levels_[level].size() > columns) ++level;
+
+        std::vector<PointT> sampled;
+        sampled.reserve(kPointsPerBucket * (levels_[level].size() + level + 1));
+
+        // Whole buckets of the chosen level, then the remainder from successively finer levels.
+        size_t covered = 0;
+        for (size_t l = level + 1; l-- > 0;) {
+            const size_t span = size_t{2} << l;
+            for (size_t bucket = covered / span; bucket < levels_[l].size(); ++bucket) {
+                appendBucket(sampled, levels_[l][bucket], bucket * span, span);
+            }
+            covered = levels_[l].size() * span;
+        }
+        sampled.insert(sampled.end(), points_.begin() + covered, points_.end());
+
+        return sampled;
+    }
+
+private:
+    static constexpr size_t kPointsPerBucket = 4;
+
+    // Indices of the points with the smallest and largest y-value.
+    struct Bucket {
+        uint32_t min;
+        uint32_t max;
+    };
+
+    Bucket merge(Bucket left, Bucket right) const {
+        return {points_[right.min].y() < points_[left.min].y() ? right.min : left.min,
+                points_[right.max].y() > points_[left.max].y() ? right.max : left.max};
+    }
+
+    /**
+     * @brief Appends the first, minimum, maximum and last point of a bucket in order of x.
+     */
+    void appendBucket(std::vector<PointT>& out, Bucket bucket, size_t first, size_t span) const {
+        std::array<size_t, 4> indices = {first, bucket.min, bucket.max, first + span - 1};
+        std::ranges::sort(indices);
+        for (size_t i = 0; i < indices.size(); ++i) {
+            if (i == 0 || indices[i] != indices[i - 1]) out.push_back(points_[indices[i]]);
+        }
+    }
+
+    std::vector<PointT> points_;
+    std::vector<std::vector<Bucket>> levels_;  // levels_[k] has buckets of 2^(k+1) points
+};
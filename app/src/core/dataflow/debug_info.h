@@ -1,5 +1,7 @@
 #pragma once
 
+#include <enkas/tracing/latency_histogram.h>
+
 #include <atomic>
 #include <cstddef>
 #include <limits>
@@ -24,13 +26,42 @@ struct LiveDebugInfo {
     std::atomic<size_t> diagnostics_snapshot_pool_size = 0;
     size_t diagnostics_snapshot_pool_capacity = 0;
 
+    // Memory held by all pools, in MiB
+    std::atomic<size_t> pool_memory_mib = 0;
+    size_t pool_memory_capacity_mib = 0;
+
     // Consumer queue statistics
     std::atomic<size_t> chart_queue_size = 0;
     size_t chart_queue_capacity = 0;
 
+    // Largest number of diagnostics snapshots handed to the charts in one frame
+    std::atomic<size_t> chart_batch_size = 0;
+    size_t chart_batch_capacity = 0;
+
     std::atomic<size_t> system_storage_queue_size = QUEUE_NOT_PRESENT;
     size_t system_storage_queue_capacity = QUEUE_NOT_PRESENT;
 
     std::atomic<size_t> diagnostics_storage_queue_size = QUEUE_NOT_PRESENT;
     size_t diagnostics_storage_queue_capacity = QUEUE_NOT_PRESENT;
+
+    // Backpressure statistics: snapshots dropped or spilled out of all snapshots offered
+    std::atomic<size_t> chart_queue_dropped = 0;
+    size_t chart_queue_offered = 0;
+
+    std::atomic<size_t> system_storage_queue_dropped = QUEUE_NOT_PRESENT;
+    std::atomic<size_t> system_storage_queue_spilled = QUEUE_NOT_PRESENT;
+    size_t system_storage_queue_offered = QUEUE_NOT_PRESENT;
+
+    std::atomic<size_t> diagnostics_storage_queue_dropped = QUEUE_NOT_PRESENT;
+    std::atomic<size_t> diagnostics_storage_queue_spilled = QUEUE_NOT_PRESENT;
+    size_t diagnostics_storage_queue_offered = QUEUE_NOT_PRESENT;
+
+    // Latency histograms of the pipeline stages
+    enkas::tracing::LatencyHistogram step_latency;          // One simulation step, end to end
+    enkas::tracing::LatencyHistogram force_latency;         // One force evaluation
+    enkas::tracing::LatencyHistogram pool_acquire_latency;  // Waiting for a memory pool buffer
+    enkas::tracing::LatencyHistogram queue_push_latency;    // Pushing onto an output queue
+    // Writing one batch to a file, per storage writer
+    enkas::tracing::LatencyHistogram system_file_write_latency;
+    enkas::tracing::LatencyHistogram diagnostics_file_write_latency;
 };
@@ -1,11 +1,21 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <memory>
-#include <mutex>
 #include <utility>
 
 /**
  * @brief A thread-safe, single-element queue with overwrite semantics.
+ *
+ * Implemented as a wait-free triple buffer: the producer writes into its own back buffer and
+ * publishes it by swapping it with the shared middle buffer, and the consumer picks up the middle
+ * buffer by swapping it with its own front buffer. Each hand-off is a single atomic exchange, so
+ * neither side can ever be blocked by the other.
+ *
+ * The slot is meant for exactly one producer thread and one consumer thread.
+ *
  * @tparam T The type of the object stored in the shared_ptr.
  */
 template <typename T>
@@ -24,31 +34,44 @@ public:
     /**
      * @brief Writes data to the slot, overwriting any previous data.
      *
-     * This method is intended for the producer thread.
+     * This method is intended for the producer thread. A value that was never taken is released
+     * by the producer on a later call.
      * @param data The shared_ptr to the data to be stored.
      */
     void set(Ptr data) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        slot_ = std::move(data);
+        buffers_[back_].value = std::move(data);
+        const uint8_t previous = middle_.exchange(back_ | kFreshBit, std::memory_order_acq_rel);
+        back_ = previous & kIndexMask;
     }
 
     /**
      * @brief Retrieves the data from the slot, leaving it empty.
      *
      * This method is intended for the consumer thread. It retrieves the
-     * currently stored shared_ptr and replaces it with nullptr atomically.
+     * most recently stored shared_ptr, if it has not been taken yet.
      *
      * @return The shared_ptr that was in the slot. Returns nullptr if the
      *         slot was already empty.
      */
     Ptr take() {
-        std::lock_guard<std::mutex> lock(mutex_);
-        Ptr data;
-        std::swap(data, slot_);
-        return data;
+        if ((middle_.load(std::memory_order_relaxed) & kFreshBit) == 0) return nullptr;
+
+        const uint8_t previous = middle_.exchange(front_, std::memory_order_acq_rel);
+        front_ = previous & kIndexMask;
+        return std::move(buffers_[front_].value);
     }
 
 private:
-    Ptr slot_ = nullptr;
-    mutable std::mutex mutex_;
+    static constexpr uint8_t kFreshBit = 0b100;  // Set while the middle buffer holds a new value
+    static constexpr uint8_t kIndexMask = 0b011;
+
+    // Separate cache lines so that writing one buffer does not evict the others.
+    struct alignas(64) Buffer {
+        Ptr value = nullptr;
+    };
+
+    std::array<Buffer, 3> buffers_;
+    alignas(64) std::atomic<uint8_t> middle_{1};
+    alignas(64) uint8_t back_ = 0;   // Owned by the producer
+    alignas(64) uint8_t front_ = 2;  // Owned by the consumer
 };
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+/**
+ * @brief A lock-free LIFO stack of indices in the range [0, capacity).
+ *
+ * This is a Treiber stack whose links are stored in a fixed array, which lets the head pack the
+ * top index together with a version tag into a single 64-bit word. Every successful update bumps
+ * the tag, so a pop that raced with a pop/push pair of the same index (the ABA problem) fails its
+ * compare-and-swap instead of corrupting the stack. Using indices instead of pointers keeps the
+ * head at 64 bits, which is lock-free on every supported platform.
+ *
+ * Each index may be on the stack at most once. The stack does not own any resources; it is used to
+ * hand out slots of a separately managed array.
+ */
+class LockFreeIndexStack {
+public:
+    /**
+     * @brief Constructs an empty stack for indices in the range [0, capacity).
+     */
+    explicit LockFreeIndexStack(size_t capacity)
+        : next_(std::make_unique<std::atomic<uint32_t>[]>(capacity)) {}
+
+    LockFreeIndexStack(const LockFreeIndexStack&) = delete;
+    LockFreeIndexStack& operator=(const LockFreeIndexStack&) = delete;
+
+    /**
+     * @brief Pushes an index onto the stack.
+     * @param index The index to push. It must not currently be on the stack.
+     */
+    void push(uint32_t index) {
+        uint64_t head = head_.load(std::memory_order_relaxed);
+        do {
+            next_[index].store(topOf(head), std::memory_order_relaxed);
+        } while (!head_.compare_exchange_weak(head,
+                                              pack(index + 1, tagOf(head) + 1),
+                                              std::memory_order_seq_cst,
+                                              std::memory_order_relaxed));
+    }
+
+    /**
+     * @brief Pops the most recently pushed index.
+     * @return The index, or std::nullopt if the stack is empty.
+     */
+    std::optional<uint32_t> pop() {
+        uint64_t head = head_.load(std::memory_order_seq_cst);
+        while (topOf(head) != kEmpty) {
+            const uint32_t index = topOf(head) - 1;
+            // May read a link that is being rewritten by a concurrent push; the tag check in the
+            // compare-and-swap rejects the result in that case.
+            const uint32_t next = next_[index].load(std::memory_order_relaxed);
+            if (head_.compare_exchange_weak(head,
+                                            pack(next, tagOf(head) + 1),
+                                            std::memory_order_seq_cst,
+                                            std::memory_order_seq_cst)) {
+                return index;
+            }
+        }
+        return std::nullopt;
+    }
+
+private:
+    // Indices are stored off by one, so that zero can mark the end of the stack.
+    static constexpr uint32_t kEmpty = 0;
+
+    static constexpr uint64_t pack(uint32_t top, uint32_t tag) {
+        return (static_cast<uint64_t>(tag) << 32) | top;
+    }
+    static constexpr uint32_t topOf(uint64_t head) { return static_cast<uint32_t>(head); }
+    static constexpr uint32_t tagOf(uint64_t head) { return static_cast<uint32_t>(head >> 32); }
+
+    std::atomic<uint64_t> head_{pack(kEmpty, 0)};
+    std::unique_ptr<std::atomic<uint32_t>[]> next_;  // Link to the next index, off by one
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * @brief A fixed-capacity cache that evicts the least recently used entry.
+ *
+ * Both lookups and insertions are O(1). The cache is NOT thread-safe.
+ */
+template <typename Key, typename Value>
+class LruCache {
+public:
+    /**
+     * @brief Constructs a cache holding at most @p capacity entries.
+     * A capacity of zero disables caching.
+     */
+    explicit LruCache(std::size_t capacity) : capacity_(capacity) {}
+
+    /**
+     * @brief Looks up an entry and marks it as most recently used.
+     * @param key The key to look up.
+     * @return A copy of the cached value, or std::nullopt on a cache miss.
+     */
+    std::optional<Value> get(const Key& key) {
+        auto it = lookup_.find(key);
+        if (it == lookup_.end()) return std::nullopt;
+        entries_.splice(entries_.begin(), entries_, it->second);
+        return it->second->second;
+    }
+
+    /**
+     * @brief Checks whether an entry is cached without marking it as used.
+     */
+    bool contains(const Key& key) const { return lookup_.contains(key); }
+
+    /**
+     * @brief Inserts or replaces an entry, evicting the least recently used one if needed.
+     */
+    void put(const Key& key, Value value) {
+        if (capacity_ == 0) return;
+
+        if (auto it = lookup_.find(key); it != lookup_.end()) {
+            it->second->second = std::move(value);
+            entries_.splice(entries_.begin(), entries_, it->second);
+            return;
+        }
+
+        if (entries_.size() >= capacity_) {
+            lookup_.erase(entries_.back().first);
+            entries_.pop_back();
+        }
+
+        entries_.emplace_front(key, std::move(value));
+        lookup_[key] = entries_.begin();
+    }
+
+    /**
+     * @brief Removes all entries.
+     */
+    void clear() {
+        entries_.clear();
+        lookup_.clear();
+    }
+
+    std::size_t size() const { return entries_.size(); }
+    std::size_t capacity() const { return capacity_; }
+
+private:
+    using Entry = std::pair<Key, Value>;
+
+    std::size_t capacity_;
+    std::list<Entry> entries_;  // Most recently used first
+    std::unordered_map<Key, typename std::list<Entry>::iterator> lookup_;
+};
@@ -1,10 +1,18 @@
 #pragma once
 
-#include <condition_variable>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <memory>
-#include <mutex>
-#include <queue>
+#include <optional>
 #include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include "core/dataflow/lock_free_index_stack.h"
 
 /**
  * @brief A concept to check if a type T has a reset() method.
@@ -17,10 +25,33 @@ concept Resettable = requires(T t) {
 };
 
 /**
- * @brief A thread-safe memory pool for managing buffers of type T.
+ * @brief Limits that control how far a MemoryPool may grow.
+ */
+struct MemoryPoolLimits {
+    // Upper bound on the number of buffers.
+    size_t max_buffers = 0;
+    // Upper bound on the bytes held by buffers, whether idle or in use.
+    size_t byte_budget = std::numeric_limits<size_t>::max();
+    // Approximate size of one buffer in bytes. sizeof(T) is used if zero.
+    size_t buffer_bytes = 0;
+    // Number of buffers that are always allowed, regardless of the byte budget.
+    size_t min_buffers = 1;
+    // How long the demand has to stay low before idle buffers are released.
+    std::chrono::nanoseconds release_interval = std::chrono::seconds(2);
+};
+
+/**
+ * @brief A thread-safe, lock-free, elastic memory pool for managing buffers of type T.
+ *
+ * Buffers are allocated lazily on acquire() until the pool reaches its capacity, which is derived
+ * from the buffer count limit and the byte budget. Once the capacity is reached, acquire() blocks
+ * until a buffer is returned, which applies backpressure in terms of memory rather than buffer
+ * count. Idle buffers beyond the recent high-watermark of buffers in use are released again, so
+ * the pool shrinks when the demand drops.
  *
- * This class allows preallocation of a specified number of buffers and provides a method to
- * acquire a buffer. When the buffer is no longer needed, it can be returned to the pool.
+ * Every buffer lives in a numbered slot. Idle buffers and empty slots are kept on two lock-free
+ * index stacks, so acquiring and returning a buffer never takes a lock. Only a blocked acquire()
+ * sleeps, and only then does a returning thread pay for a wake-up call.
  *
  * @tparam T The type of objects stored in the pool.
  * @tparam InitArgs The types of arguments used to initialize the T objects.
@@ -29,65 +60,220 @@ template <typename T, typename... InitArgs>
 class MemoryPool {
 public:
     /**
-     * @brief Constructs a MemoryPool with a specified size.
-     * @param pool_size The number of buffers to preallocate in the pool.
+     * @brief Constructs an empty MemoryPool.
+     * @param limits The limits that bound the growth of the pool.
      * @param args Arguments to initialize the T objects.
      */
-    explicit MemoryPool(size_t pool_size, InitArgs... args) {
-        if (pool_size == 0) throw std::invalid_argument("Pool size must be greater than zero.");
-
-        for (size_t i = 0; i < pool_size; ++i) buffers_.push(new T(args...));
+    explicit MemoryPool(MemoryPoolLimits limits, InitArgs... args)
+        : init_args_(std::move(args)...),
+          buffer_bytes_(limits.buffer_bytes > 0 ? limits.buffer_bytes : sizeof(T)),
+          capacity_(capacityFor(limits, buffer_bytes_)),
+          release_interval_ns_(limits.release_interval.count()),
+          slots_(capacity_, nullptr),
+          idle_slots_(capacity_),
+          empty_slots_(capacity_),
+          last_release_ns_(nowNs()) {
+        // Push in reverse, so that the lowest slots are used first.
+        for (size_t i = capacity_; i > 0; --i) empty_slots_.push(static_cast<uint32_t>(i - 1));
     }
 
     ~MemoryPool() {
-        while (!buffers_.empty()) {
-            delete buffers_.front();
-            buffers_.pop();
-        }
+        for (T* ptr : slots_) delete ptr;
     }
 
+    MemoryPool(const MemoryPool&) = delete;
+    MemoryPool& operator=(const MemoryPool&) = delete;
+
     /**
      * @brief Acquires a buffer from the pool.
      *
-     * If the pool is empty, this call will block until a buffer is returned
-     * by another thread.
+     * An idle buffer is reused if there is one. Otherwise a new buffer is allocated, unless the
+     * pool is at capacity, in which case this call blocks until a buffer is returned by another
+     * thread.
      *
      * @return A std::shared_ptr to a T object that will automatically return the buffer to the pool
      *         when it goes out of scope. If T is Resettable, it will call reset() on the object
      *         before returning it to the pool.
      */
     [[nodiscard]] std::shared_ptr<T> acquire() {
-        std::unique_lock lock(mtx_);
-        cv_.wait(lock, [&] { return !buffers_.empty(); });
+        if ((acquire_count_.fetch_add(1, std::memory_order_relaxed) & kReleaseCheckMask) == 0) {
+            releaseUnused();
+        }
 
-        T* ptr = buffers_.front();
-        buffers_.pop();
+        const uint32_t slot = takeSlot();
 
-        return {ptr, [this](T* p) {
+        const size_t in_use = in_use_.fetch_add(1, std::memory_order_relaxed) + 1;
+        raiseTo(window_peak_, in_use);
+        raiseTo(high_watermark_, in_use);
+
+        if (!slots_[slot]) {
+            try {
+                slots_[slot] =
+                    std::apply([](const auto&... args) { return new T(args...); }, init_args_);
+            } catch (...) {
+                in_use_.fetch_sub(1, std::memory_order_relaxed);
+                allocated_.fetch_sub(1, std::memory_order_relaxed);
+                empty_slots_.push(slot);
+                notifyWaiters();
+                throw;
+            }
+        }
+
+        return {slots_[slot], [this, slot](T* p) {
                     if constexpr (Resettable<T>) p->reset();  // Only if it has reset()
-                    returnBuffer(p);
+                    returnBuffer(slot);
                 }};
     }
 
     /**
-     * @brief Returns the number of currently available buffers in the pool.
-     * @return The number of available (not in-use) buffers.
+     * @brief Returns the number of buffers that can be acquired without blocking.
+     * @return The number of idle buffers plus the number of buffers that may still be allocated.
      */
     [[nodiscard]] size_t size() const {
-        std::scoped_lock lock(mtx_);
-        return buffers_.size();
+        const size_t in_use = in_use_.load(std::memory_order_relaxed);
+        return in_use < capacity_ ? capacity_ - in_use : 0;
+    }
+
+    /**
+     * @brief Returns the maximum number of buffers the pool may hold at once.
+     */
+    [[nodiscard]] size_t capacity() const { return capacity_; }
+
+    /**
+     * @brief Returns the largest number of buffers that were in use at the same time.
+     */
+    [[nodiscard]] size_t highWatermark() const {
+        return high_watermark_.load(std::memory_order_relaxed);
     }
 
+    /**
+     * @brief Returns the approximate number of bytes currently allocated by the pool.
+     */
+    [[nodiscard]] size_t allocatedBytes() const {
+        return allocated_.load(std::memory_order_relaxed) * buffer_bytes_;
+    }
+
+    /**
+     * @brief Returns the approximate number of bytes the pool may allocate at most.
+     */
+    [[nodiscard]] size_t capacityBytes() const { return capacity_ * buffer_bytes_; }
+
 private:
-    void returnBuffer(T* ptr) {
-        {
-            std::scoped_lock lock(mtx_);
-            buffers_.push(ptr);
+    using Clock = std::chrono::steady_clock;
+
+    // Reading the clock is not free, so the release interval is only checked every 64 acquires.
+    static constexpr size_t kReleaseCheckMask = 63;
+
+    static size_t capacityFor(const MemoryPoolLimits& limits, size_t buffer_bytes) {
+        if (limits.max_buffers == 0) {
+            throw std::invalid_argument("Pool size must be greater than zero.");
+        }
+
+        const size_t budget_buffers = limits.byte_budget / buffer_bytes;
+        const size_t min_buffers = std::min(limits.min_buffers, limits.max_buffers);
+        return std::clamp(budget_buffers, min_buffers, limits.max_buffers);
+    }
+
+    static int64_t nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   Clock::now().time_since_epoch())
+            .count();
+    }
+
+    static void raiseTo(std::atomic<size_t>& peak, size_t value) {
+        size_t current = peak.load(std::memory_order_relaxed);
+        while (current < value &&
+               !peak.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    /**
+     * @brief Takes a slot with an idle buffer, or an empty slot if there is none.
+     * Blocks while neither is available.
+     */
+    uint32_t takeSlot() {
+        if (auto slot = tryTakeSlot()) return *slot;
+
+        while (true) {
+            // Announce the wait before checking the stacks again. A thread that pushes a slot
+            // after that check sees the announcement and bumps the generation, so the wait does
+            // not sleep.
+            has_waiters_.store(true, std::memory_order_seq_cst);
+            const uint32_t seen = wake_generation_.load(std::memory_order_seq_cst);
+            if (auto slot = tryTakeSlot()) return *slot;
+            wake_generation_.wait(seen, std::memory_order_seq_cst);
+        }
+    }
+
+    std::optional<uint32_t> tryTakeSlot() {
+        if (auto slot = idle_slots_.pop()) return slot;
+        if (auto slot = empty_slots_.pop()) {
+            allocated_.fetch_add(1, std::memory_order_relaxed);
+            return slot;
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Frees idle buffers that exceed the peak demand of the last release interval.
+     * Only one thread performs the release per interval.
+     */
+    void releaseUnused() {
+        const int64_t now = nowNs();
+        int64_t last = last_release_ns_.load(std::memory_order_relaxed);
+        if (now - last < release_interval_ns_) return;
+        if (!last_release_ns_.compare_exchange_strong(last, now, std::memory_order_relaxed)) return;
+
+        const size_t allocated = allocated_.load(std::memory_order_relaxed);
+        const size_t peak = window_peak_.exchange(in_use_.load(std::memory_order_relaxed),
+                                                  std::memory_order_relaxed);
+        for (size_t excess = allocated > peak ? allocated - peak : 0; excess > 0; --excess) {
+            auto slot = idle_slots_.pop();
+            if (!slot) break;
+
+            delete slots_[*slot];
+            slots_[*slot] = nullptr;
+            allocated_.fetch_sub(1, std::memory_order_relaxed);
+            empty_slots_.push(*slot);
+            notifyWaiters();
         }
-        cv_.notify_one();
     }
 
-    mutable std::mutex mtx_;
-    std::condition_variable cv_;
-    std::queue<T*> buffers_;
+    void returnBuffer(uint32_t slot) {
+        in_use_.fetch_sub(1, std::memory_order_relaxed);
+        idle_slots_.push(slot);
+        notifyWaiters();
+    }
+
+    /**
+     * @brief Wakes threads blocked in acquire() after a slot was pushed. Without waiters this is
+     * a single load. The flag is cleared by the first notifier, so a burst of returns costs a
+     * single wake-up call; woken threads announce themselves again if they have to keep waiting.
+     */
+    void notifyWaiters() {
+        if (!has_waiters_.load(std::memory_order_seq_cst)) return;
+        if (!has_waiters_.exchange(false, std::memory_order_seq_cst)) return;
+        wake_generation_.fetch_add(1, std::memory_order_seq_cst);
+        wake_generation_.notify_all();
+    }
+
+    const std::tuple<InitArgs...> init_args_;
+    const size_t buffer_bytes_;
+    const size_t capacity_;
+    const int64_t release_interval_ns_;
+
+    // A slot's pointer is only touched by the thread that popped the slot from a stack.
+    std::vector<T*> slots_;
+    LockFreeIndexStack idle_slots_;   // Slots holding a buffer that is not in use
+    LockFreeIndexStack empty_slots_;  // Slots without a buffer
+
+    std::atomic<size_t> allocated_ = 0;       // Buffers that exist, idle or in use
+    std::atomic<size_t> in_use_ = 0;          // Buffers that are currently handed out
+    std::atomic<size_t> window_peak_ = 0;     // Peak of in_use_ since the last release
+    std::atomic<size_t> high_watermark_ = 0;  // Peak of in_use_ over the lifetime of the pool
+    std::atomic<size_t> acquire_count_ = 0;
+    std::atomic<int64_t> last_release_ns_;
+
+    std::atomic<bool> has_waiters_ = false;      // Set while a thread is blocked in acquire()
+    std::atomic<uint32_t> wake_generation_ = 0;  // Bumped to wake threads blocked in acquire()
 };
@@ -0,0 +1,236 @@
+#pragma once
+
+#include <enkas/logging/logger.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+#include "core/dataflow/snapshot.h"
+#include "core/dataflow/spsc_queue.h"
+#include "core/files/snapshot_spill_file.h"
+
+/**
+ * @brief What an output channel does with a new snapshot while its consumer is behind.
+ */
+enum class BackpressurePolicy {
+    Block,       // Wait until the consumer makes room; lossless, but stalls the producer
+    DropOldest,  // Discard the oldest queued snapshot to make room for the new one
+    Decimate,    // Keep every k-th snapshot while the queue is half full; those may still wait
+    Spill,       // Write the snapshots that do not fit to a file on disk; lossless
+};
+
+/**
+ * @brief Configuration of an OutputChannel.
+ */
+struct OutputChannelConfig {
+    size_t capacity = 512;
+    BackpressurePolicy policy = BackpressurePolicy::Block;
+    size_t decimation_factor = 4;      // Used by BackpressurePolicy::Decimate
+    std::filesystem::path spill_path;  // Used by BackpressurePolicy::Spill
+};
+
+/**
+ * @brief A single-producer, single-consumer channel of snapshots with a backpressure policy.
+ *
+ * The channel wraps an SpscQueue and decides on every push what happens when the queue is full,
+ * so that each output of the simulation can trade completeness against stalling the simulation
+ * thread. Counters for offered, dropped and spilled snapshots can be read from any thread.
+ *
+ * With BackpressurePolicy::Spill, snapshots keep their order: once a snapshot has been spilled,
+ * newer ones are spilled as well until the consumer has read the spill file back. Spilling starts
+ * when the queue is full, or earlier if a spill threshold is set, e.g. because every queued
+ * snapshot pins a buffer of a memory pool that is smaller than the queue. The spill file
+ * is only touched under a lock, which the consumer takes only after it found the queue empty.
+ *
+ * @tparam T The snapshot data type, e.g. enkas::data::System.
+ */
+template <typename T>
+class OutputChannel {
+public:
+    using SnapshotPtr = std::shared_ptr<const Snapshot<T>>;
+
+    explicit OutputChannel(OutputChannelConfig config)
+        : queue_(config.capacity),
+          spill_threshold_(queue_.capacity()),
+          policy_(config.policy),
+          decimation_factor_(std::max<size_t>(config.decimation_factor, 1)) {
+        if (policy_ == BackpressurePolicy::Spill) {
+            spill_file_ = std::make_unique<SnapshotSpillFile<T>>(config.spill_path);
+            if (!spill_file_->isOpen()) {
+                ENKAS_LOG_WARNING("Spilling is unavailable, the output will block instead.");
+                spill_file_.reset();
+                policy_ = BackpressurePolicy::Block;
+            }
+        }
+    }
+
+    OutputChannel(const OutputChannel&) = delete;
+    OutputChannel& operator=(const OutputChannel&) = delete;
+
+    /**
+     * @brief Hands a snapshot to the consumer according to the backpressure policy.
+     * Must only be called from the producer thread. Snapshots pushed after close() are discarded.
+     */
+    void push(SnapshotPtr snapshot) {
+        offered_.fetch_add(1, std::memory_order_relaxed);
+
+        switch (policy_) {
+            case BackpressurePolicy::Block:
+                queue_.pushBlocking(std::move(snapshot));
+                break;
+
+            case BackpressurePolicy::DropOldest:
+                if (queue_.isFull() && queue_.dropOldest()) {
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                }
+                // Only waits if the consumer is in the middle of taking every queued snapshot.
+                queue_.pushBlocking(std::move(snapshot));
+                break;
+
+            case BackpressurePolicy::Decimate:
+                if (queue_.size() * 2 < queue_.capacity()) {
+                    decimation_phase_ = 0;
+                } else if (decimation_phase_++ % decimation_factor_ != 0) {
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                    break;
+                }
+                queue_.pushBlocking(std::move(snapshot));
+                break;
+
+            case BackpressurePolicy::Spill:
+                pushOrSpill(std::move(snapshot));
+                break;
+        }
+    }
+
+    /**
+     * @brief Makes BackpressurePolicy::Spill spill once @p count snapshots are queued in memory,
+     * instead of only when the queue is full.
+     * Must only be called from the producer thread.
+     */
+    void setSpillThreshold(size_t count) {
+        spill_threshold_ = std::clamp<size_t>(count, 1, queue_.capacity());
+    }
+
+    /**
+     * @brief Pops the oldest snapshot, blocking until one is available.
+     * Must only be called from the consumer thread.
+     * @return The snapshot, or nullptr once the channel is closed and drained.
+     */
+    [[nodiscard]] SnapshotPtr popBlocking() {
+        if (auto snapshot = tryPop()) return std::move(*snapshot);
+
+        // Nothing is spilled at this point, and the producer only spills while the queue is full,
+        // so the queue is the only place where the next snapshot can show up.
+        SnapshotPtr snapshot = queue_.popBlocking();
+        if (snapshot || !spill_file_) return snapshot;
+
+        // Closed: drain whatever was spilled before the queue ran empty.
+        if (auto spilled = tryPop()) return std::move(*spilled);
+        return nullptr;
+    }
+
+    /**
+     * @brief Pops the oldest snapshot if one is available, without blocking.
+     * Must only be called from the consumer thread.
+     */
+    [[nodiscard]] std::optional<SnapshotPtr> tryPop() {
+        if (auto snapshot = queue_.tryPop()) return snapshot;
+        if (!spill_file_) return std::nullopt;
+
+        while (true) {
+            {
+                std::scoped_lock lock(spill_mutex_);
+                // Queued snapshots are always older than spilled ones.
+                if (auto snapshot = queue_.tryPop()) return snapshot;
+                if (spill_file_->pending() == 0) return std::nullopt;
+            }
+
+            // Reading a counted record does not race with the producer appending new ones.
+            SnapshotPtr snapshot = spill_file_->read();
+            {
+                std::scoped_lock lock(spill_mutex_);
+                spill_file_->markRead();
+                spill_pending_.store(spill_file_->pending(), std::memory_order_relaxed);
+            }
+            if (snapshot) return snapshot;
+            dropped_.fetch_add(1, std::memory_order_relaxed);  // Unreadable record
+        }
+    }
+
+    /**
+     * @brief Closes the channel. Snapshots that were already pushed can still be popped.
+     */
+    void close() { queue_.close(); }
+
+    /**
+     * @brief Returns the number of snapshots waiting in the queue and in the spill file.
+     */
+    [[nodiscard]] size_t size() const {
+        return queue_.size() + spill_pending_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Returns the capacity of the in-memory queue.
+     */
+    [[nodiscard]] size_t capacity() const { return queue_.capacity(); }
+
+    [[nodiscard]] BackpressurePolicy policy() const { return policy_; }
+
+    /**
+     * @brief Returns the number of snapshots pushed so far.
+     */
+    [[nodiscard]] size_t offered() const { return offered_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Returns the number of snapshots discarded by DropOldest or Decimate.
+     */
+    [[nodiscard]] size_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Returns the number of snapshots written to the spill file so far.
+     */
+    [[nodiscard]] size_t spilled() const { return spilled_.load(std::memory_order_relaxed); }
+
+private:
+    void pushOrSpill(SnapshotPtr snapshot) {
+        std::scoped_lock lock(spill_mutex_);
+        if (queue_.isClosed()) return;
+
+        // The push cannot block: only the producer fills the queue, and it holds the lock.
+        if (spill_file_->pending() == 0 && queue_.size() < spill_threshold_) {
+            queue_.pushBlocking(std::move(snapshot));
+            return;
+        }
+
+        if (spill_file_->write(*snapshot)) {
+            spilled_.fetch_add(1, std::memory_order_relaxed);
+            spill_pending_.store(spill_file_->pending(), std::memory_order_relaxed);
+        } else {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    SpscQueue<SnapshotPtr> queue_;
+    size_t spill_threshold_;  // Owned by the producer
+    BackpressurePolicy policy_;
+    const size_t decimation_factor_;
+    size_t decimation_phase_ = 0;  // Owned by the producer
+
+    std::unique_ptr<SnapshotSpillFile<T>> spill_file_;
+    std::mutex spill_mutex_;
+    std::atomic<size_t> spill_pending_ = 0;  // Mirrors the spill file for size()
+
+    std::atomic<size_t> offered_ = 0;
+    std::atomic<size_t> dropped_ = 0;
+    std::atomic<size_t> spilled_ = 0;
+};
+
+using SystemOutputChannel = OutputChannel<enkas::data::System>;
+using DiagnosticsOutputChannel = OutputChannel<enkas::data::Diagnostics>;
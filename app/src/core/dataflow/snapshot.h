@@ -3,8 +3,11 @@
 #include <enkas/data/diagnostics.h>
 #include <enkas/data/system.h>
 
+#include <charconv>
+#include <cstddef>
+#include <limits>
 #include <memory>
-#include <ostream>
+#include <vector>
 
 template <typename T>
 struct Snapshot {
@@ -29,24 +32,73 @@ using DiagnosticsSeries = std::vector<Snapshot<enkas::data::Diagnostics>>;
 using SystemSnapshotPtr = std::shared_ptr<const Snapshot<enkas::data::System>>;
 using DiagnosticsSnapshotPtr = std::shared_ptr<const Snapshot<enkas::data::Diagnostics>>;
 
-// Writer for SystemDataSnapshot
-inline std::ostream& operator<<(std::ostream& os, const SystemSnapshot& snapshot) {
-    const auto& system = snapshot.data;
-    for (size_t i = 0; i < system->count(); ++i) {
-        os << snapshot.time << ',' << system->positions[i].x << ',' << system->positions[i].y << ','
-           << system->positions[i].z << ',' << system->velocities[i].x << ','
-           << system->velocities[i].y << ',' << system->velocities[i].z << ',' << system->masses[i]
-           << '\n';
-    }
-    return os;
+// --- CSV formatting ---
+// Values are written like an std::ostream with precision max_digits10 would write them (printf
+// "%.17g"), so files stay byte-identical while avoiding the per-field stream overhead.
+
+/**
+ * @brief Upper bound for the number of characters of a single formatted CSV row.
+ */
+inline constexpr size_t kMaxCsvRowLength = 512;
+
+/**
+ * @brief Formats a value followed by a separator into @p out.
+ * @return A pointer past the last written character.
+ */
+inline char* formatCsvField(char* out, double value, char separator) {
+    constexpr int kPrecision = std::numeric_limits<double>::max_digits10;
+    constexpr size_t kMaxFieldLength = 32;  // "-1.2345678901234567e-308" fits comfortably
+    out = std::to_chars(out, out + kMaxFieldLength, value, std::chars_format::general, kPrecision)
+              .ptr;
+    *out++ = separator;
+    return out;
+}
+
+/**
+ * @brief Returns the number of CSV rows of a system snapshot, one per particle.
+ */
+inline size_t csvRowCount(const SystemSnapshot& snapshot) { return snapshot.data->count(); }
+
+/**
+ * @brief Formats the CSV row of particle @p row into @p out, which must have room for
+ * kMaxCsvRowLength characters.
+ * @return A pointer past the last written character.
+ */
+inline char* formatCsvRow(char* out, const SystemSnapshot& snapshot, size_t row) {
+    const auto& system = *snapshot.data;
+    out = formatCsvField(out, snapshot.time, ',');
+    out = formatCsvField(out, system.positions[row].x, ',');
+    out = formatCsvField(out, system.positions[row].y, ',');
+    out = formatCsvField(out, system.positions[row].z, ',');
+    out = formatCsvField(out, system.velocities[row].x, ',');
+    out = formatCsvField(out, system.velocities[row].y, ',');
+    out = formatCsvField(out, system.velocities[row].z, ',');
+    return formatCsvField(out, system.masses[row], '\n');
 }
 
-// Writer for DiagnosticsDataSnapshot
-inline std::ostream& operator<<(std::ostream& os, const DiagnosticsSnapshot& snapshot) {
-    const auto& diag = snapshot.data;
-    os << snapshot.time << ',' << diag->e_kin << ',' << diag->e_pot << ',' << diag->L_tot << ','
-       << diag->com_pos.x << ',' << diag->com_pos.y << ',' << diag->com_pos.z << ','
-       << diag->com_vel.x << ',' << diag->com_vel.y << ',' << diag->com_vel.z << ',' << diag->r_vir
-       << ',' << diag->ms_vel << ',' << diag->t_cr << '\n';
-    return os;
-}
\ No newline at end of file
+/**
+ * @brief Returns the number of CSV rows of a diagnostics snapshot, which is always one.
+ */
+inline size_t csvRowCount(const DiagnosticsSnapshot&) { return 1; }
+
+/**
+ * @brief Formats the CSV row of a diagnostics snapshot into @p out, which must have room for
+ * kMaxCsvRowLength characters.
+ * @return A pointer past the last written character.
+ */
+inline char* formatCsvRow(char* out, const DiagnosticsSnapshot& snapshot, size_t /*row*/) {
+    const auto& diag = *snapshot.data;
+    out = formatCsvField(out, snapshot.time, ',');
+    out = formatCsvField(out, diag.e_kin, ',');
+    out = formatCsvField(out, diag.e_pot, ',');
+    out = formatCsvField(out, diag.L_tot, ',');
+    out = formatCsvField(out, diag.com_pos.x, ',');
+    out = formatCsvField(out, diag.com_pos.y, ',');
+    out = formatCsvField(out, diag.com_pos.z, ',');
+    out = formatCsvField(out, diag.com_vel.x, ',');
+    out = formatCsvField(out, diag.com_vel.y, ',');
+    out = formatCsvField(out, diag.com_vel.z, ',');
+    out = formatCsvField(out, diag.r_vir, ',');
+    out = formatCsvField(out, diag.ms_vel, ',');
+    return formatCsvField(out, diag.t_cr, '\n');
+}
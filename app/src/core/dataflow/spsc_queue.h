@@ -0,0 +1,269 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief A bounded, lock-free queue for exactly one producer thread and one consumer thread.
+ *
+ * Items are stored in a power-of-two ring. The producer and consumer indices live on separate
+ * cache lines, and each side keeps a private copy of the other side's index, so the shared lines
+ * are only touched when the cached view runs out. A blocked side spins briefly and then sleeps
+ * with std::atomic::wait, which maps to a futex (or the platform equivalent).
+ *
+ * close() may be called from any thread. It wakes both sides, makes further pushes fail and lets
+ * the consumer drain what is left before popBlocking() starts returning a default value.
+ *
+ * The producer may also drop the oldest item with dropOldest(), e.g. to make room for a new item
+ * instead of waiting for a slow consumer. To make that safe, both sides claim the item at the head
+ * with a compare-and-swap before taking it, and hand the slot back to the producer in claim order.
+ */
+template <typename T>
+class SpscQueue {
+public:
+    /**
+     * @brief Constructs a queue with room for at least @p capacity items.
+     * The capacity is rounded up to the next power of two.
+     */
+    explicit SpscQueue(size_t capacity)
+        : capacity_(std::bit_ceil(std::max<size_t>(capacity, 1))),
+          mask_(capacity_ - 1),
+          slots_(capacity_) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /**
+     * @brief Pushes an item into the queue, blocking until space is available.
+     * Must only be called from the producer thread.
+     * @param item The item to be pushed into the queue.
+     * @return False if the queue was closed, in which case the item is discarded.
+     */
+    bool pushBlocking(T item) {
+        for (int spins = 0;; ++spins) {
+            const uint64_t tail = producer_.index.load(std::memory_order_relaxed);
+            if (tail & kClosedBit) return false;
+
+            if (tail - producer_.cached_other < capacity_) {
+                slots_[tail & mask_] = std::move(item);
+                producer_.index.fetch_add(1, std::memory_order_seq_cst);
+                if (consumer_.is_waiting.exchange(false, std::memory_order_seq_cst)) {
+                    producer_.index.notify_one();
+                }
+                return true;
+            }
+
+            const uint64_t head = consumer_.index.load(std::memory_order_acquire);
+            producer_.cached_other = head & kIndexMask;
+            if (tail - producer_.cached_other < capacity_) continue;
+
+            if (spins < spinLimit()) {
+                cpuRelax();
+            } else {
+                waitForChange(producer_, consumer_.index, head);
+            }
+        }
+    }
+
+    /**
+     * @brief Pops an item from the queue, blocking until an item is available.
+     * Must only be called from the consumer thread.
+     * @return The item popped from the queue, or a default-constructed T once the queue is closed
+     * and empty.
+     */
+    [[nodiscard]] T popBlocking() {
+        for (int spins = 0;; ++spins) {
+            const uint64_t head = consumer_.claimed.load(std::memory_order_acquire);
+
+            // The producer may have dropped items past the cached tail, hence the comparison.
+            if (head < consumer_.cached_other) {
+                if (auto item = claimAt(head)) return std::move(*item);
+                continue;
+            }
+
+            const uint64_t tail = producer_.index.load(std::memory_order_acquire);
+            consumer_.cached_other = tail & kIndexMask;
+            if (head < consumer_.cached_other) continue;
+            if (tail & kClosedBit) return T{};
+
+            if (spins < spinLimit()) {
+                cpuRelax();
+            } else {
+                waitForChange(consumer_, producer_.index, tail);
+            }
+        }
+    }
+
+    /**
+     * @brief Pops an item if one is available, without blocking.
+     * Must only be called from the consumer thread.
+     * @return The item popped from the queue, or std::nullopt if the queue is empty.
+     */
+    [[nodiscard]] std::optional<T> tryPop() {
+        while (true) {
+            const uint64_t head = consumer_.claimed.load(std::memory_order_acquire);
+            if (head >= consumer_.cached_other) {
+                consumer_.cached_other =
+                    producer_.index.load(std::memory_order_acquire) & kIndexMask;
+                if (head >= consumer_.cached_other) return std::nullopt;
+            }
+            if (auto item = claimAt(head)) return item;
+        }
+    }
+
+    /**
+     * @brief Removes and destroys the oldest item in the queue, if there is one.
+     * Must only be called from the producer thread.
+     * @return False if the queue was empty, or if the consumer had already claimed every item.
+     */
+    bool dropOldest() {
+        const uint64_t tail = producer_.index.load(std::memory_order_relaxed) & kIndexMask;
+        while (true) {
+            const uint64_t head = consumer_.claimed.load(std::memory_order_acquire);
+            if (head == tail) return false;
+            if (claimAt(head)) return true;
+        }
+    }
+
+    /**
+     * @brief Closes the queue and wakes up both sides.
+     * Subsequent pushes fail; items already queued can still be popped.
+     */
+    void close() {
+        producer_.index.fetch_or(kClosedBit, std::memory_order_seq_cst);
+        consumer_.index.fetch_or(kClosedBit, std::memory_order_seq_cst);
+        producer_.index.notify_all();
+        consumer_.index.notify_all();
+    }
+
+    /**
+     * @brief Returns whether close() has been called.
+     */
+    [[nodiscard]] bool isClosed() const {
+        return (producer_.index.load(std::memory_order_acquire) & kClosedBit) != 0;
+    }
+
+    /**
+     * @brief Returns the number of items currently in the queue.
+     * @note The value is a snapshot and may be outdated by the time it is used.
+     */
+    [[nodiscard]] size_t size() const {
+        // Read the head first so that the tail can never be behind it.
+        const uint64_t head = consumer_.index.load(std::memory_order_acquire) & kIndexMask;
+        const uint64_t tail = producer_.index.load(std::memory_order_acquire) & kIndexMask;
+        return static_cast<size_t>(tail - head);
+    }
+
+    /**
+     * @brief Returns the maximum number of items the queue can hold.
+     */
+    [[nodiscard]] size_t capacity() const { return capacity_; }
+
+    /**
+     * @brief Returns whether a push would have to wait for space.
+     * Must only be called from the producer thread, for which the answer cannot become outdated
+     * in the blocking direction: only the producer fills the queue.
+     */
+    [[nodiscard]] bool isFull() const { return size() >= capacity_; }
+
+private:
+    // Separate lines keep the producer and consumer from invalidating each other's cache.
+    static constexpr size_t kCacheLineSize = 64;
+    static constexpr uint64_t kClosedBit = uint64_t{1} << 63;
+    static constexpr uint64_t kIndexMask = ~kClosedBit;
+    static constexpr int kSpinIterations = 256;
+
+    /**
+     * @brief The state owned by one side of the queue.
+     * The waiting flag is read on every operation of the other side but rarely written, so it
+     * gets its own line instead of sharing one with the busy index.
+     */
+    struct Side {
+        alignas(kCacheLineSize) std::atomic<uint64_t> index{0};  // Items this side has handled
+        uint64_t cached_other = 0;  // Last seen index of the other side
+        // Consumer side only: items claimed for taking, which may run ahead of the index.
+        std::atomic<uint64_t> claimed{0};
+        alignas(kCacheLineSize) std::atomic<bool> is_waiting{false};  // Set while sleeping
+    };
+
+    /**
+     * @brief Claims the item at @p head and moves it out of the ring.
+     * @return The item, or std::nullopt if the other side claimed it first.
+     */
+    std::optional<T> claimAt(uint64_t head) {
+        uint64_t expected = head;
+        if (!consumer_.claimed.compare_exchange_strong(
+                expected, head + 1, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            return std::nullopt;
+        }
+
+        std::optional<T> item(std::move(slots_[head & mask_]));
+        slots_[head & mask_] = T{};  // Release whatever the moved-from slot still holds
+
+        // Slots are handed back in claim order. The wait only lasts while the other side is
+        // in the middle of taking the previous item, which is a handful of instructions.
+        for (int spins = 0;
+             (consumer_.index.load(std::memory_order_acquire) & kIndexMask) != head;
+             ++spins) {
+            if (spins < spinLimit()) {
+                cpuRelax();
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        consumer_.index.fetch_add(1, std::memory_order_seq_cst);
+        if (producer_.is_waiting.exchange(false, std::memory_order_seq_cst)) {
+            consumer_.index.notify_one();
+        }
+        return item;
+    }
+
+    /**
+     * @brief Sleeps until @p other differs from @p seen.
+     * The waiting flag is published before the value is rechecked, so the other side either sees
+     * the flag and notifies, or this side sees the new value and does not sleep. The notifying
+     * side clears the flag, so a sleeper costs at most one wake-up call.
+     */
+    static void waitForChange(Side& self, const std::atomic<uint64_t>& other, uint64_t seen) {
+        self.is_waiting.store(true, std::memory_order_seq_cst);
+        if (other.load(std::memory_order_seq_cst) == seen) {
+            other.wait(seen, std::memory_order_acquire);
+        }
+        self.is_waiting.store(false, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Returns how often a blocked side spins before it sleeps. Spinning only pays off when
+     * the other side can make progress on another core at the same time.
+     */
+    static int spinLimit() {
+        static const int limit = std::thread::hardware_concurrency() > 1 ? kSpinIterations : 0;
+        return limit;
+    }
+
+    static void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+        _mm_pause();
+#else
+        std::this_thread::yield();
+#endif
+    }
+
+    const size_t capacity_;
+    const size_t mask_;
+    std::vector<T> slots_;
+
+    Side producer_;
+    Side consumer_;
+};
@@ -10,7 +10,7 @@ SystemRingBuffer::SystemRingBuffer(size_t capacity, size_t retain_count)
 bool SystemRingBuffer::pushHead(SystemSnapshotPtr snapshot) {
     std::unique_lock lock(mtx_);
 
-    if (isFull() || is_shutting_down_) {
+    if (isFullLocked() || is_shutting_down_) {
         return false;
     }
 
@@ -24,9 +24,9 @@ bool SystemRingBuffer::pushTail(SystemSnapshotPtr snapshot) {
     std::unique_lock lock(mtx_);
 
     // If the buffer is full, we must also retreat the head pointer
-    if (isFull()) {
+    if (isFullLocked()) {
         // If the reader has caught up, we cannot push back the head, so we cannot push to the tail.
-        if (hasReaderCaughtUp()) return false;
+        if (hasReaderCaughtUpLocked()) return false;
         head_ = retreat(head_);
     }
 
@@ -45,7 +45,7 @@ bool SystemRingBuffer::pushTail(SystemSnapshotPtr snapshot) {
 
 std::optional<double> SystemRingBuffer::headTime() const {
     std::unique_lock lock(mtx_);
-    if (isEmpty()) return std::nullopt;
+    if (isEmptyLocked()) return std::nullopt;
     const auto& snapshot = buffer_[retreat(head_)];
     if (!snapshot) return std::nullopt;
     return snapshot->time;
@@ -53,7 +53,7 @@ std::optional<double> SystemRingBuffer::headTime() const {
 
 std::optional<double> SystemRingBuffer::tailTime() const {
     std::unique_lock lock(mtx_);
-    if (isEmpty()) return std::nullopt;
+    if (isEmptyLocked()) return std::nullopt;
     const auto& snapshot = buffer_[tail_];
     if (!snapshot) return std::nullopt;
     return snapshot->time;
@@ -61,7 +61,7 @@ std::optional<double> SystemRingBuffer::tailTime() const {
 
 std::optional<SystemSnapshotPtr> SystemRingBuffer::readForward() {
     std::unique_lock lock(mtx_);
-    if (hasReaderCaughtUp()) return std::nullopt;
+    if (hasReaderCaughtUpLocked()) return std::nullopt;
 
     auto result = buffer_[read_];
     read_ = advance(read_);
@@ -71,35 +71,105 @@ std::optional<SystemSnapshotPtr> SystemRingBuffer::readForward() {
         tail_ = advance(tail_);
     }
 
+    signalChangeLocked();
     return result;
 }
 
+std::optional<SystemSnapshotPtr> SystemRingBuffer::peekForward() const {
+    std::unique_lock lock(mtx_);
+    if (hasReaderCaughtUpLocked()) return std::nullopt;
+    return buffer_[read_];
+}
+
 std::optional<SystemSnapshotPtr> SystemRingBuffer::readBackward() {
     std::unique_lock lock(mtx_);
     if (distance(tail_, read_) < 1) return std::nullopt;  // Can't go before tail
 
     read_ = retreat(read_);
+    signalChangeLocked();
     return buffer_[read_];
 }
 
+bool SystemRingBuffer::seekTo(double time) {
+    std::unique_lock lock(mtx_);
+    for (size_t idx = tail_; idx != head_; idx = advance(idx)) {
+        if (buffer_[idx] && buffer_[idx]->time == time) {
+            read_ = idx;
+            while (distance(tail_, read_) > retain_count_) {
+                tail_ = advance(tail_);
+            }
+            signalChangeLocked();
+            return true;
+        }
+    }
+    return false;
+}
+
 void SystemRingBuffer::clear() {
     std::unique_lock lock(mtx_);
     tail_ = read_ = head_ = 0;
     buffer_.assign(buffer_.size(), nullptr);
+    signalChangeLocked();
 }
 
 void SystemRingBuffer::shutdown() {
     std::unique_lock lock(mtx_);
     is_shutting_down_ = true;
+    signalChangeLocked();
 }
 
-bool SystemRingBuffer::isFull() const { return advance(head_) == tail_; }
+bool SystemRingBuffer::isFull() const {
+    std::unique_lock lock(mtx_);
+    return isFullLocked();
+}
+
+bool SystemRingBuffer::isEmpty() const {
+    std::unique_lock lock(mtx_);
+    return isEmptyLocked();
+}
 
-bool SystemRingBuffer::isEmpty() const { return tail_ == head_; }
+bool SystemRingBuffer::hasReaderCaughtUp() const {
+    std::unique_lock lock(mtx_);
+    return hasReaderCaughtUpLocked();
+}
 
-bool SystemRingBuffer::hasReaderCaughtUp() const { return read_ == head_; }
+size_t SystemRingBuffer::size() const {
+    std::unique_lock lock(mtx_);
+    return distance(tail_, head_);
+}
 
-size_t SystemRingBuffer::size() const { return distance(tail_, head_); }
+size_t SystemRingBuffer::aheadCount() const {
+    std::unique_lock lock(mtx_);
+    return distance(read_, head_);
+}
+
+std::uint64_t SystemRingBuffer::changeCount() const {
+    std::unique_lock lock(mtx_);
+    return change_count_;
+}
+
+void SystemRingBuffer::notifyWriter() {
+    std::unique_lock lock(mtx_);
+    signalChangeLocked();
+}
+
+bool SystemRingBuffer::waitForChange(std::uint64_t seen_change_count) {
+    std::unique_lock lock(mtx_);
+    cond_change_.wait(
+        lock, [&]() { return is_shutting_down_ || change_count_ != seen_change_count; });
+    return !is_shutting_down_;
+}
+
+bool SystemRingBuffer::isFullLocked() const { return advance(head_) == tail_; }
+
+bool SystemRingBuffer::isEmptyLocked() const { return tail_ == head_; }
+
+bool SystemRingBuffer::hasReaderCaughtUpLocked() const { return read_ == head_; }
+
+void SystemRingBuffer::signalChangeLocked() {
+    ++change_count_;
+    cond_change_.notify_all();
+}
 
 size_t SystemRingBuffer::advance(size_t idx) const { return (idx + 1) % buffer_.size(); }
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <condition_variable>
+#include <cstdint>
 #include <mutex>
 #include <optional>
 #include <vector>
@@ -8,6 +10,9 @@
 
 /**
  * @brief A thread-safe ring buffer for storing and managing system snapshots.
+ *
+ * Reader-side events (reads, seeks, clears) and explicit writer notifications bump a change
+ * counter, which lets the writer sleep in waitForChange() instead of polling the buffer.
  */
 class SystemRingBuffer {
 public:
@@ -47,12 +52,27 @@ public:
      */
     std::optional<SystemSnapshotPtr> readForward();
 
+    /**
+     * @brief Returns the snapshot that the next readForward() would return, without moving the
+     * read pointer.
+     * @return The next snapshot, or std::nullopt if there are no more snapshots.
+     */
+    std::optional<SystemSnapshotPtr> peekForward() const;
+
     /**
      * @brief Reads the previous snapshot in the buffer, moving the read pointer backward.
      * @return The previous snapshot, or std::nullopt if there are no more snapshots.
      */
     std::optional<SystemSnapshotPtr> readBackward();
 
+    /**
+     * @brief Moves the read pointer to a buffered snapshot, so that the next readForward()
+     * returns it. Snapshots further than the retain count behind it are dropped.
+     * @param time The timestamp of the snapshot to seek to.
+     * @return true if a snapshot with this timestamp is buffered, false otherwise.
+     */
+    bool seekTo(double time);
+
     /**
      * @brief Clears the buffer, removing all snapshots.
      */
@@ -87,7 +107,41 @@ public:
      */
     size_t size() const;
 
+    /**
+     * @brief Gets the number of snapshots between the read position and the head of the buffer.
+     */
+    size_t aheadCount() const;
+
+    /**
+     * @brief Gets the maximum number of snapshots the buffer can hold.
+     */
+    size_t capacity() const { return buffer_.size() - 1; }
+
+    /**
+     * @brief Returns the current value of the change counter.
+     * Pass it to waitForChange() to avoid missing events that happen in between.
+     */
+    std::uint64_t changeCount() const;
+
+    /**
+     * @brief Wakes up a writer blocked in waitForChange().
+     */
+    void notifyWriter();
+
+    /**
+     * @brief Blocks until the change counter differs from @p seen_change_count or the buffer is
+     * shut down.
+     * @param seen_change_count The value previously returned by changeCount().
+     * @return false if the buffer is shutting down, true otherwise.
+     */
+    bool waitForChange(std::uint64_t seen_change_count);
+
 private:
+    bool isFullLocked() const;
+    bool isEmptyLocked() const;
+    bool hasReaderCaughtUpLocked() const;
+    void signalChangeLocked();
+
     size_t advance(size_t idx) const;
     size_t retreat(size_t idx) const;
     size_t distance(size_t from, size_t to) const;
@@ -101,6 +155,8 @@ private:
     size_t head_ = 0;  // Right after the last written
 
     mutable std::mutex mtx_;
+    std::condition_variable cond_change_;
+    std::uint64_t change_count_ = 0;
 
     bool is_shutting_down_ = false;
 };
@@ -1,10 +1,12 @@
 #include "core/factories/generator_factory.h"
 
 #include <enkas/generation/generation_factory.h>
+#include <enkas/generation/generation_settings.h>
 #include <enkas/generation/generator.h>
 #include <enkas/logging/logger.h>
 
 #include <memory>
+#include <optional>
 
 #include "core/settings/settings.h"
 
@@ -18,31 +20,39 @@ using SpiralGalaxySettings = enkas::generation::SpiralGalaxySettings;
 using CollisionModelSettings = enkas::generation::CollisionModelSettings;
 
 std::unique_ptr<Generator> GeneratorFactory::create(const Settings& settings) {
+    const auto generation_settings = createSettings(settings);
+    if (!generation_settings) return nullptr;
+
+    return Factory::create(*generation_settings);
+}
+
+std::optional<enkas::generation::Settings> GeneratorFactory::createSettings(
+    const Settings& settings) {
     try {
         auto method = settings.get<GenerationMethod>(SettingKey::GenerationMethod);
 
         switch (method) {
             case GenerationMethod::NormalSphere:
-                return Factory::create(getNormalSphereSettings(settings));
+                return getNormalSphereSettings(settings);
             case GenerationMethod::UniformCube:
-                return Factory::create(getUniformCubeSettings(settings));
+                return getUniformCubeSettings(settings);
             case GenerationMethod::UniformSphere:
-                return Factory::create(getUniformSphereSettings(settings));
+                return getUniformSphereSettings(settings);
             case GenerationMethod::PlummerSphere:
-                return Factory::create(getPlummerSphereSettings(settings));
+                return getPlummerSphereSettings(settings);
             case GenerationMethod::SpiralGalaxy:
-                return Factory::create(getSpiralGalaxySettings(settings));
+                return getSpiralGalaxySettings(settings);
             case GenerationMethod::CollisionModel:
-                return Factory::create(getCollisionModelSettings(settings));
+                return getCollisionModelSettings(settings);
             case GenerationMethod::File:
             default:
                 ENKAS_LOG_ERROR("Unsupported generation method: {}",
                                 std::string(generationMethodToString(method)));
-                return nullptr;  // Unsupported generation method
+                return std::nullopt;  // Unsupported generation method
         }
     } catch (const std::exception& e) {
         ENKAS_LOG_ERROR("Error occurred while creating generator: {}", e.what());
-        return nullptr;  // An expected key was not found in the provided settings
+        return std::nullopt;  // An expected key was not found in the provided settings
     }
 }
 
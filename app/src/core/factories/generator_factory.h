@@ -1,6 +1,7 @@
 #pragma once
 
 #include <enkas/generation/generation_factory.h>
+#include <enkas/generation/generation_settings.h>
 #include <enkas/generation/generator.h>
 #include <enkas/generation/settings/collision_model_settings.h>
 #include <enkas/generation/settings/normal_sphere_settings.h>
@@ -10,6 +11,7 @@
 #include <enkas/generation/settings/uniform_sphere_settings.h>
 
 #include <memory>
+#include <optional>
 
 #include "core/settings/settings.h"
 
@@ -35,6 +37,15 @@ public:
      */
     static std::unique_ptr<Generator> create(const Settings& settings);
 
+    /**
+     * @brief Extracts the settings of the selected generator, e.g. to identify the system it
+     * generates.
+     * @param settings The settings to read the generator settings from.
+     * @return The generator settings, or std::nullopt if the generation method has no generator
+     * or an expected key was not found.
+     */
+    static std::optional<enkas::generation::Settings> createSettings(const Settings& settings);
+
 private:
     static UniformCubeSettings getUniformCubeSettings(const Settings& settings);
     static NormalSphereSettings getNormalSphereSettings(const Settings& settings);
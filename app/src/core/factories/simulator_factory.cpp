@@ -10,9 +10,12 @@
 #include <enkas/simulation/simulators/hits_simulator.h>
 #include <enkas/simulation/simulators/leapfrog_simulator.h>
 
+#include <cstddef>
 #include <memory>
+#include <string>
 
 #include "core/settings/settings.h"
+#include "core/settings/splitting_coefficients.h"
 
 using Simulator = enkas::simulation::Simulator;
 using Factory = enkas::simulation::Factory;
@@ -21,6 +24,8 @@ using LeapfrogSettings = enkas::simulation::LeapfrogSettings;
 using HermiteSettings = enkas::simulation::HermiteSettings;
 using HitsSettings = enkas::simulation::HitsSettings;
 using BarnesHutLeapfrogSettings = enkas::simulation::BarnesHutLeapfrogSettings;
+using SymplecticSettings = enkas::simulation::SymplecticSettings;
+using BarnesHutSymplecticSettings = enkas::simulation::BarnesHutSymplecticSettings;
 
 std::unique_ptr<Simulator> SimulatorFactory::create(const Settings& settings) {
     try {
@@ -37,6 +42,10 @@ std::unique_ptr<Simulator> SimulatorFactory::create(const Settings& settings) {
                 return Factory::create(getHitsSettings(settings));
             case SimulationMethod::BarnesHutLeapfrog:
                 return Factory::create(getBarnesHutLeapfrogSettings(settings));
+            case SimulationMethod::Symplectic:
+                return Factory::create(getSymplecticSettings(settings));
+            case SimulationMethod::BarnesHutSymplectic:
+                return Factory::create(getBarnesHutSymplecticSettings(settings));
             default:
                 ENKAS_LOG_ERROR("Unsupported simulation method: {}",
                                 std::string(simulationMethodToString(method)));
@@ -81,5 +90,29 @@ BarnesHutLeapfrogSettings SimulatorFactory::getBarnesHutLeapfrogSettings(const S
     out.time_step = settings.get<double>(SettingKey::BarnesHutLeapfrogTimeStep);
     out.theta_mac = settings.get<double>(SettingKey::BarnesHutLeapfrogThetaMac);
     out.softening_parameter = settings.get<double>(SettingKey::BarnesHutLeapfrogSoftening);
+    out.reorder_interval =
+        static_cast<size_t>(settings.get<int>(SettingKey::BarnesHutLeapfrogReorderInterval));
+    return out;
+}
+
+SymplecticSettings SimulatorFactory::getSymplecticSettings(const Settings& settings) {
+    SymplecticSettings out;
+    out.time_step = settings.get<double>(SettingKey::SymplecticTimeStep);
+    out.softening_parameter = settings.get<double>(SettingKey::SymplecticSoftening);
+    out.coefficients = stringToSplittingCoefficients(
+        settings.get<std::string>(SettingKey::SymplecticCoefficients));
+    return out;
+}
+
+BarnesHutSymplecticSettings SimulatorFactory::getBarnesHutSymplecticSettings(
+    const Settings& settings) {
+    BarnesHutSymplecticSettings out;
+    out.time_step = settings.get<double>(SettingKey::BarnesHutSymplecticTimeStep);
+    out.theta_mac = settings.get<double>(SettingKey::BarnesHutSymplecticThetaMac);
+    out.softening_parameter = settings.get<double>(SettingKey::BarnesHutSymplecticSoftening);
+    out.coefficients = stringToSplittingCoefficients(
+        settings.get<std::string>(SettingKey::BarnesHutSymplecticCoefficients));
+    out.reorder_interval =
+        static_cast<size_t>(settings.get<int>(SettingKey::BarnesHutSymplecticReorderInterval));
     return out;
 }
@@ -1,10 +1,12 @@
 #pragma once
 
 #include <enkas/simulation/settings/barneshutleapfrog_settings.h>
+#include <enkas/simulation/settings/barneshutsymplectic_settings.h>
 #include <enkas/simulation/settings/euler_settings.h>
 #include <enkas/simulation/settings/hermite_settings.h>
 #include <enkas/simulation/settings/hits_settings.h>
 #include <enkas/simulation/settings/leapfrog_settings.h>
+#include <enkas/simulation/settings/symplectic_settings.h>
 #include <enkas/simulation/simulation_factory.h>
 #include <enkas/simulation/simulator.h>
 
@@ -22,6 +24,8 @@ class SimulatorFactory {
     using HermiteSettings = enkas::simulation::HermiteSettings;
     using HitsSettings = enkas::simulation::HitsSettings;
     using BarnesHutLeapfrogSettings = enkas::simulation::BarnesHutLeapfrogSettings;
+    using SymplecticSettings = enkas::simulation::SymplecticSettings;
+    using BarnesHutSymplecticSettings = enkas::simulation::BarnesHutSymplecticSettings;
 
 public:
     /**
@@ -39,4 +43,6 @@ private:
     static HermiteSettings getHermiteSettings(const Settings& settings);
     static HitsSettings getHitsSettings(const Settings& settings);
     static BarnesHutLeapfrogSettings getBarnesHutLeapfrogSettings(const Settings& settings);
+    static SymplecticSettings getSymplecticSettings(const Settings& settings);
+    static BarnesHutSymplecticSettings getBarnesHutSymplecticSettings(const Settings& settings);
 };
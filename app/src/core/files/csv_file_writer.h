@@ -2,18 +2,22 @@
 
 #include <enkas/logging/logger.h>
 
+#include <cstddef>
 #include <filesystem>
 #include <fstream>
-#include <iomanip>
-#include <limits>
+#include <memory>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <vector>
 
+#include "core/dataflow/snapshot.h"
+
 /**
  * @brief Manages the lifecycle of a single CSV file for file writing.
  *
- * It handles opening the file, writing headers and data, and closing the file.
+ * It handles opening the file, writing headers and data, and closing the file. Rows are formatted
+ * into a large reusable buffer, which is handed to the file in few large writes.
  */
 template <typename T>
 class CsvFileWriter {
@@ -40,14 +44,12 @@ public:
             }
             file_stream_ << '\n';
         }
-
-        // Set precision for all subsequent writes
-        file_stream_ << std::setprecision(std::numeric_limits<double>::max_digits10);
     }
 
-    // Destructor automatically closes the file stream.
+    // Destructor writes any buffered rows and closes the file stream.
     ~CsvFileWriter() {
         if (file_stream_.is_open()) {
+            flush();
             file_stream_.close();
             ENKAS_LOG_INFO("Closed data file.");
         }
@@ -59,10 +61,39 @@ public:
 
     /**
      * @brief Writes a data object to the file.
-     * Requires an `operator<<(std::ostream&, const T&)` to be defined for type T.
+     * Requires `csvRowCount(const T&)` and `formatCsvRow(char*, const T&, size_t)` to be defined
+     * for type T.
+     */
+    void write(const T& data) {
+        const size_t row_count = csvRowCount(data);
+        for (size_t row = 0; row < row_count; ++row) {
+            if (kBufferSize - buffer_used_ < kMaxCsvRowLength) flush();
+
+            char* end = formatCsvRow(buffer_.get() + buffer_used_, data, row);
+            buffer_used_ = static_cast<size_t>(end - buffer_.get());
+        }
+    }
+
+    /**
+     * @brief Writes a batch of data objects to the file.
      */
-    void write(const T& data) { file_stream_ << data; }
+    void write(std::span<const std::shared_ptr<T>> batch) {
+        for (const auto& data : batch) write(*data);
+    }
+
+    /**
+     * @brief Hands all buffered rows to the file.
+     */
+    void flush() {
+        if (buffer_used_ == 0) return;
+        file_stream_.write(buffer_.get(), static_cast<std::streamsize>(buffer_used_));
+        buffer_used_ = 0;
+    }
 
 private:
+    static constexpr size_t kBufferSize = size_t{1} << 20;  // 1 MiB
+
     std::ofstream file_stream_;
+    std::unique_ptr<char[]> buffer_ = std::make_unique<char[]>(kBufferSize);
+    size_t buffer_used_ = 0;
 };
@@ -7,6 +7,13 @@ namespace file_names {
 inline constexpr char settings[] = "settings.json";
 inline constexpr char system[] = "system.csv";
 inline constexpr char diagnostics[] = "diagnostics.csv";
+inline constexpr char index_suffix[] = ".idx";
+inline constexpr char system_spill[] = "system.spill";
+inline constexpr char diagnostics_spill[] = "diagnostics.spill";
+inline constexpr char trace[] = "trace.json";
+inline constexpr char latencies[] = "latencies.csv";
+inline constexpr char initial_system_cache[] = "initial_systems";
+inline constexpr char initial_system_suffix[] = ".ics";
 }  // namespace file_names
 
 namespace csv_headers {
@@ -0,0 +1,204 @@
+#include "initial_system_cache.h"
+
+#include <enkas/data/system.h>
+#include <enkas/logging/logger.h>
+#include <enkas/math/vector3d.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "core/files/file_constants.h"
+#include "core/files/snapshot_spill_file.h"
+
+namespace {
+// --- Cache Entry Format ---
+constexpr char kEntryMagic[8] = {'E', 'N', 'K', 'A', 'I', 'C', 'S', '3'};
+
+// The header is followed by the canonical settings bytes and then by the spill record.
+struct EntryFileHeader {
+    char magic[8];
+    std::uint64_t key;
+    double potential_energy;
+    double softening_sqr;
+    std::uint64_t settings_size;
+};
+
+// The spill record starts with the snapshot time and the particle count.
+constexpr std::uintmax_t kRecordHeaderBytes = sizeof(double) + sizeof(std::uint64_t);
+constexpr std::uintmax_t kParticleBytes = 2 * sizeof(enkas::math::Vector3D) + sizeof(double);
+
+std::uintmax_t entryBytes(std::uint64_t settings_size, std::uint64_t particle_count) {
+    return sizeof(EntryFileHeader) + settings_size + kRecordHeaderBytes +
+           particle_count * kParticleBytes;
+}
+}  // namespace
+
+InitialSystemCache::InitialSystemCache(std::filesystem::path directory,
+                                       std::uintmax_t byte_budget)
+    : directory_(std::move(directory)), byte_budget_(byte_budget) {}
+
+std::optional<InitialSystemCache::Entry> InitialSystemCache::find(const Key& key) const {
+    const auto path = entryPath(key.hash);
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return std::nullopt;
+
+    EntryFileHeader header{};
+    spill_detail::readRaw(file, &header, 1);
+    if (!file || !std::equal(std::begin(kEntryMagic), std::end(kEntryMagic), header.magic) ||
+        header.key != key.hash) {
+        ENKAS_LOG_WARNING("Ignoring unreadable initial system cache entry: {}", path.string());
+        return std::nullopt;
+    }
+
+    // Compare the sizes first, so that a corrupt size never drives an allocation.
+    if (header.settings_size != key.settings.size()) return std::nullopt;
+    std::vector<std::byte> settings(key.settings.size());
+    double time = 0.0;
+    std::uint64_t particle_count = 0;
+    spill_detail::readRaw(file, settings.data(), settings.size());
+    spill_detail::readRaw(file, &time, 1);
+    spill_detail::readRaw(file, &particle_count, 1);
+    if (!file) {
+        ENKAS_LOG_WARNING("Ignoring unreadable initial system cache entry: {}", path.string());
+        return std::nullopt;
+    }
+    if (settings != key.settings) {
+        ENKAS_LOG_DEBUG("Initial system cache entry belongs to other settings: {}", path.string());
+        return std::nullopt;
+    }
+
+    std::error_code error;
+    const auto file_size = std::filesystem::file_size(path, error);
+    if (error || file_size != entryBytes(settings.size(), particle_count)) {
+        ENKAS_LOG_WARNING("Ignoring truncated initial system cache entry: {}", path.string());
+        return std::nullopt;
+    }
+
+    return Entry{.path = path,
+                 .particles_offset = entryBytes(settings.size(), 0),
+                 .particle_count = static_cast<std::size_t>(particle_count),
+                 .potential_energy = header.potential_energy,
+                 .softening_sqr = header.softening_sqr};
+}
+
+bool InitialSystemCache::read(const Entry& entry, enkas::data::System& system) const {
+    std::ifstream file(entry.path, std::ios::binary);
+    file.seekg(static_cast<std::streamoff>(entry.particles_offset));
+    if (!file) {
+        ENKAS_LOG_ERROR("Failed to open initial system cache entry: {}", entry.path.string());
+        return false;
+    }
+
+    system.resize(entry.particle_count);
+    spill_detail::readRaw(file, system.positions.data(), system.count());
+    spill_detail::readRaw(file, system.velocities.data(), system.count());
+    spill_detail::readRaw(file, system.masses.data(), system.count());
+    if (!file) {
+        ENKAS_LOG_ERROR("Failed to read initial system cache entry: {}", entry.path.string());
+        return false;
+    }
+
+    // Mark the entry as recently used, so that eviction keeps it.
+    std::error_code error;
+    const auto now = std::filesystem::file_time_type::clock::now();
+    std::filesystem::last_write_time(entry.path, now, error);
+    return true;
+}
+
+bool InitialSystemCache::store(const Key& key,
+                               const enkas::data::System& system,
+                               double potential_energy,
+                               double softening_sqr) const {
+    if (entryBytes(key.settings.size(), system.count()) > byte_budget_) return false;
+
+    std::error_code error;
+    std::filesystem::create_directories(directory_, error);
+
+    const auto path = entryPath(key.hash);
+    // A unique temporary name, so that concurrent runs storing the same key do not collide.
+    const auto unique_suffix = std::chrono::steady_clock::now().time_since_epoch().count();
+    auto temp_path = path;
+    temp_path += std::format(".{}.tmp", unique_suffix);
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+
+        EntryFileHeader header{};
+        std::copy(std::begin(kEntryMagic), std::end(kEntryMagic), header.magic);
+        header.key = key.hash;
+        header.potential_energy = potential_energy;
+        header.softening_sqr = softening_sqr;
+        header.settings_size = key.settings.size();
+        spill_detail::writeRaw(file, &header, 1);
+        spill_detail::writeRaw(file, key.settings.data(), key.settings.size());
+
+        const double time = 0.0;
+        const std::uint64_t particle_count = system.count();
+        spill_detail::writeRaw(file, &time, 1);
+        spill_detail::writeRaw(file, &particle_count, 1);
+        spill_detail::writeRaw(file, system.positions.data(), system.count());
+        spill_detail::writeRaw(file, system.velocities.data(), system.count());
+        spill_detail::writeRaw(file, system.masses.data(), system.count());
+
+        if (!file) {
+            ENKAS_LOG_WARNING("Failed to write initial system cache entry: {}", path.string());
+            file.close();
+            std::filesystem::remove(temp_path, error);
+            return false;
+        }
+    }
+
+    std::filesystem::rename(temp_path, path, error);
+    if (error) {
+        ENKAS_LOG_WARNING("Failed to store initial system cache entry: {}", path.string());
+        std::filesystem::remove(temp_path, error);
+        return false;
+    }
+
+    evict();
+    return true;
+}
+
+std::filesystem::path InitialSystemCache::entryPath(std::uint64_t key) const {
+    return directory_ / std::format("{:016x}{}", key, file_names::initial_system_suffix);
+}
+
+void InitialSystemCache::evict() const {
+    struct CachedFile {
+        std::filesystem::path path;
+        std::uintmax_t size;
+        std::filesystem::file_time_type last_used;
+    };
+
+    std::vector<CachedFile> files;
+    std::uintmax_t total_bytes = 0;
+    std::error_code error;
+    for (const auto& item : std::filesystem::directory_iterator(directory_, error)) {
+        if (item.path().extension() != file_names::initial_system_suffix) continue;
+
+        std::error_code item_error;
+        const auto size = item.file_size(item_error);
+        const auto last_used = item.last_write_time(item_error);
+        if (item_error) continue;
+
+        files.push_back({item.path(), size, last_used});
+        total_bytes += size;
+    }
+
+    std::ranges::sort(files, {}, &CachedFile::last_used);
+    for (const auto& file : files) {
+        if (total_bytes <= byte_budget_) break;
+        if (std::filesystem::remove(file.path, error)) {
+            ENKAS_LOG_DEBUG("Evicted initial system cache entry: {}", file.path.string());
+            total_bytes -= file.size;
+        }
+    }
+}
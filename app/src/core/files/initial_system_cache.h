@@ -0,0 +1,93 @@
+#pragma once
+
+#include <enkas/data/system.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+/**
+ * @brief An on-disk cache of generated initial systems, keyed by the generation settings.
+ *
+ * Every system is stored in its own file, named after the hash of the settings: a small header
+ * with the hash, the canonical bytes of the settings and the potential energy of the system along
+ * with the softening it was computed with, followed by the system as a spill record (see
+ * snapshot_spill_file.h). The settings bytes are compared on lookup, so settings whose hashes
+ * collide never return each other's system.
+ *
+ * Storing the potential energy lets a cache hit skip both the generation and the pairwise energy
+ * sum needed to scale the system to Hénon units. Entries are written to a temporary file and
+ * renamed, so concurrent runs never read a partial entry. Once the cache exceeds its byte budget,
+ * the least recently used entries are removed.
+ *
+ * The files are in the in-memory representation of the machine that wrote them.
+ */
+class InitialSystemCache {
+public:
+    static constexpr std::uintmax_t kDefaultByteBudget = std::uintmax_t{4} << 30;  // 4 GiB
+
+    /**
+     * @brief Identifies the generation settings of a cached system.
+     */
+    struct Key {
+        std::uint64_t hash = 0;           // See enkas::generation::hashSettings()
+        std::vector<std::byte> settings;  // See enkas::generation::serializeSettings()
+    };
+
+    /**
+     * @brief A cached system found by find().
+     */
+    struct Entry {
+        std::filesystem::path path;
+        std::uintmax_t particles_offset = 0;  // Where the particle data starts in the file
+        std::size_t particle_count = 0;
+        double potential_energy = 0.0;  // Including G, in units of pc, solar mass, and km/s
+        double softening_sqr = 0.0;     // The squared softening of the potential energy
+    };
+
+    /**
+     * @brief Creates a cache in @p directory. The directory is created on the first store().
+     */
+    explicit InitialSystemCache(std::filesystem::path directory,
+                                std::uintmax_t byte_budget = kDefaultByteBudget);
+
+    /**
+     * @brief Looks up the system stored under @p key, without reading its particles.
+     * @return The entry, or std::nullopt if there is no valid entry for the key.
+     */
+    [[nodiscard]] std::optional<Entry> find(const Key& key) const;
+
+    /**
+     * @brief Reads the particles of an entry into @p system, resizing it to the particle count.
+     * The particles are read straight into the buffers of @p system, so a preallocated system is
+     * filled without any intermediate copy.
+     * @return True on success. On failure, @p system is left in an unspecified state.
+     */
+    bool read(const Entry& entry, enkas::data::System& system) const;
+
+    /**
+     * @brief Stores a system under @p key, replacing any previous entry.
+     * @param key The generation settings of the system.
+     * @param system The generated system, before it is scaled to Hénon units.
+     * @param potential_energy The potential energy of the system, including G.
+     * @param softening_sqr The squared softening that @p potential_energy was computed with.
+     * @return True if the entry was written.
+     */
+    bool store(const Key& key,
+               const enkas::data::System& system,
+               double potential_energy,
+               double softening_sqr) const;
+
+private:
+    [[nodiscard]] std::filesystem::path entryPath(std::uint64_t key) const;
+
+    /**
+     * @brief Removes the least recently used entries until the cache fits into its byte budget.
+     */
+    void evict() const;
+
+    std::filesystem::path directory_;
+    std::uintmax_t byte_budget_;
+};
@@ -0,0 +1,182 @@
+#include "core/files/snapshot_decode_pool.h"
+
+#include <enkas/logging/logger.h>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+std::optional<SnapshotColumnLayout> SnapshotColumnLayout::fromColumnIndices(
+    const std::map<std::string, size_t>& column_indices) {
+    try {
+        return SnapshotColumnLayout{column_indices.at("pos_x"),
+                                    column_indices.at("pos_y"),
+                                    column_indices.at("pos_z"),
+                                    column_indices.at("vel_x"),
+                                    column_indices.at("vel_y"),
+                                    column_indices.at("vel_z"),
+                                    column_indices.at("mass")};
+    } catch (const std::out_of_range&) {
+        return std::nullopt;
+    }
+}
+
+size_t SnapshotColumnLayout::maxIndex() const {
+    return std::max({pos_x, pos_y, pos_z, vel_x, vel_y, vel_z, mass});
+}
+
+std::optional<SystemSnapshot> decodeSnapshot(std::istream& stream,
+                                             const SnapshotDecodeJob& job,
+                                             const SnapshotColumnLayout& layout) {
+    const double timestamp = job.timestamp;
+    stream.clear();
+    stream.seekg(job.file_offset);
+
+    if (!stream) {
+        ENKAS_LOG_ERROR("Failed to seek to offset {} for snapshot {}",
+                        static_cast<std::streamoff>(job.file_offset),
+                        timestamp);
+        return std::nullopt;
+    }
+
+    const size_t max_idx = layout.maxIndex();
+
+    enkas::data::System system;
+    system.positions.reserve(job.row_count);
+    system.velocities.reserve(job.row_count);
+    system.masses.reserve(job.row_count);
+
+    std::string line;
+    for (int i = 0; i < job.row_count; ++i) {
+        if (!std::getline(stream, line)) {
+            ENKAS_LOG_ERROR(
+                "Unexpected end of file for snapshot {}. Expected {} rows, but file ended after "
+                "{}.",
+                timestamp,
+                job.row_count,
+                i);
+            return std::nullopt;
+        }
+
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+
+        try {
+            std::stringstream line_ss(line);
+            std::vector<std::string> values;
+            std::string value;
+            while (std::getline(line_ss, value, ',')) {
+                values.push_back(value);
+            }
+
+            if (values.size() <= max_idx) {
+                ENKAS_LOG_ERROR(
+                    "Malformed row in snapshot at timestamp {}: not enough columns. Line: {}",
+                    timestamp,
+                    line);
+                return std::nullopt;
+            }
+
+            system.positions.emplace_back(std::stod(values[layout.pos_x]),
+                                          std::stod(values[layout.pos_y]),
+                                          std::stod(values[layout.pos_z]));
+            system.velocities.emplace_back(std::stod(values[layout.vel_x]),
+                                           std::stod(values[layout.vel_y]),
+                                           std::stod(values[layout.vel_z]));
+            system.masses.push_back(std::stod(values[layout.mass]));
+
+        } catch (const std::invalid_argument& e) {
+            ENKAS_LOG_ERROR("Error parsing value in snapshot at timestamp {}: {}. Line: {}",
+                            timestamp,
+                            e.what(),
+                            line);
+            return std::nullopt;
+        } catch (const std::out_of_range& e) {
+            ENKAS_LOG_ERROR("Value out of range in snapshot at timestamp {}: {}. Line: {}",
+                            timestamp,
+                            e.what(),
+                            line);
+            return std::nullopt;
+        }
+    }
+
+    return SystemSnapshot{std::move(system), timestamp};
+}
+
+SnapshotDecodePool::SnapshotDecodePool(std::filesystem::path file_path,
+                                       SnapshotColumnLayout layout,
+                                       size_t thread_count)
+    : file_path_(std::move(file_path)), layout_(layout) {
+    threads_.reserve(thread_count);
+    for (size_t i = 0; i < thread_count; ++i) {
+        threads_.emplace_back(&SnapshotDecodePool::decodeLoop, this);
+    }
+}
+
+SnapshotDecodePool::~SnapshotDecodePool() {
+    {
+        std::unique_lock lock(mtx_);
+        is_shutting_down_ = true;
+    }
+    cond_job_.notify_all();
+
+    for (auto& thread : threads_) {
+        if (thread.joinable()) thread.join();
+    }
+
+    // Resolve jobs that never started so nobody waits on them forever.
+    cancelPending();
+}
+
+SnapshotDecodePool::Result SnapshotDecodePool::submit(const SnapshotDecodeJob& job) {
+    PendingJob pending{job, {}};
+    Result result = pending.promise.get_future().share();
+
+    {
+        std::unique_lock lock(mtx_);
+        jobs_.push_back(std::move(pending));
+    }
+    cond_job_.notify_one();
+
+    return result;
+}
+
+void SnapshotDecodePool::cancelPending() {
+    std::deque<PendingJob> cancelled;
+    {
+        std::unique_lock lock(mtx_);
+        cancelled.swap(jobs_);
+    }
+
+    for (auto& pending : cancelled) {
+        pending.promise.set_value(std::nullopt);
+    }
+}
+
+void SnapshotDecodePool::decodeLoop() {
+    std::ifstream stream(file_path_, std::ios::binary);
+    if (!stream.is_open()) {
+        ENKAS_LOG_ERROR("Decoder thread could not open file: {}", file_path_.string());
+    }
+
+    while (true) {
+        PendingJob pending;
+        {
+            std::unique_lock lock(mtx_);
+            cond_job_.wait(lock, [this]() { return is_shutting_down_ || !jobs_.empty(); });
+            if (is_shutting_down_) return;
+
+            pending = std::move(jobs_.front());
+            jobs_.pop_front();
+        }
+
+        if (!stream.is_open()) {
+            pending.promise.set_value(std::nullopt);
+            continue;
+        }
+
+        pending.promise.set_value(decodeSnapshot(stream, pending.job, layout_));
+    }
+}
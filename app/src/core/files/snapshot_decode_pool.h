@@ -0,0 +1,119 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <filesystem>
+#include <future>
+#include <istream>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/dataflow/snapshot.h"
+
+/**
+ * @brief Column positions of the fields needed to decode a system snapshot row.
+ */
+struct SnapshotColumnLayout {
+    size_t pos_x, pos_y, pos_z;
+    size_t vel_x, vel_y, vel_z;
+    size_t mass;
+
+    /**
+     * @brief Builds the layout from a map of column names to column indices.
+     * @return The layout, or std::nullopt if a required column is missing.
+     */
+    static std::optional<SnapshotColumnLayout> fromColumnIndices(
+        const std::map<std::string, size_t>& column_indices);
+
+    /**
+     * @brief Returns the largest column index that a row must contain.
+     */
+    size_t maxIndex() const;
+};
+
+/**
+ * @brief Describes where a single snapshot is stored in a system CSV file.
+ */
+struct SnapshotDecodeJob {
+    std::streampos file_offset;  // Byte offset where the first row of the snapshot starts
+    int row_count;               // Number of rows (particles) in this snapshot
+    double timestamp;            // Simulation time of the snapshot
+};
+
+/**
+ * @brief Decodes a single snapshot from a system CSV stream.
+ * @param stream The stream to read from. It is repositioned to the job's offset.
+ * @param job The location of the snapshot in the stream.
+ * @param layout The column layout of the file.
+ * @return The decoded snapshot, or std::nullopt if the data is malformed.
+ */
+std::optional<SystemSnapshot> decodeSnapshot(std::istream& stream,
+                                             const SnapshotDecodeJob& job,
+                                             const SnapshotColumnLayout& layout);
+
+/**
+ * @brief A pool of threads that decode snapshots of a system CSV file in parallel.
+ *
+ * Every thread owns its own file handle, so jobs at arbitrary offsets can be decoded
+ * concurrently. Results are handed back through futures, which lets the caller reassemble them
+ * in any order it needs.
+ */
+class SnapshotDecodePool {
+public:
+    using Result = std::shared_future<std::optional<SystemSnapshot>>;
+
+    /**
+     * @brief Starts the decoding threads.
+     * @param file_path The path to the system CSV file.
+     * @param layout The column layout of the file.
+     * @param thread_count The number of decoding threads to start.
+     */
+    SnapshotDecodePool(std::filesystem::path file_path,
+                       SnapshotColumnLayout layout,
+                       size_t thread_count);
+    ~SnapshotDecodePool();
+
+    SnapshotDecodePool(const SnapshotDecodePool&) = delete;
+    SnapshotDecodePool& operator=(const SnapshotDecodePool&) = delete;
+
+    /**
+     * @brief Queues a snapshot for decoding.
+     * @param job The location of the snapshot in the file.
+     * @return A future that becomes ready once the snapshot is decoded.
+     */
+    Result submit(const SnapshotDecodeJob& job);
+
+    /**
+     * @brief Drops all queued jobs that have not started yet. Their futures resolve to
+     * std::nullopt.
+     */
+    void cancelPending();
+
+    /**
+     * @brief Returns the number of decoding threads.
+     */
+    size_t threadCount() const { return threads_.size(); }
+
+private:
+    struct PendingJob {
+        SnapshotDecodeJob job;
+        std::promise<std::optional<SystemSnapshot>> promise;
+    };
+
+    void decodeLoop();
+
+    const std::filesystem::path file_path_;
+    const SnapshotColumnLayout layout_;
+
+    std::mutex mtx_;
+    std::condition_variable cond_job_;
+    std::deque<PendingJob> jobs_;
+    bool is_shutting_down_ = false;
+
+    std::vector<std::thread> threads_;
+};
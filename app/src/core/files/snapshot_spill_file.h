@@ -0,0 +1,233 @@
+#pragma once
+
+#include <enkas/data/diagnostics.h>
+#include <enkas/data/system.h>
+#include <enkas/logging/logger.h>
+#include <enkas/math/vector3d.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#include "core/dataflow/snapshot.h"
+
+// --- Spill records ---
+// Snapshots are spilled in their in-memory representation, which is much cheaper to write and
+// read than CSV. The records never leave the machine that wrote them.
+
+namespace spill_detail {
+template <typename T>
+void writeRaw(std::ostream& out, const T* data, size_t count) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(count * sizeof(T)));
+}
+
+template <typename T>
+void readRaw(std::istream& in, T* data, size_t count) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    in.read(reinterpret_cast<char*>(data), static_cast<std::streamsize>(count * sizeof(T)));
+}
+
+/**
+ * @brief Returns the number of bytes between the read position and the end of the stream, or zero
+ * if the stream cannot tell.
+ */
+inline uint64_t remainingBytes(std::istream& in) {
+    const auto position = in.tellg();
+    in.seekg(0, std::ios::end);
+    const auto end = in.tellg();
+    in.seekg(position);
+    return position >= 0 && end > position ? static_cast<uint64_t>(end - position) : 0;
+}
+}  // namespace spill_detail
+
+/**
+ * @brief Writes a system snapshot as a spill record: time, particle count and the raw arrays.
+ */
+inline void writeSpillRecord(std::ostream& out, const SystemSnapshot& snapshot) {
+    const auto& system = *snapshot.data;
+    const uint64_t count = system.count();
+    spill_detail::writeRaw(out, &snapshot.time, 1);
+    spill_detail::writeRaw(out, &count, 1);
+    spill_detail::writeRaw(out, system.positions.data(), count);
+    spill_detail::writeRaw(out, system.velocities.data(), count);
+    spill_detail::writeRaw(out, system.masses.data(), count);
+}
+
+/**
+ * @brief Reads a system snapshot written by writeSpillRecord().
+ * Fails the stream without allocating if the stored particle count exceeds the remaining bytes.
+ */
+inline void readSpillRecord(std::istream& in, Snapshot<enkas::data::System>& snapshot) {
+    constexpr uint64_t kParticleBytes = 2 * sizeof(enkas::math::Vector3D) + sizeof(double);
+
+    uint64_t count = 0;
+    spill_detail::readRaw(in, &snapshot.time, 1);
+    spill_detail::readRaw(in, &count, 1);
+    if (!in || count > spill_detail::remainingBytes(in) / kParticleBytes) {
+        in.setstate(std::ios::failbit);
+        return;
+    }
+
+    auto system = std::make_shared<enkas::data::System>(static_cast<size_t>(count));
+    spill_detail::readRaw(in, system->positions.data(), system->count());
+    spill_detail::readRaw(in, system->velocities.data(), system->count());
+    spill_detail::readRaw(in, system->masses.data(), system->count());
+    snapshot.data = std::move(system);
+}
+
+/**
+ * @brief Writes a diagnostics snapshot as a spill record: time and the raw diagnostics.
+ */
+inline void writeSpillRecord(std::ostream& out, const DiagnosticsSnapshot& snapshot) {
+    spill_detail::writeRaw(out, &snapshot.time, 1);
+    spill_detail::writeRaw(out, snapshot.data.get(), 1);
+}
+
+/**
+ * @brief Reads a diagnostics snapshot written by writeSpillRecord().
+ */
+inline void readSpillRecord(std::istream& in, Snapshot<enkas::data::Diagnostics>& snapshot) {
+    auto diagnostics = std::make_shared<enkas::data::Diagnostics>();
+    spill_detail::readRaw(in, &snapshot.time, 1);
+    spill_detail::readRaw(in, diagnostics.get(), 1);
+    snapshot.data = std::move(diagnostics);
+}
+
+/**
+ * @brief A temporary file that holds snapshots which did not fit into an output queue.
+ *
+ * Records are read back in the order they were written. The file is truncated whenever it has
+ * been read completely, so it only grows while the consumer is behind, and it is deleted when the
+ * spill file is destroyed.
+ *
+ * The class is not thread-safe. It is meant to be written by the producer and read by the
+ * consumer, with pending(), write() and markRead() guarded by a lock that the owner holds. read()
+ * may run without the lock, as long as the record was already counted by pending().
+ *
+ * @tparam T The snapshot data type, e.g. enkas::data::System.
+ */
+template <typename T>
+class SnapshotSpillFile {
+public:
+    using SnapshotPtr = std::shared_ptr<const Snapshot<T>>;
+
+    /**
+     * @brief Creates the spill file, replacing any existing file at @p file_path.
+     * Check isOpen() to see whether the file could be created.
+     */
+    explicit SnapshotSpillFile(std::filesystem::path file_path) : file_path_(std::move(file_path)) {
+        std::error_code error;
+        std::filesystem::create_directories(file_path_.parent_path(), error);
+
+        out_.open(file_path_, std::ios::binary | std::ios::trunc);
+        in_.open(file_path_, std::ios::binary);
+        if (!out_.is_open() || !in_.is_open()) {
+            ENKAS_LOG_ERROR("Failed to open spill file: {}", file_path_.string());
+        }
+    }
+
+    ~SnapshotSpillFile() {
+        out_.close();
+        in_.close();
+        std::error_code error;
+        std::filesystem::remove(file_path_, error);
+    }
+
+    SnapshotSpillFile(const SnapshotSpillFile&) = delete;
+    SnapshotSpillFile& operator=(const SnapshotSpillFile&) = delete;
+
+    /**
+     * @brief Returns whether the file is usable.
+     */
+    [[nodiscard]] bool isOpen() const { return out_.is_open() && in_.is_open(); }
+
+    /**
+     * @brief Returns the number of records that were written but not read yet.
+     */
+    [[nodiscard]] size_t pending() const { return pending_; }
+
+    /**
+     * @brief Appends a snapshot and flushes it, so that it is visible to read().
+     * A record that fails partway is cut off again, so that the next record follows the last
+     * complete one.
+     * @return False if the record could not be written.
+     */
+    bool write(const Snapshot<T>& snapshot) {
+        if (!out_.is_open()) return false;
+
+        const std::streampos record_start = out_.tellp();
+        writeSpillRecord(out_, snapshot);
+        out_.flush();
+        if (!out_) {
+            ENKAS_LOG_ERROR("Failed to write to spill file: {}", file_path_.string());
+            discardFrom(record_start);
+            return false;
+        }
+        ++pending_;
+        return true;
+    }
+
+    /**
+     * @brief Reads the oldest record that has not been read yet.
+     * Must be followed by markRead() once the record is consumed.
+     * @return The snapshot, or nullptr if the record could not be read.
+     */
+    [[nodiscard]] SnapshotPtr read() {
+        // Seeking to the current position drops buffered bytes, which may stem from a partial
+        // record that was cut off and overwritten since.
+        in_.seekg(in_.tellg());
+
+        auto snapshot = std::make_shared<Snapshot<T>>();
+        readSpillRecord(in_, *snapshot);
+        if (!in_) {
+            ENKAS_LOG_ERROR("Failed to read from spill file: {}", file_path_.string());
+            in_.clear();
+            return nullptr;
+        }
+        return snapshot;
+    }
+
+    /**
+     * @brief Marks the oldest record as read, and truncates the file once it has been drained.
+     */
+    void markRead() {
+        if (pending_ == 0 || --pending_ > 0) return;
+
+        out_.close();
+        in_.close();
+        out_.open(file_path_, std::ios::binary | std::ios::trunc);
+        in_.open(file_path_, std::ios::binary);
+    }
+
+private:
+    /**
+     * @brief Truncates the file to @p offset and continues writing there.
+     * If that fails, the file is closed, which makes isOpen() false and every later write fail.
+     */
+    void discardFrom(std::streampos offset) {
+        // Reopening drops whatever the failed write left in the stream buffer.
+        out_.close();
+        std::error_code error;
+        if (offset >= 0) {
+            std::filesystem::resize_file(file_path_, static_cast<uintmax_t>(offset), error);
+            out_.open(file_path_, std::ios::binary | std::ios::in | std::ios::out);
+            out_.seekp(offset);
+        }
+        if (offset < 0 || error || !out_) {
+            ENKAS_LOG_ERROR("Failed to discard a partial record in spill file: {}",
+                            file_path_.string());
+            out_.close();
+        }
+    }
+
+    std::filesystem::path file_path_;
+    std::ofstream out_;
+    std::ifstream in_;
+    size_t pending_ = 0;
+};
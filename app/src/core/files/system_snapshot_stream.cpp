@@ -3,19 +3,61 @@
 #include <enkas/logging/logger.h>
 
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 
 #include "core/files/file_constants.h"
 
-SystemSnapshotStream::SystemSnapshotStream(std::filesystem::path file_path)
-    : file_path_(std::move(file_path)) {
-    // Set iterator to a known invalid state initially
-    current_index_iterator_ = index_.end();
+namespace {
+// --- Persisted Index Format ---
+constexpr char kIndexMagic[8] = {'E', 'N', 'K', 'A', 'I', 'D', 'X', '1'};
+
+struct IndexFileHeader {
+    char magic[8];
+    std::uint64_t source_size;
+    std::int64_t source_mtime;
+    std::uint64_t entry_count;
+};
+
+struct IndexFileEntry {
+    double timestamp;
+    std::int64_t file_offset;
+    std::int64_t row_count;
+};
+
+/**
+ * @brief Captures the size and modification time of the CSV file the index was built from.
+ */
+std::optional<std::pair<std::uint64_t, std::int64_t>> sourceFingerprint(
+    const std::filesystem::path& path) {
+    std::error_code ec;
+    const auto size = std::filesystem::file_size(path, ec);
+    if (ec) return std::nullopt;
+    const auto mtime = std::filesystem::last_write_time(path, ec);
+    if (ec) return std::nullopt;
+    return std::make_pair(static_cast<std::uint64_t>(size),
+                          static_cast<std::int64_t>(mtime.time_since_epoch().count()));
 }
+}  // namespace
+
+SystemSnapshotStream::SystemSnapshotStream(std::filesystem::path file_path,
+                                           std::size_t cache_capacity,
+                                           std::size_t decode_thread_count,
+                                           std::size_t max_prefetch_count)
+    : file_path_(std::move(file_path)),
+      cache_(cache_capacity),
+      decode_thread_count_(decode_thread_count),
+      max_prefetch_count_(max_prefetch_count) {}
 
 SystemSnapshotStream::~SystemSnapshotStream() {
+    // Stop the decoders before the results they would deliver go out of scope.
+    in_flight_.clear();
+    decode_pool_.reset();
+
     if (file_stream_.is_open()) {
         file_stream_.close();
     }
@@ -26,9 +68,14 @@ bool SystemSnapshotStream::initialize() {
         return true;
     }
 
-    if (!buildIndex()) {
-        ENKAS_LOG_ERROR("Failed to build index for file: {}", file_path_.string());
-        return false;
+    if (loadPersistedIndex()) {
+        ENKAS_LOG_DEBUG("Reusing persisted index for file: {}", file_path_.string());
+    } else {
+        if (!buildIndex()) {
+            ENKAS_LOG_ERROR("Failed to build index for file: {}", file_path_.string());
+            return false;
+        }
+        persistIndex();
     }
 
     // After a successful index, open the main stream for reading snapshots.
@@ -39,8 +86,22 @@ bool SystemSnapshotStream::initialize() {
         return false;
     }
 
+    column_layout_ = SnapshotColumnLayout::fromColumnIndices(column_indices_);
+    if (!column_layout_) {
+        ENKAS_LOG_ERROR(
+            "CSV file header is missing one or more required columns (e.g. pos_x, vel_y, mass).");
+        index_.clear();
+        return false;
+    }
+
+    if (decode_thread_count_ > 0) {
+        decode_pool_ =
+            std::make_unique<SnapshotDecodePool>(file_path_, *column_layout_, decode_thread_count_);
+    }
+
     // Set the current position to "before the beginning" to be used by getNextSnapshot.
-    current_index_iterator_ = index_.end();
+    current_position_ = kBeforeFirst;
+    cache_.clear();
 
     is_initialized_ = true;
     ENKAS_LOG_INFO("Successfully indexed {} snapshots from {}", index_.size(), file_path_.string());
@@ -103,6 +164,8 @@ bool SystemSnapshotStream::buildIndex() {
         return true;  // Not an error, just an empty file
     }
 
+    index_.clear();
+
     std::string line;
     double last_timestamp = -1.0;
     std::streampos current_snapshot_start_pos = first_data_pos;
@@ -139,7 +202,7 @@ bool SystemSnapshotStream::buildIndex() {
             double current_timestamp = std::stod(values[time_idx]);
 
             if (last_timestamp != -1.0 && current_timestamp != last_timestamp) {
-                index_[last_timestamp] = {current_snapshot_start_pos, row_count};
+                index_.push_back({last_timestamp, current_snapshot_start_pos, row_count});
                 current_snapshot_start_pos = current_line_start_pos;
                 row_count = 0;
             }
@@ -162,49 +225,162 @@ bool SystemSnapshotStream::buildIndex() {
 
     // Store the very last snapshot in the file
     if (row_count > 0) {
-        index_[last_timestamp] = {current_snapshot_start_pos, row_count};
+        index_.push_back({last_timestamp, current_snapshot_start_pos, row_count});
+    }
+
+    // Snapshots are written in chronological order, but keep lookups correct for any file.
+    const auto by_timestamp = [](const SnapshotIndexEntry& a, const SnapshotIndexEntry& b) {
+        return a.timestamp < b.timestamp;
+    };
+    if (!std::is_sorted(index_.begin(), index_.end(), by_timestamp)) {
+        ENKAS_LOG_WARNING("Snapshots are not in chronological order in file: {}",
+                          file_path_.string());
+        std::stable_sort(index_.begin(), index_.end(), by_timestamp);
     }
 
     return !index_.empty();
 }
 
+std::filesystem::path SystemSnapshotStream::indexFilePath() const {
+    auto path = file_path_;
+    path += file_names::index_suffix;
+    return path;
+}
+
+bool SystemSnapshotStream::loadPersistedIndex() {
+    const auto fingerprint = sourceFingerprint(file_path_);
+    if (!fingerprint) return false;
+
+    std::ifstream index_file(indexFilePath(), std::ios::binary);
+    if (!index_file.is_open()) return false;
+
+    IndexFileHeader header{};
+    if (!index_file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        !std::equal(std::begin(kIndexMagic), std::end(kIndexMagic), header.magic)) {
+        ENKAS_LOG_WARNING("Ignoring unreadable index file: {}", indexFilePath().string());
+        return false;
+    }
+
+    if (header.source_size != fingerprint->first || header.source_mtime != fingerprint->second) {
+        ENKAS_LOG_DEBUG("Ignoring stale index file: {}", indexFilePath().string());
+        return false;
+    }
+
+    // Check the entry count against the file size before allocating, so that a corrupt count
+    // falls back to a rescan instead of a huge allocation.
+    std::error_code ec;
+    const auto file_size = std::filesystem::file_size(indexFilePath(), ec);
+    const auto entries_bytes = ec ? 0 : file_size - sizeof(header);
+    if (ec || entries_bytes % sizeof(IndexFileEntry) != 0 ||
+        header.entry_count != entries_bytes / sizeof(IndexFileEntry)) {
+        ENKAS_LOG_WARNING("Ignoring truncated index file: {}", indexFilePath().string());
+        return false;
+    }
+
+    std::vector<IndexFileEntry> entries(header.entry_count);
+    if (!index_file.read(reinterpret_cast<char*>(entries.data()),
+                         static_cast<std::streamsize>(entries.size() * sizeof(IndexFileEntry)))) {
+        ENKAS_LOG_WARNING("Ignoring truncated index file: {}", indexFilePath().string());
+        return false;
+    }
+
+    index_.clear();
+    index_.reserve(entries.size());
+    for (const auto& entry : entries) {
+        index_.push_back({entry.timestamp,
+                          static_cast<std::streamoff>(entry.file_offset),
+                          static_cast<int>(entry.row_count)});
+    }
+
+    // The index is only ever persisted for files with a valid header.
+    column_indices_.clear();
+    for (size_t i = 0; i < csv_headers::system.size(); ++i) {
+        column_indices_[csv_headers::system[i]] = i;
+    }
+
+    return !index_.empty();
+}
+
+void SystemSnapshotStream::persistIndex() const {
+    const auto fingerprint = sourceFingerprint(file_path_);
+    if (!fingerprint) return;
+
+    std::ofstream index_file(indexFilePath(), std::ios::binary | std::ios::trunc);
+    if (!index_file.is_open()) {
+        ENKAS_LOG_WARNING("Could not persist index file: {}", indexFilePath().string());
+        return;
+    }
+
+    IndexFileHeader header{};
+    std::copy(std::begin(kIndexMagic), std::end(kIndexMagic), header.magic);
+    header.source_size = fingerprint->first;
+    header.source_mtime = fingerprint->second;
+    header.entry_count = index_.size();
+    index_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    for (const auto& entry : index_) {
+        const IndexFileEntry file_entry{entry.timestamp,
+                                        static_cast<std::int64_t>(entry.file_offset),
+                                        static_cast<std::int64_t>(entry.row_count)};
+        index_file.write(reinterpret_cast<const char*>(&file_entry), sizeof(file_entry));
+    }
+
+    if (!index_file) {
+        ENKAS_LOG_WARNING("Failed to write index file: {}", indexFilePath().string());
+    }
+}
+
 std::optional<SystemSnapshot> SystemSnapshotStream::getSnapshotAtFraction(double mu) {
-    if (!is_initialized_) return std::nullopt;
+    if (!is_initialized_ || index_.empty()) return std::nullopt;
 
     if (mu < 0.0 || mu > 1.0) {
         ENKAS_LOG_ERROR("Fraction must be between 0.0 and 1.0, got: {}", mu);
         return std::nullopt;
     }
 
-    const std::size_t idx = static_cast<std::size_t>(std::floor(mu * (index_.size() - 1)));
+    // Anything prefetched for the old position is most likely useless now.
+    cancelPrefetch();
+
+    current_position_ = static_cast<std::size_t>(std::floor(mu * (index_.size() - 1)));
+    return snapshotAt(current_position_, 1);
+}
+
+std::optional<double> SystemSnapshotStream::getTimestampAtFraction(double mu) const {
+    if (!is_initialized_ || index_.empty() || mu < 0.0 || mu > 1.0) return std::nullopt;
+    return index_[static_cast<std::size_t>(std::floor(mu * (index_.size() - 1)))].timestamp;
+}
+
+bool SystemSnapshotStream::seekTo(double timestamp) {
+    if (!is_initialized_) return false;
 
-    // Move iterator to the desired position
-    auto it = std::next(index_.cbegin(), idx);
-    current_index_iterator_ = it;
+    const std::size_t position = lowerBound(timestamp);
+    if (position == index_.size() || index_[position].timestamp != timestamp) return false;
 
-    return parseSnapshotFromIndex(it->second, it->first);
+    current_position_ = position;
+    return true;
 }
 
 std::optional<SystemSnapshot> SystemSnapshotStream::getFirstSnapshot() {
     if (!is_initialized_ || index_.empty()) return std::nullopt;
-    current_index_iterator_ = index_.cbegin();
-    return parseSnapshotFromIndex(current_index_iterator_->second, current_index_iterator_->first);
+    current_position_ = 0;
+    return snapshotAt(current_position_, 1);
 }
 
 std::optional<SystemSnapshot> SystemSnapshotStream::getNextSnapshot() {
     if (!is_initialized_ || index_.empty()) return std::nullopt;
 
-    if (current_index_iterator_ == index_.end()) {
-        current_index_iterator_ = index_.begin();
+    if (current_position_ == kBeforeFirst) {
+        current_position_ = 0;
     } else {
-        ++current_index_iterator_;
+        ++current_position_;
     }
 
-    if (current_index_iterator_ == index_.end()) {
+    if (current_position_ >= index_.size()) {
+        current_position_ = kBeforeFirst;
         return std::nullopt;
     }
 
-    return parseSnapshotFromIndex(current_index_iterator_->second, current_index_iterator_->first);
+    return snapshotAt(current_position_, 1);
 }
 
 std::optional<SystemSnapshot> SystemSnapshotStream::getPrecedingSnapshot(double timestamp) {
@@ -212,129 +388,129 @@ std::optional<SystemSnapshot> SystemSnapshotStream::getPrecedingSnapshot(double
         return std::nullopt;
     }
 
-    auto it = index_.lower_bound(timestamp);
-
-    if (it == index_.begin()) {
+    const std::size_t position = lowerBound(timestamp);
+    if (position == 0) {
         return std::nullopt;
     }
 
-    --it;
-
-    return parseSnapshotFromIndex(it->second, it->first);
+    return snapshotAt(position - 1, -1);
 }
 
 std::vector<double> SystemSnapshotStream::getAllTimestamps() const {
     if (!is_initialized_) return {};
     std::vector<double> timestamps;
     timestamps.reserve(index_.size());
-    for (const auto& [time, entry] : index_) {
-        timestamps.push_back(time);
+    for (const auto& entry : index_) {
+        timestamps.push_back(entry.timestamp);
     }
     return timestamps;
 }
 
-std::optional<SystemSnapshot> SystemSnapshotStream::parseSnapshotFromIndex(
-    const SnapshotIndexEntry& entry, double timestamp) {
-    file_stream_.clear();
-    file_stream_.seekg(entry.file_offset);
+std::optional<double> SystemSnapshotStream::getLastTimestamp() const {
+    if (!is_initialized_ || index_.empty()) return std::nullopt;
+    return index_.back().timestamp;
+}
 
-    if (!file_stream_) {
-        ENKAS_LOG_ERROR("Failed to seek to offset {} in file {}",
-                        static_cast<std::streamoff>(entry.file_offset),
-                        file_path_.string());
-        return std::nullopt;
+std::size_t SystemSnapshotStream::lowerBound(double timestamp) const {
+    const std::size_t count = index_.size();
+    if (count == 0 || timestamp <= index_.front().timestamp) return 0;
+    if (timestamp > index_.back().timestamp) return count;
+
+    // Guess the position assuming evenly spaced snapshots, then correct locally.
+    const double span = index_.back().timestamp - index_.front().timestamp;
+    const double guess = span > 0.0 ? (timestamp - index_.front().timestamp) / span : 0.0;
+    std::size_t position =
+        std::min(count - 1, static_cast<std::size_t>(guess * static_cast<double>(count - 1)));
+
+    constexpr std::size_t kMaxLinearSteps = 8;
+    for (std::size_t step = 0; step < kMaxLinearSteps; ++step) {
+        const bool too_far = position > 0 && index_[position - 1].timestamp >= timestamp;
+        const bool too_early = index_[position].timestamp < timestamp;
+        if (too_far) {
+            --position;
+        } else if (too_early) {
+            ++position;
+        } else {
+            return position;
+        }
     }
 
-    // Get column indices once
-    size_t pos_x_idx, pos_y_idx, pos_z_idx, vel_x_idx, vel_y_idx, vel_z_idx, mass_idx;
-    try {
-        pos_x_idx = column_indices_.at("pos_x");
-        pos_y_idx = column_indices_.at("pos_y");
-        pos_z_idx = column_indices_.at("pos_z");
-        vel_x_idx = column_indices_.at("vel_x");
-        vel_y_idx = column_indices_.at("vel_y");
-        vel_z_idx = column_indices_.at("vel_z");
-        mass_idx = column_indices_.at("mass");
-    } catch (const std::out_of_range&) {
-        ENKAS_LOG_ERROR(
-            "CSV file header is missing one or more required columns (e.g. pos_x, vel_y, mass).");
-        return std::nullopt;
+    // Spacing is too irregular for the guess, fall back to a binary search.
+    const auto it = std::lower_bound(
+        index_.begin(), index_.end(), timestamp, [](const SnapshotIndexEntry& entry, double t) {
+            return entry.timestamp < t;
+        });
+    return static_cast<std::size_t>(std::distance(index_.begin(), it));
+}
+
+std::optional<SystemSnapshot> SystemSnapshotStream::snapshotAt(std::size_t position,
+                                                               int direction) {
+    // Queue the neighbours first, so they are decoded while we work on this one.
+    prefetch(position, direction);
+
+    if (auto cached = cache_.get(position)) {
+        return SystemSnapshot{cached->data, cached->time};
     }
-    const size_t max_idx =
-        std::max({pos_x_idx, pos_y_idx, pos_z_idx, vel_x_idx, vel_y_idx, vel_z_idx, mass_idx});
 
-    enkas::data::System system;
-    system.positions.reserve(entry.row_count);
-    system.velocities.reserve(entry.row_count);
-    system.masses.reserve(entry.row_count);
+    auto snapshot = decodeAt(position);
+    if (snapshot) {
+        cache_.put(position, Snapshot<enkas::data::System>(snapshot->data, snapshot->time));
+    }
+    return snapshot;
+}
 
-    std::string line;
-    for (int i = 0; i < entry.row_count; ++i) {
-        if (!std::getline(file_stream_, line)) {
-            ENKAS_LOG_ERROR(
-                "Unexpected end of file for snapshot {}. Expected {} rows, but file ended after "
-                "{}.",
-                timestamp,
-                entry.row_count,
-                i);
-            return std::nullopt;
-        }
+std::optional<SystemSnapshot> SystemSnapshotStream::decodeAt(std::size_t position) {
+    if (auto it = in_flight_.find(position); it != in_flight_.end()) {
+        auto result = it->second.get();
+        in_flight_.erase(it);
+        if (result) return result;
+        // The job was cancelled or failed, decode it here instead.
+    }
 
-        if (!line.empty() && line.back() == '\r') {
-            line.pop_back();
-        }
+    return decodeSnapshot(file_stream_, jobAt(position), *column_layout_);
+}
 
-        try {
-            std::stringstream line_ss(line);
-            std::vector<std::string> values;
-            std::string value;
-            while (std::getline(line_ss, value, ',')) {
-                values.push_back(value);
-            }
+void SystemSnapshotStream::prefetch(std::size_t position, int direction) {
+    if (!decode_pool_) return;
 
-            if (values.size() <= max_idx) {
-                ENKAS_LOG_ERROR(
-                    "Malformed row in snapshot at timestamp {}: not enough columns. Line: {}",
-                    timestamp,
-                    line);
-                return std::nullopt;
-            }
+    if (direction != prefetch_direction_) {
+        cancelPrefetch();
+        prefetch_direction_ = direction;
+    }
 
-            system.positions.emplace_back(std::stod(values[pos_x_idx]),
-                                          std::stod(values[pos_y_idx]),
-                                          std::stod(values[pos_z_idx]));
-            system.velocities.emplace_back(std::stod(values[vel_x_idx]),
-                                           std::stod(values[vel_y_idx]),
-                                           std::stod(values[vel_z_idx]));
-            system.masses.push_back(std::stod(values[mass_idx]));
+    // Keep every decoder busy with a second job queued behind the current one, as far as the
+    // memory for the decoded snapshots allows.
+    const std::size_t depth = std::min(2 * decode_pool_->threadCount(), max_prefetch_count_);
+    for (std::size_t step = 1; step <= depth; ++step) {
+        if (direction > 0 && position + step >= index_.size()) break;
+        if (direction < 0 && step > position) break;
 
-        } catch (const std::invalid_argument& e) {
-            ENKAS_LOG_ERROR("Error parsing value in snapshot at timestamp {}: {}. Line: {}",
-                            timestamp,
-                            e.what(),
-                            line);
-            return std::nullopt;
-        } catch (const std::out_of_range& e) {
-            ENKAS_LOG_ERROR("Value out of range in snapshot at timestamp {}: {}. Line: {}",
-                            timestamp,
-                            e.what(),
-                            line);
-            return std::nullopt;
-        }
+        const std::size_t target = direction > 0 ? position + step : position - step;
+        if (in_flight_.contains(target) || cache_.contains(target)) continue;
+
+        in_flight_.emplace(target, decode_pool_->submit(jobAt(target)));
     }
+}
+
+void SystemSnapshotStream::cancelPrefetch() {
+    if (decode_pool_) decode_pool_->cancelPending();
+    in_flight_.clear();
+}
 
-    return SystemSnapshot{std::move(system), timestamp};
+SnapshotDecodeJob SystemSnapshotStream::jobAt(std::size_t position) const {
+    const auto& entry = index_[position];
+    return {entry.file_offset, entry.row_count, entry.timestamp};
 }
 
 void SystemSnapshotStream::retreatIndexIterator() {
-    if (!is_initialized_ || index_.empty() || current_index_iterator_ == index_.begin()) {
-        current_index_iterator_ = index_.end();
+    if (!is_initialized_ || index_.empty() || current_position_ == 0) {
+        current_position_ = kBeforeFirst;
         return;
     }
 
-    if (current_index_iterator_ == index_.end()) {
-        current_index_iterator_ = std::prev(index_.end());
+    if (current_position_ == kBeforeFirst) {
+        current_position_ = index_.size() - 1;
     } else {
-        --current_index_iterator_;
+        --current_position_;
     }
 }
@@ -2,28 +2,49 @@
 
 #include <enkas/data/system.h>
 
+#include <cstddef>
 #include <filesystem>
 #include <fstream>
 #include <map>
+#include <memory>
 #include <optional>
 #include <vector>
 
+#include "core/dataflow/lru_cache.h"
 #include "core/dataflow/snapshot.h"
+#include "core/files/snapshot_decode_pool.h"
 
 /**
  * @brief An efficient provider for reading SystemSnapshots from a large CSV file.
  *
  * This class performs a one-time indexing pass on the file to enable fast,
- * random-access retrieval of snapshots by timestamp. It is NOT thread-safe and
- * is designed to be owned and operated by a single worker thread.
+ * random-access retrieval of snapshots by timestamp. The resulting index is persisted next to the
+ * CSV file (see file_names::index_suffix) and reused as long as the CSV file is unchanged, so
+ * reopening a large file does not require another full scan. Lookups by fraction are O(1) and
+ * recently decoded snapshots are kept in an LRU cache, so scrubbing back and forth does not
+ * re-parse the same region of the file. Optionally, a SnapshotDecodePool decodes the snapshots
+ * ahead of the read direction in parallel while the caller decodes the requested one. The public
+ * interface is NOT thread-safe and is designed to be owned and operated by a single worker thread.
  */
 class SystemSnapshotStream {
 public:
+    // Lets the decode pool keep every decoder busy, whatever the size of the snapshots.
+    static constexpr std::size_t kUnlimitedPrefetch = static_cast<std::size_t>(-1);
+
     /**
      * @brief Constructs a provider for the given file path.
+     * @param file_path The path to the system CSV file.
+     * @param cache_capacity The number of decoded snapshots kept in the LRU cache.
+     * @param decode_thread_count The number of threads decoding snapshots ahead of the reader.
+     * Zero decodes everything on the calling thread.
+     * @param max_prefetch_count The most snapshots decoded ahead of the reader at once. Each one
+     * is held in memory until it is read, so large systems should prefetch fewer.
      * @note The file is not opened or indexed until initialize() is called.
      */
-    explicit SystemSnapshotStream(std::filesystem::path file_path);
+    explicit SystemSnapshotStream(std::filesystem::path file_path,
+                                  std::size_t cache_capacity = 32,
+                                  std::size_t decode_thread_count = 0,
+                                  std::size_t max_prefetch_count = kUnlimitedPrefetch);
     ~SystemSnapshotStream();
 
     // Disable copy/move to ensure single ownership of the file handle.
@@ -60,6 +81,22 @@ public:
      */
     std::optional<SystemSnapshot> getSnapshotAtFraction(double mu);
 
+    /**
+     * @brief Returns the timestamp of the snapshot that getSnapshotAtFraction(mu) would return.
+     * Does not move the read position or decode anything.
+     * @param mu The target fraction (0.0 to 1.0).
+     * @return The timestamp, or std::nullopt if none is found.
+     */
+    std::optional<double> getTimestampAtFraction(double mu) const;
+
+    /**
+     * @brief Moves the read position so that the next call to getNextSnapshot() returns the
+     * snapshot following the one at @p timestamp.
+     * @param timestamp The timestamp of an indexed snapshot.
+     * @return True if a snapshot with exactly this timestamp exists.
+     */
+    bool seekTo(double timestamp);
+
     /**
      * @brief Retrieves the snapshot immediately following the last one that was read.
      * @return The next snapshot, or std::nullopt if at the end.
@@ -85,13 +122,27 @@ public:
      */
     std::vector<double> getAllTimestamps() const;
 
+    /**
+     * @brief Returns the number of snapshots found in the file.
+     */
+    std::size_t getSnapshotCount() const { return is_initialized_ ? index_.size() : 0; }
+
+    /**
+     * @brief Returns the timestamp of the last snapshot in the file.
+     * @return The last timestamp, or std::nullopt if the file contains no snapshots.
+     */
+    std::optional<double> getLastTimestamp() const;
+
     /**
      * @brief Retreats the current index iterator by one position.
      */
     void retreatIndexIterator();
 
 private:
+    static constexpr std::size_t kBeforeFirst = static_cast<std::size_t>(-1);
+
     struct SnapshotIndexEntry {
+        double timestamp;            // Simulation time of the snapshot
         std::streampos file_offset;  // Byte offset where the first row of the snapshot starts
         int row_count;               // Number of rows (particles) in this snapshot
     };
@@ -103,13 +154,55 @@ private:
     bool buildIndex();
 
     /**
-     * @brief Parses a single snapshot given its index entry.
-     * @param entry The index entry describing where to find the snapshot data.
-     * @param timestamp The timestamp for this snapshot.
-     * @return The parsed snapshot.
+     * @brief Loads the persisted index if it exists and matches the current CSV file.
+     * @return True if the index was loaded, false if it is missing or stale.
+     */
+    bool loadPersistedIndex();
+
+    /**
+     * @brief Writes the current index next to the CSV file. Failures are logged but not fatal.
+     */
+    void persistIndex() const;
+
+    /**
+     * @brief Returns the path of the persisted index file for this CSV file.
      */
-    std::optional<SystemSnapshot> parseSnapshotFromIndex(const SnapshotIndexEntry& entry,
-                                                         double timestamp);
+    std::filesystem::path indexFilePath() const;
+
+    /**
+     * @brief Finds the position of the first snapshot whose timestamp is not less than
+     * @p timestamp. Starts from an interpolated guess, which is O(1) for evenly spaced snapshots.
+     * @return The position in index_, or index_.size() if there is none.
+     */
+    std::size_t lowerBound(double timestamp) const;
+
+    /**
+     * @brief Returns the snapshot at the given index position, using the cache if possible.
+     * @param position The position in index_.
+     * @param direction The read direction (+1 forward, -1 backward) used for prefetching.
+     * @return The snapshot, or std::nullopt if it could not be parsed.
+     */
+    std::optional<SystemSnapshot> snapshotAt(std::size_t position, int direction);
+
+    /**
+     * @brief Decodes the snapshot at the given position, taking a prefetched result if available.
+     */
+    std::optional<SystemSnapshot> decodeAt(std::size_t position);
+
+    /**
+     * @brief Queues the snapshots following @p position in @p direction on the decode pool.
+     */
+    void prefetch(std::size_t position, int direction);
+
+    /**
+     * @brief Cancels all prefetches, e.g. after a seek or a change of direction.
+     */
+    void cancelPrefetch();
+
+    /**
+     * @brief Returns the decode job describing the snapshot at the given position.
+     */
+    SnapshotDecodeJob jobAt(std::size_t position) const;
 
     std::filesystem::path file_path_;
     std::ifstream file_stream_;
@@ -119,6 +212,17 @@ private:
     // It's populated once during buildIndex() for fast lookups later.
     std::map<std::string, size_t> column_indices_;
 
-    std::map<double, SnapshotIndexEntry> index_;
-    std::map<double, SnapshotIndexEntry>::const_iterator current_index_iterator_;
+    // Index entries sorted by timestamp.
+    std::vector<SnapshotIndexEntry> index_;
+    std::size_t current_position_ = kBeforeFirst;
+
+    LruCache<std::size_t, Snapshot<enkas::data::System>> cache_;
+
+    // Parallel decoding of the snapshots ahead of the reader.
+    std::size_t decode_thread_count_;
+    std::size_t max_prefetch_count_;
+    std::optional<SnapshotColumnLayout> column_layout_;
+    std::unique_ptr<SnapshotDecodePool> decode_pool_;
+    std::map<std::size_t, SnapshotDecodePool::Result> in_flight_;
+    int prefetch_direction_ = 0;
 };
@@ -80,6 +80,17 @@ enum class SettingKey {
     BarnesHutLeapfrogTimeStep,
     BarnesHutLeapfrogThetaMac,
     BarnesHutLeapfrogSoftening,
+    BarnesHutLeapfrogReorderInterval,
+    // Symplectic
+    SymplecticTimeStep,
+    SymplecticSoftening,
+    SymplecticCoefficients,
+    // Barnes-Hut Symplectic
+    BarnesHutSymplecticTimeStep,
+    BarnesHutSymplecticThetaMac,
+    BarnesHutSymplecticSoftening,
+    BarnesHutSymplecticCoefficients,
+    BarnesHutSymplecticReorderInterval,
 };
 
 constexpr auto SettingKeyStrings = std::to_array<std::pair<SettingKey, std::string_view>>(
@@ -154,7 +165,18 @@ constexpr auto SettingKeyStrings = std::to_array<std::pair<SettingKey, std::stri
      // Barnes-Hut Leapfrog
      {SettingKey::BarnesHutLeapfrogTimeStep, "BarnesHutLeapfrogTimeStep"},
      {SettingKey::BarnesHutLeapfrogThetaMac, "BarnesHutLeapfrogThetaMac"},
-     {SettingKey::BarnesHutLeapfrogSoftening, "BarnesHutLeapfrogSoftening"}});
+     {SettingKey::BarnesHutLeapfrogSoftening, "BarnesHutLeapfrogSoftening"},
+     {SettingKey::BarnesHutLeapfrogReorderInterval, "BarnesHutLeapfrogReorderInterval"},
+     // Symplectic
+     {SettingKey::SymplecticTimeStep, "SymplecticTimeStep"},
+     {SettingKey::SymplecticSoftening, "SymplecticSoftening"},
+     {SettingKey::SymplecticCoefficients, "SymplecticCoefficients"},
+     // Barnes-Hut Symplectic
+     {SettingKey::BarnesHutSymplecticTimeStep, "BarnesHutSymplecticTimeStep"},
+     {SettingKey::BarnesHutSymplecticThetaMac, "BarnesHutSymplecticThetaMac"},
+     {SettingKey::BarnesHutSymplecticSoftening, "BarnesHutSymplecticSoftening"},
+     {SettingKey::BarnesHutSymplecticCoefficients, "BarnesHutSymplecticCoefficients"},
+     {SettingKey::BarnesHutSymplecticReorderInterval, "BarnesHutSymplecticReorderInterval"}});
 
 [[nodiscard]] constexpr SettingKey stringToSettingKey(std::string_view s) {
     for (auto&& [key, val] : SettingKeyStrings) {
@@ -5,7 +5,15 @@
 #include <string>
 #include <string_view>
 
-enum class SimulationMethod { Euler, Leapfrog, Hermite, Hits, BarnesHutLeapfrog };
+enum class SimulationMethod {
+    Euler,
+    Leapfrog,
+    Hermite,
+    Hits,
+    BarnesHutLeapfrog,
+    Symplectic,
+    BarnesHutSymplectic,
+};
 
 constexpr auto SimulationMethodStrings =
     std::to_array<std::pair<SimulationMethod, std::string_view>>(
@@ -13,7 +21,9 @@ constexpr auto SimulationMethodStrings =
          {SimulationMethod::Leapfrog, "Leapfrog"},
          {SimulationMethod::Hermite, "Hermite"},
          {SimulationMethod::Hits, "Hits"},
-         {SimulationMethod::BarnesHutLeapfrog, "BarnesHutLeapfrog"}});
+         {SimulationMethod::BarnesHutLeapfrog, "BarnesHutLeapfrog"},
+         {SimulationMethod::Symplectic, "Symplectic"},
+         {SimulationMethod::BarnesHutSymplectic, "BarnesHutSymplectic"}});
 
 [[nodiscard]] constexpr SimulationMethod stringToSimulationMethod(std::string_view s) {
     for (auto&& [key, val] : SimulationMethodStrings) {
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <enkas/simulation/settings/symplectic_settings.h>
+
+#include <array>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+using SplittingCoefficients = enkas::simulation::SplittingCoefficients;
+
+constexpr auto SplittingCoefficientsStrings =
+    std::to_array<std::pair<SplittingCoefficients, std::string_view>>(
+        {{SplittingCoefficients::Yoshida, "Yoshida"},
+         {SplittingCoefficients::ForestRuth, "ForestRuth"},
+         {SplittingCoefficients::PEFRL, "PEFRL"}});
+
+[[nodiscard]] constexpr SplittingCoefficients stringToSplittingCoefficients(std::string_view s) {
+    for (auto&& [key, val] : SplittingCoefficientsStrings) {
+        if (val == s) return key;
+    }
+    throw std::out_of_range("Unknown SplittingCoefficients: \"" + std::string(s) + "\"");
+}
+
+[[nodiscard]] constexpr std::string_view splittingCoefficientsToString(
+    SplittingCoefficients coefficients) {
+    for (auto&& [key, val] : SplittingCoefficientsStrings) {
+        if (key == coefficients) return val;
+    }
+    throw std::out_of_range("Unhandled SplittingCoefficients enum value");
+}
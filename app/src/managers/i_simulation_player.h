@@ -17,6 +17,7 @@ public:
         std::filesystem::path file_path = "";
         double simulation_duration = 0.0;
         std::size_t total_snapshots_count = 0;
+        std::size_t particle_count = 0;
     };
 
     /**
@@ -4,6 +4,7 @@
 
 #include <QObject>
 #include <QTimer>
+#include <algorithm>
 #include <filesystem>
 #include <memory>
 
@@ -16,19 +17,96 @@
 
 namespace {
 // --- Buffer Constants ---
-constexpr size_t kSystemRingBufferCapacity = 512;
+constexpr size_t kSystemBufferByteBudget = 256 * 1024 * 1024;
+// Enough for the two snapshots around the replay time and a few on either side of them.
+constexpr size_t kMinSystemRingBufferCapacity = 4;
+constexpr size_t kMaxSystemRingBufferCapacity = 8192;
 constexpr size_t kSystemRingBufferRetainCount = 8;
 
+// --- Snapshot Cache Constants ---
+constexpr size_t kSnapshotCacheByteBudget = 64 * 1024 * 1024;
+constexpr size_t kMinSnapshotCacheCapacity = 2;
+constexpr size_t kMaxSnapshotCacheCapacity = 32;
+
+// --- Prefetch Constants ---
+constexpr size_t kPrefetchByteBudget = 64 * 1024 * 1024;
+constexpr size_t kMinPrefetchCount = 1;
+
+// --- Read-Ahead Constants ---
+constexpr double kReadAheadSeconds = 4.0;
+constexpr size_t kMinReadAhead = 4;
+
 // --- Refresh rates ---
 constexpr int kBufferUpdateIntervalMs = 200;
+constexpr int kInterpolationFrameIntervalMs = 16;
 constexpr int kDefaultStepsPerSecond = 30;
+
+/**
+ * @brief Estimates the memory footprint of a single decoded system snapshot.
+ */
+size_t estimateSnapshotBytes(size_t particle_count) {
+    const size_t bytes_per_particle = 2 * sizeof(enkas::math::Vector3D) + sizeof(double);
+    return sizeof(Snapshot<enkas::data::System>) + sizeof(enkas::data::System) +
+           particle_count * bytes_per_particle;
+}
+
+/**
+ * @brief Chooses the ring buffer capacity so that a full buffer stays within the byte budget.
+ * Systems too large for the budget still get the minimum capacity, which is logged.
+ */
+size_t ringBufferCapacityFor(size_t particle_count, size_t total_snapshots_count) {
+    const size_t snapshot_bytes = estimateSnapshotBytes(particle_count);
+    size_t capacity = kSystemBufferByteBudget / snapshot_bytes;
+    if (total_snapshots_count > 0) capacity = std::min(capacity, total_snapshots_count);
+    capacity = std::clamp(capacity, kMinSystemRingBufferCapacity, kMaxSystemRingBufferCapacity);
+
+    if (capacity * snapshot_bytes > kSystemBufferByteBudget) {
+        ENKAS_LOG_WARNING("The system buffer needs {} bytes for {} snapshots, which exceeds its "
+                          "budget of {} bytes.",
+                          capacity * snapshot_bytes,
+                          capacity,
+                          kSystemBufferByteBudget);
+    }
+    return capacity;
+}
+
+/**
+ * @brief Chooses how many snapshots the ring buffer keeps behind the read position, leaving at
+ * least half of a small buffer for the snapshots ahead of it.
+ */
+size_t ringBufferRetainCountFor(size_t capacity) {
+    return std::min(kSystemRingBufferRetainCount, capacity / 2);
+}
+
+/**
+ * @brief Chooses the capacity of the decoded snapshot cache, which comes on top of the ring
+ * buffer, so that a full cache stays within its own byte budget.
+ */
+size_t snapshotCacheCapacityFor(size_t particle_count) {
+    const size_t capacity = kSnapshotCacheByteBudget / estimateSnapshotBytes(particle_count);
+    return std::clamp(capacity, kMinSnapshotCacheCapacity, kMaxSnapshotCacheCapacity);
+}
+
+/**
+ * @brief Chooses how many snapshots may be decoded ahead of the reader at once, so that the
+ * prefetched snapshots stay within their own byte budget.
+ */
+size_t prefetchCountFor(size_t particle_count) {
+    return std::max(kPrefetchByteBudget / estimateSnapshotBytes(particle_count), kMinPrefetchCount);
+}
 }  // namespace
 
 SimulationPlayer::SimulationPlayer(QObject* parent)
     : ISimulationPlayer(parent),
       rendering_snapshot_(std::make_shared<LatestValueSlot<SystemSnapshot>>()),
+      interpolation_stage_(std::make_unique<InterpolationStage>(rendering_snapshot_)),
       buffer_value_update_timer_(new QTimer(this)),
-      step_delay_ms_(1000 / kDefaultStepsPerSecond) {
+      interpolation_timer_(new QTimer(this)),
+      step_delay_ms_(1000 / kDefaultStepsPerSecond),
+      steps_per_second_(kDefaultStepsPerSecond) {
+    interpolation_timer_->setTimerType(Qt::PreciseTimer);
+    connect(interpolation_timer_, &QTimer::timeout, this, &SimulationPlayer::onInterpolationFrame);
+
     connect(buffer_value_update_timer_, &QTimer::timeout, this, [this]() {
         if (system_ring_buffer_ && total_snapshots_count_ > 0) {
             const int buffer_size = system_ring_buffer_->size();
@@ -67,10 +145,13 @@ void SimulationPlayer::run(std::optional<ISimulationPlayer::SystemData> system_d
 
     if (has_system_data) {
         // Setup system buffer worker
-        system_ring_buffer_ = std::make_shared<SystemRingBuffer>(kSystemRingBufferCapacity,
-                                                                 kSystemRingBufferRetainCount);
+        const size_t capacity = ringBufferCapacityFor(system_data->particle_count,
+                                                      system_data->total_snapshots_count);
+        system_ring_buffer_ =
+            std::make_shared<SystemRingBuffer>(capacity, ringBufferRetainCountFor(capacity));
         system_file_path_ = system_data->file_path;
-        setupSystemBufferWorker();
+        setupSystemBufferWorker(system_data->particle_count);
+        updateReadAhead();
 
         // Update buffer value regularly
         total_snapshots_count_ = system_data->total_snapshots_count;
@@ -81,8 +162,11 @@ void SimulationPlayer::run(std::optional<ISimulationPlayer::SystemData> system_d
     setupDataUpdateTimer();
 }
 
-void SimulationPlayer::setupSystemBufferWorker() {
-    system_buffer_worker_ = new SystemBufferWorker(system_ring_buffer_, system_file_path_);
+void SimulationPlayer::setupSystemBufferWorker(size_t particle_count) {
+    system_buffer_worker_ = new SystemBufferWorker(system_ring_buffer_,
+                                                   system_file_path_,
+                                                   snapshotCacheCapacityFor(particle_count),
+                                                   prefetchCountFor(particle_count));
     system_buffer_thread_ = new QThread(this);
     system_buffer_worker_->moveToThread(system_buffer_thread_);
 
@@ -97,6 +181,40 @@ void SimulationPlayer::setupSystemBufferWorker() {
                    system_file_path_.string());
 }
 
+void SimulationPlayer::setStepsPerSecond(int steps_per_second) {
+    steps_per_second_ = steps_per_second;
+    step_delay_ms_ = 1000 / steps_per_second;
+    updateReadAhead();
+}
+
+void SimulationPlayer::setInterpolationEnabled(bool enabled) {
+    if (interpolation_enabled_ == enabled) return;
+    interpolation_enabled_ = enabled;
+
+    if (!is_playing_) return;
+
+    // Hand playback over to the other timing mechanism.
+    if (interpolation_enabled_) {
+        resetInterpolation(interpolation_from_);
+        interpolation_timer_->start(kInterpolationFrameIntervalMs);
+    } else {
+        interpolation_timer_->stop();
+        onStepForward();
+    }
+}
+
+void SimulationPlayer::updateReadAhead() {
+    if (!system_buffer_worker_ || !system_ring_buffer_) return;
+
+    // Keep a few seconds of playback buffered, but never more than the byte budget allows.
+    const size_t steps_per_second = 1000 / std::max(step_delay_ms_, 1);
+    const size_t capacity = system_ring_buffer_->capacity();
+    const size_t max_read_ahead = capacity - ringBufferRetainCountFor(capacity);
+    const auto read_ahead = static_cast<size_t>(steps_per_second * kReadAheadSeconds);
+    system_buffer_worker_->setReadAhead(
+        std::min(std::max(read_ahead, kMinReadAhead), max_read_ahead));
+}
+
 void SimulationPlayer::setupDataUpdateTimer() {
     onTogglePlayback();  // Start playback immediately
 }
@@ -104,7 +222,12 @@ void SimulationPlayer::setupDataUpdateTimer() {
 void SimulationPlayer::onTogglePlayback() {
     is_playing_ = !is_playing_;
 
-    if (is_playing_) {
+    if (!is_playing_) {
+        interpolation_timer_->stop();
+    } else if (interpolation_enabled_) {
+        resetInterpolation(interpolation_from_);
+        interpolation_timer_->start(kInterpolationFrameIntervalMs);
+    } else {
         onStepForward();
     }
 }
@@ -119,8 +242,12 @@ void SimulationPlayer::setupSimulationWindow(
     connect(w, &ReplaySimulationWindow::windowClosed, this, [this]() { emit windowClosed(); });
     connect(w, &ReplaySimulationWindow::requestJump, this, &SimulationPlayer::onJump);
     connect(w, &ReplaySimulationWindow::stepsPerSecondChanged, this, [this](int sps) {
-        step_delay_ms_ = 1000 / sps;
+        setStepsPerSecond(sps);
     });
+    connect(w,
+            &ReplaySimulationWindow::interpolationToggled,
+            this,
+            &SimulationPlayer::setInterpolationEnabled);
 
     simulation_window_presenter_ =
         new ReplaySimulationWindowPresenter(w, rendering_snapshot_, simulation_duration, this);
@@ -128,16 +255,18 @@ void SimulationPlayer::setupSimulationWindow(
 
 void SimulationPlayer::onStepForward() {
     if (auto system_snapshot = system_ring_buffer_->readForward()) {
+        resetInterpolation(*system_snapshot);
         rendering_snapshot_->set(*system_snapshot);
     }
 
-    if (is_playing_) {
+    if (is_playing_ && !interpolation_enabled_) {
         QTimer::singleShot(step_delay_ms_, this, &SimulationPlayer::onStepForward);
     }
 }
 
 void SimulationPlayer::onStepBackward() {
     if (auto system_snapshot = system_ring_buffer_->readBackward()) {
+        resetInterpolation(*system_snapshot);
         rendering_snapshot_->set(*system_snapshot);
     }
 
@@ -147,7 +276,50 @@ void SimulationPlayer::onStepBackward() {
 }
 
 void SimulationPlayer::onJump(float fraction) {
+    resetInterpolation();
+
     if (system_buffer_worker_) {
         system_buffer_worker_->requestJump(fraction);
     }
 }
+
+void SimulationPlayer::resetInterpolation(SystemSnapshotPtr current) {
+    // Hands the rendering slot back to the GUI thread.
+    interpolation_stage_->clear();
+    interpolation_from_ = std::move(current);
+    interpolation_progress_ = 0.0;
+    last_interpolation_frame_ = std::chrono::steady_clock::now();
+}
+
+void SimulationPlayer::onInterpolationFrame() {
+    if (!system_ring_buffer_) return;
+
+    const auto now = std::chrono::steady_clock::now();
+    const double elapsed_s = std::chrono::duration<double>(now - last_interpolation_frame_).count();
+    last_interpolation_frame_ = now;
+
+    if (!interpolation_from_) {
+        auto first = system_ring_buffer_->readForward();
+        if (!first) return;
+        resetInterpolation(*first);
+        interpolation_stage_->submit(interpolation_from_);
+        return;
+    }
+
+    // Advance through as many stored snapshots as the playback speed demands.
+    interpolation_progress_ += elapsed_s * steps_per_second_;
+    while (interpolation_progress_ >= 1.0) {
+        auto next = system_ring_buffer_->readForward();
+        if (!next) {
+            // The buffer ran dry, hold the current snapshot until it catches up.
+            interpolation_progress_ = 0.0;
+            break;
+        }
+        interpolation_from_ = *next;
+        interpolation_progress_ -= 1.0;
+    }
+
+    // The frame itself is interpolated on the stage's thread.
+    auto to = system_ring_buffer_->peekForward();
+    interpolation_stage_->submit(interpolation_from_, to ? *to : nullptr, interpolation_progress_);
+}
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <QObject>
+#include <chrono>
+#include <cstddef>
 #include <filesystem>
 #include <memory>
 
@@ -10,6 +12,7 @@
 #include "i_simulation_player.h"
 #include "managers/i_simulation_player.h"
 #include "presenters/simulation_window/replay/replay_simulation_window_presenter.h"
+#include "rendering/interpolation_stage.h"
 #include "views/simulation_window/replay/replay_simulation_window.h"
 #include "workers/system_buffer_worker.h"
 
@@ -27,7 +30,14 @@ public:
      * @brief Sets the playback speed in steps per second.
      * @param steps_per_second The desired steps per second.
      */
-    void setStepsPerSecond(int steps_per_second) { step_delay_ms_ = 1000 / steps_per_second; }
+    void setStepsPerSecond(int steps_per_second);
+
+    /**
+     * @brief Switches interpolated playback on or off. When enabled, frames between stored
+     * snapshots are synthesized with cubic Hermite interpolation at the display rate.
+     * @param enabled True to interpolate, false to show stored snapshots only.
+     */
+    void setInterpolationEnabled(bool enabled);
 
     void run(std::optional<ISimulationPlayer::SystemData> system_data,
              std::optional<ISimulationPlayer::DiagnosticsData> diagnostics_data) override;
@@ -54,20 +64,32 @@ public:
     void onJump(float fraction);
 
 private:
-    void setupSystemBufferWorker();
+    void setupSystemBufferWorker(size_t particle_count);
     void setupDataUpdateTimer();
+    void updateReadAhead();
+    void onInterpolationFrame();
+    void resetInterpolation(SystemSnapshotPtr current = nullptr);
     void setupSimulationWindow(double simulation_duration,
                                const std::shared_ptr<DiagnosticsSeries>& diagnostics_series);
 
     ReplaySimulationWindow* simulation_window_ = nullptr;
     ReplaySimulationWindowPresenter* simulation_window_presenter_ = nullptr;
 
-    SystemBufferWorker* system_buffer_worker_;
-    QThread* system_buffer_thread_;
+    SystemBufferWorker* system_buffer_worker_ = nullptr;
+    QThread* system_buffer_thread_ = nullptr;
 
     bool is_playing_ = false;
     std::shared_ptr<LatestValueSlot<SystemSnapshot>> rendering_snapshot_;
+    std::unique_ptr<InterpolationStage> interpolation_stage_;  // Publishes interpolated frames
     int step_delay_ms_;
+    int steps_per_second_;
+
+    // Interpolated playback
+    bool interpolation_enabled_ = false;
+    QTimer* interpolation_timer_ = nullptr;
+    SystemSnapshotPtr interpolation_from_ = nullptr;
+    double interpolation_progress_ = 0.0;  // Fraction of the way to the next snapshot
+    std::chrono::steady_clock::time_point last_interpolation_frame_;
 
     std::shared_ptr<SystemRingBuffer> system_ring_buffer_ = nullptr;
     std::filesystem::path system_file_path_ = "";
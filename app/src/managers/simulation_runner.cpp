@@ -3,17 +3,23 @@
 #include <enkas/generation/generator.h>
 #include <enkas/logging/logger.h>
 #include <enkas/simulation/simulator.h>
+#include <enkas/tracing/latency_histogram.h>
+#include <enkas/tracing/trace.h>
 
 #include <QElapsedTimer>
 #include <QObject>
 #include <QThread>
+#include <array>
 #include <chrono>
 #include <cstddef>
 #include <filesystem>
 #include <format>
 #include <memory>
+#include <span>
+#include <system_error>
 
 #include "core/dataflow/latest_value_slot.h"
+#include "core/dataflow/output_channel.h"
 #include "core/dataflow/snapshot.h"
 #include "core/files/file_constants.h"
 #include "core/settings/settings.h"
@@ -27,6 +33,15 @@ namespace {
 // --- Pool sizes ---
 constexpr size_t kDefaultPoolSize = 512;
 
+// --- Backpressure ---
+// Live charts may lose points under load, so the simulation never waits on the GUI. Storage stays
+// lossless: snapshots the writers cannot keep up with are spilled to disk and written later.
+constexpr BackpressurePolicy kChartPolicy = BackpressurePolicy::DropOldest;
+constexpr BackpressurePolicy kStoragePolicy = BackpressurePolicy::Spill;
+
+// --- Debug info ---
+constexpr size_t kBytesPerMiB = size_t{1} << 20;
+
 // --- Refresh rates ---
 constexpr int kDebugInfoTimerIntervalMs = 500;
 }  // namespace
@@ -47,6 +62,9 @@ SimulationRunner::SimulationRunner(const Settings& settings, QObject* parent)
     // Create output directory
     setupOutputDir();
 
+    // Start the trace of this run from scratch
+    if constexpr (enkas::tracing::kEnabled) enkas::tracing::clear();
+
     if (save_settings) {
         settings.save(output_dir_ / file_names::settings);
     }
@@ -57,26 +75,31 @@ SimulationRunner::SimulationRunner(const Settings& settings, QObject* parent)
 
     // Populate output queues
     outputs_->rendering_snapshot = std::make_shared<LatestValueSlot<SystemSnapshot>>();
-    outputs_->chart_queue =
-        std::make_shared<BlockingQueue<DiagnosticsSnapshotPtr>>(kDefaultPoolSize);
-    debug_info_->chart_queue_capacity = kDefaultPoolSize;
+    outputs_->chart_queue = std::make_shared<DiagnosticsOutputChannel>(
+        OutputChannelConfig{.capacity = kDefaultPoolSize, .policy = kChartPolicy});
+    debug_info_->chart_queue_capacity = outputs_->chart_queue->capacity();
 
     if (save_system_data_) {
         system_file_writer_ = std::make_unique<CsvFileWriter<SystemSnapshot>>(
             output_dir_ / file_names::system, csv_headers::system);
-        outputs_->system_storage_queue =
-            std::make_shared<BlockingQueue<SystemSnapshotPtr>>(kDefaultPoolSize);
+        outputs_->system_storage_queue = std::make_shared<SystemOutputChannel>(
+            OutputChannelConfig{.capacity = kDefaultPoolSize,
+                                .policy = kStoragePolicy,
+                                .spill_path = output_dir_ / file_names::system_spill});
         setupSystemStorageWorker();
-        debug_info_->system_storage_queue_capacity = kDefaultPoolSize;
+        debug_info_->system_storage_queue_capacity = outputs_->system_storage_queue->capacity();
     }
 
     if (save_diagnostics_data_) {
         diagnostics_file_writer_ = std::make_unique<CsvFileWriter<DiagnosticsSnapshot>>(
             output_dir_ / file_names::diagnostics, csv_headers::diagnostics);
-        outputs_->diagnostics_storage_queue =
-            std::make_shared<BlockingQueue<DiagnosticsSnapshotPtr>>(kDefaultPoolSize);
+        outputs_->diagnostics_storage_queue = std::make_shared<DiagnosticsOutputChannel>(
+            OutputChannelConfig{.capacity = kDefaultPoolSize,
+                                .policy = kStoragePolicy,
+                                .spill_path = output_dir_ / file_names::diagnostics_spill});
         setupDiagnosticsStorageWorker();
-        debug_info_->diagnostics_storage_queue_capacity = kDefaultPoolSize;
+        debug_info_->diagnostics_storage_queue_capacity =
+            outputs_->diagnostics_storage_queue->capacity();
     }
 
     // Simulation Window
@@ -102,7 +125,7 @@ SimulationRunner::~SimulationRunner() {
     ENKAS_LOG_INFO("Simulation runner is being destroyed. Aborting any ongoing processes...");
     aborted_ = true;
 
-    // This presenter runs a worker which relies on memory provided by the simulation runner.
+    // This presenter reads outputs which rely on memory provided by the simulation runner.
     // We must ensure that the presenter is deleted before the runner goes out of scope.
     if (simulation_window_presenter_ != nullptr) {
         simulation_window_presenter_->deleteLater();
@@ -148,9 +171,37 @@ SimulationRunner::~SimulationRunner() {
         ENKAS_LOG_DEBUG("Diagnostics storage worker thread joined.");
     }
 
+    if constexpr (enkas::tracing::kEnabled) {
+        enkas::tracing::writeChromeTrace(output_dir_ / file_names::trace);
+    }
+
+    writeLatencies();
+
     ENKAS_LOG_INFO("Simulation runner destroyed successfully.");
 }
 
+void SimulationRunner::writeLatencies() const {
+    if (!debug_info_ || debug_info_->step_latency.count() == 0) return;
+
+    const std::array<enkas::tracing::NamedLatencyHistogram, 6> histograms = {{
+        {.name = "step", .histogram = &debug_info_->step_latency},
+        {.name = "force_evaluation", .histogram = &debug_info_->force_latency},
+        {.name = "pool_acquire", .histogram = &debug_info_->pool_acquire_latency},
+        {.name = "queue_push", .histogram = &debug_info_->queue_push_latency},
+        {.name = "system_file_write", .histogram = &debug_info_->system_file_write_latency},
+        {.name = "diagnostics_file_write",
+         .histogram = &debug_info_->diagnostics_file_write_latency},
+    }};
+
+    // Only runs that store something have an output directory, and no other run should get one.
+    std::error_code error;
+    if (!std::filesystem::is_directory(output_dir_, error)) return;
+
+    if (enkas::tracing::writeLatencyCsv(output_dir_ / file_names::latencies, histograms)) {
+        ENKAS_LOG_INFO("Stage latencies written to {}.", output_dir_.string());
+    }
+}
+
 void SimulationRunner::openSimulationWindow() {
     if (simulation_window_ == nullptr) {
         ENKAS_LOG_ERROR("Simulation window is not initialized. Cannot open it.");
@@ -190,12 +241,13 @@ void SimulationRunner::setupOutputDir() {
 }
 
 void SimulationRunner::setupSystemStorageWorker() {
-    auto save_function = [this](const SystemSnapshotPtr& snapshot) {
-        system_file_writer_->write(*snapshot);
+    auto save_function = [this](std::span<const SystemSnapshotPtr> snapshots) {
+        const enkas::tracing::ScopedLatency latency(&debug_info_->system_file_write_latency);
+        system_file_writer_->write(snapshots);
     };
 
     system_storage_worker_ =
-        new QueueStorageWorker<SystemSnapshotPtr>(outputs_->system_storage_queue, save_function);
+        new QueueStorageWorker<enkas::data::System>(outputs_->system_storage_queue, save_function);
 
     system_storage_thread_ = new QThread(this);
     system_storage_worker_->moveToThread(system_storage_thread_);
@@ -217,11 +269,13 @@ void SimulationRunner::setupSystemStorageWorker() {
 }
 
 void SimulationRunner::setupDiagnosticsStorageWorker() {
-    auto save_function = [this](const DiagnosticsSnapshotPtr& snapshot) {
-        diagnostics_file_writer_->write(*snapshot);
+    auto save_function = [this](std::span<const DiagnosticsSnapshotPtr> snapshots) {
+        const enkas::tracing::ScopedLatency latency(
+            &debug_info_->diagnostics_file_write_latency);
+        diagnostics_file_writer_->write(snapshots);
     };
 
-    diagnostics_storage_worker_ = new QueueStorageWorker<DiagnosticsSnapshotPtr>(
+    diagnostics_storage_worker_ = new QueueStorageWorker<enkas::data::Diagnostics>(
         outputs_->diagnostics_storage_queue, save_function);
 
     diagnostics_storage_thread_ = new QThread(this);
@@ -291,29 +345,52 @@ void SimulationRunner::updateDebugInfo() {
         return;
     }
 
-    // Update memory pool sizes
-    if (memory_pools_->system_data_pool) {
-        debug_info_->system_data_pool_size = memory_pools_->system_data_pool->size();
-    }
-    if (memory_pools_->diagnostics_data_pool) {
-        debug_info_->diagnostics_data_pool_size = memory_pools_->diagnostics_data_pool->size();
-    }
-    if (memory_pools_->system_snapshot_pool) {
-        debug_info_->system_snapshot_pool_size = memory_pools_->system_snapshot_pool->size();
-    }
-    if (memory_pools_->diagnostics_snapshot_pool) {
-        debug_info_->diagnostics_snapshot_pool_size =
-            memory_pools_->diagnostics_snapshot_pool->size();
-    }
+    // Update memory pool sizes. The pools grow lazily, so their capacities and memory usage are
+    // refreshed here as well.
+    size_t pool_bytes = 0;
+    size_t pool_capacity_bytes = 0;
+    const auto update_pool = [&](const auto& pool, auto& size, size_t& capacity) {
+        if (!pool) return;
+        size = pool->size();
+        capacity = pool->capacity();
+        pool_bytes += pool->allocatedBytes();
+        pool_capacity_bytes += pool->capacityBytes();
+    };
 
-    // Update queue sizes
+    update_pool(memory_pools_->system_data_pool,
+                debug_info_->system_data_pool_size,
+                debug_info_->system_data_pool_capacity);
+    update_pool(memory_pools_->diagnostics_data_pool,
+                debug_info_->diagnostics_data_pool_size,
+                debug_info_->diagnostics_data_pool_capacity);
+    update_pool(memory_pools_->system_snapshot_pool,
+                debug_info_->system_snapshot_pool_size,
+                debug_info_->system_snapshot_pool_capacity);
+    update_pool(memory_pools_->diagnostics_snapshot_pool,
+                debug_info_->diagnostics_snapshot_pool_size,
+                debug_info_->diagnostics_snapshot_pool_capacity);
+
+    debug_info_->pool_memory_mib = pool_bytes / kBytesPerMiB;
+    debug_info_->pool_memory_capacity_mib = pool_capacity_bytes / kBytesPerMiB;
+
+    // Update queue sizes and backpressure counters
     if (outputs_->chart_queue) {
         debug_info_->chart_queue_size = outputs_->chart_queue->size();
+        debug_info_->chart_queue_dropped = outputs_->chart_queue->dropped();
+        debug_info_->chart_queue_offered = outputs_->chart_queue->offered();
     }
     if (outputs_->system_storage_queue) {
-        debug_info_->system_storage_queue_size = outputs_->system_storage_queue->size();
+        const auto& queue = outputs_->system_storage_queue;
+        debug_info_->system_storage_queue_size = queue->size();
+        debug_info_->system_storage_queue_dropped = queue->dropped();
+        debug_info_->system_storage_queue_spilled = queue->spilled();
+        debug_info_->system_storage_queue_offered = queue->offered();
     }
     if (outputs_->diagnostics_storage_queue) {
-        debug_info_->diagnostics_storage_queue_size = outputs_->diagnostics_storage_queue->size();
+        const auto& queue = outputs_->diagnostics_storage_queue;
+        debug_info_->diagnostics_storage_queue_size = queue->size();
+        debug_info_->diagnostics_storage_queue_dropped = queue->dropped();
+        debug_info_->diagnostics_storage_queue_spilled = queue->spilled();
+        debug_info_->diagnostics_storage_queue_offered = queue->offered();
     }
 }
@@ -55,6 +55,7 @@ private:
     void receivedInitializationCompleted();
     void updateDebugInfo();
     void setupOutputDir();
+    void writeLatencies() const;
     void setupSystemStorageWorker();
     void setupDiagnosticsStorageWorker();
     void setupSimulationWorker(const Settings& settings);
@@ -55,21 +55,9 @@ void LoadSimulationPresenter::checkFiles() {
             runner_.run(
                 this,
                 [this, path = file_path.toStdString()]() {
-                    return parser_.parseInitialSystem(path);
+                    return parser_.parseSystemMetadata(path);
                 },
-                [this](const auto& result) { this->onInitialSystemParsed(result); });
-
-            runner_.run(
-                this,
-                [this, path = file_path.toStdString()]() { return parser_.countSnapshots(path); },
-                [this](const auto& result) { this->onSnapshotsCounted(result); });
-
-            runner_.run(
-                this,
-                [this, path = file_path.toStdString()]() {
-                    return parser_.retrieveSimulationDuration(path);
-                },
-                [this](const auto& result) { this->onSimulationDurationRetrieved(result); });
+                [this](const auto& result) { this->onSystemMetadataParsed(result); });
         } else if (file_path.endsWith(file_names::diagnostics)) {
             runner_.run(
                 this,
@@ -85,13 +73,17 @@ void LoadSimulationPresenter::onSettingsParsed(const std::optional<Settings>& se
     view_->onSettingsParsed(settings);
 }
 
-void LoadSimulationPresenter::onInitialSystemParsed(
-    const std::optional<enkas::data::System>& system) {
-    if (system) {
-        view_->onInitialSystemParsed(*system);
-    } else {
+void LoadSimulationPresenter::onSystemMetadataParsed(
+    const std::optional<SystemFileMetadata>& metadata) {
+    if (!metadata) {
         view_->onInitialSystemParsed(std::nullopt);
+        return;
     }
+
+    system_data_.total_snapshots_count = metadata->snapshot_count;
+    system_data_.simulation_duration = metadata->simulation_duration;
+    system_data_.particle_count = metadata->initial_system.count();
+    view_->onInitialSystemParsed(metadata->initial_system);
 }
 
 void LoadSimulationPresenter::onDiagnosticsSeriesParsed(
@@ -103,14 +95,6 @@ void LoadSimulationPresenter::onDiagnosticsSeriesParsed(
     }
 }
 
-void LoadSimulationPresenter::onSnapshotsCounted(const std::optional<int>& count) {
-    if (count) system_data_.total_snapshots_count = *count;
-}
-
-void LoadSimulationPresenter::onSimulationDurationRetrieved(const std::optional<double>& duration) {
-    if (duration) system_data_.simulation_duration = *duration;
-}
-
 void LoadSimulationPresenter::playSimulation() {
     if (system_data_.file_path.empty() && diagnostics_data_.diagnostics_series) {
         ENKAS_LOG_ERROR("No valid simulation data to play.");
@@ -53,10 +53,8 @@ public slots:
 private slots:
     void updateInitialSystemPreview() { view_->updateInitialSystemPreview(); }
     void onSettingsParsed(const std::optional<Settings>& settings);
-    void onInitialSystemParsed(const std::optional<enkas::data::System>& snapshot);
+    void onSystemMetadataParsed(const std::optional<SystemFileMetadata>& metadata);
     void onDiagnosticsSeriesParsed(const std::optional<DiagnosticsSeries>& series);
-    void onSnapshotsCounted(const std::optional<int>& count);
-    void onSimulationDurationRetrieved(const std::optional<double>& duration);
 
 private:
     ILoadSimulationView* view_;
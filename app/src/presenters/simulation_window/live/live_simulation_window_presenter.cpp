@@ -1,13 +1,14 @@
 #include "live_simulation_window_presenter.h"
 
-#include <QThread>
+#include <algorithm>
+#include <utility>
 
 #include "core/dataflow/latest_value_slot.h"
 
 LiveSimulationWindowPresenter::LiveSimulationWindowPresenter(
     ILiveSimulationWindowView* view,
     std::shared_ptr<LatestValueSlot<SystemSnapshot>> rendering_snapshot,
-    std::shared_ptr<BlockingQueue<DiagnosticsSnapshotPtr>> chart_queue,
+    std::shared_ptr<DiagnosticsOutputChannel> chart_queue,
     std::shared_ptr<LiveDebugInfo> debug_info,
     QObject* parent)
     : SimulationWindowPresenter(view, rendering_snapshot, debug_info->duration, parent),
@@ -16,19 +17,11 @@ LiveSimulationWindowPresenter::LiveSimulationWindowPresenter(
       debug_info_timer_(new QTimer(this)),
       debug_info_(debug_info),
       last_debug_info_update_time_(std::chrono::steady_clock::now()) {
-    // Setup chart worker in seperate thread
-    chart_worker_ =
-        new QueueStorageWorker<DiagnosticsSnapshotPtr>(chart_queue_, [this](auto const& snapshot) {
-            QMetaObject::invokeMethod(
-                this,
-                [this, snapshot] { view_->updateDiagnostics(snapshot); },
-                Qt::QueuedConnection);
-        });
-    chart_thread_ = new QThread(this);
-    chart_worker_->moveToThread(chart_thread_);
-    connect(chart_thread_, &QThread::started, chart_worker_, &QueueStorageWorkerBase::run);
-    connect(chart_thread_, &QThread::finished, chart_worker_, &QObject::deleteLater);
-    chart_thread_->start();
+    // Diagnostics are drained from the chart queue on every frame, at most one queue full
+    if (chart_queue_) {
+        chart_batch_.reserve(chart_queue_->capacity());
+        debug_info_->chart_batch_capacity = chart_queue_->capacity();
+    }
 
     // Setup debug info timer
     connect(
@@ -37,12 +30,24 @@ LiveSimulationWindowPresenter::LiveSimulationWindowPresenter(
 }
 
 LiveSimulationWindowPresenter::~LiveSimulationWindowPresenter() {
-    if (chart_worker_) chart_worker_->abort();
+    // Nobody reads the charts anymore, so the simulation can stop queueing diagnostics for them.
+    if (chart_queue_) chart_queue_->close();
+}
 
-    if (chart_thread_ && chart_thread_->isRunning()) {
-        chart_thread_->quit();
-        chart_thread_->wait();
+void LiveSimulationWindowPresenter::onFrame() {
+    if (!chart_queue_) return;
+
+    // Bounded by the capacity, so that a fast simulation cannot keep the GUI thread in this loop.
+    while (chart_batch_.size() < chart_queue_->capacity()) {
+        auto snapshot = chart_queue_->tryPop();
+        if (!snapshot) break;
+        chart_batch_.push_back(std::move(*snapshot));
     }
+    if (chart_batch_.empty()) return;
+
+    largest_chart_batch_ = std::max(largest_chart_batch_, chart_batch_.size());
+    view_->updateDiagnostics(chart_batch_);
+    chart_batch_.clear();  // Hand the snapshots back to their pools
 }
 
 void LiveSimulationWindowPresenter::updateDebugInfo() {
@@ -54,5 +59,6 @@ void LiveSimulationWindowPresenter::updateDebugInfo() {
     const int steps_since_last_update = current_step_count - previous_step_count_;
     previous_step_count_ = current_step_count;
     const int sps = static_cast<int>(steps_since_last_update / elapsed_seconds);
+    debug_info_->chart_batch_size = std::exchange(largest_chart_batch_, 0);
     view_->updateDebugInfo(sps);
 }
@@ -3,15 +3,16 @@
 #include <QObject>
 #include <QTimer>
 #include <chrono>
+#include <cstddef>
 #include <memory>
+#include <vector>
 
-#include "core/dataflow/blocking_queue.h"
 #include "core/dataflow/debug_info.h"
 #include "core/dataflow/latest_value_slot.h"
+#include "core/dataflow/output_channel.h"
 #include "core/dataflow/snapshot.h"
 #include "presenters/simulation_window/simulation_window_presenter.h"
 #include "views/simulation_window/live/i_live_simulation_window_view.h"
-#include "workers/queue_storage_worker.h"
 
 class LiveSimulationWindowPresenter : public SimulationWindowPresenter {
     Q_OBJECT
@@ -19,19 +20,26 @@ public:
     explicit LiveSimulationWindowPresenter(
         ILiveSimulationWindowView* view,
         std::shared_ptr<LatestValueSlot<SystemSnapshot>> rendering_snapshot,
-        std::shared_ptr<BlockingQueue<DiagnosticsSnapshotPtr>> chart_queue,
+        std::shared_ptr<DiagnosticsOutputChannel> chart_queue,
         std::shared_ptr<LiveDebugInfo> debug_info,
         QObject* parent = nullptr);
     ~LiveSimulationWindowPresenter() override;
 
+protected:
+    /**
+     * @brief Drains the chart queue and hands all new diagnostics to the view as one batch, so
+     * the GUI thread handles diagnostics once per frame instead of once per snapshot.
+     */
+    void onFrame() override;
+
 private:
     void updateDebugInfo();
 
     ILiveSimulationWindowView* view_;
 
-    QueueStorageWorkerBase* chart_worker_ = nullptr;
-    QThread* chart_thread_ = nullptr;
-    std::shared_ptr<BlockingQueue<DiagnosticsSnapshotPtr>> chart_queue_;
+    std::shared_ptr<DiagnosticsOutputChannel> chart_queue_;
+    std::vector<DiagnosticsSnapshotPtr> chart_batch_;  // Reused between frames
+    size_t largest_chart_batch_ = 0;                   // Since the last debug info update
 
     QTimer* debug_info_timer_;
     std::shared_ptr<LiveDebugInfo> debug_info_;
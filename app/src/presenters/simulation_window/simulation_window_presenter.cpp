@@ -34,6 +34,8 @@ void SimulationWindowPresenter::updateRendering() {
         return;
     }
 
+    onFrame();
+
     // If the rendering is faster than the simulation, we do not want to drop frames, but instead
     // pass the nullptr to the view, which must handle it properly.
     auto system_snapshot = rendering_snapshot_->take();
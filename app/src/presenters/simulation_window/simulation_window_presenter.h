@@ -30,6 +30,13 @@ public:
      */
     void onFpsChanged() { render_timer_->setInterval(1000 / view_->getTargetFPS()); }
 
+protected:
+    /**
+     * @brief Called on every rendered frame, before the system is rendered. Subclasses can use it
+     * to hand other data to the view at the frame rate.
+     */
+    virtual void onFrame() {}
+
 private:
     ISimulationWindowView* view_;
 
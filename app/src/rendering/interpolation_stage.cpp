@@ -0,0 +1,92 @@
+#include "rendering/interpolation_stage.h"
+
+#include <enkas/data/system.h>
+#include <enkas/physics/interpolation.h>
+#include <enkas/tracing/trace.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "core/dataflow/snapshot.h"
+
+InterpolationStage::InterpolationStage(std::shared_ptr<LatestValueSlot<SystemSnapshot>> output)
+    : output_(std::move(output)), thread_(&InterpolationStage::interpolateLoop, this) {}
+
+InterpolationStage::~InterpolationStage() {
+    {
+        std::scoped_lock lock(mtx_);
+        is_shutting_down_ = true;
+    }
+    cond_input_.notify_one();
+    thread_.join();
+}
+
+void InterpolationStage::submit(SystemSnapshotPtr from, SystemSnapshotPtr to, double progress) {
+    if (!from) return;
+
+    {
+        std::scoped_lock lock(mtx_);
+        input_from_ = std::move(from);
+        input_to_ = std::move(to);
+        input_progress_ = progress;
+        ++input_sequence_;
+    }
+    cond_input_.notify_one();
+}
+
+void InterpolationStage::clear() {
+    std::scoped_lock lock(mtx_);
+    input_from_.reset();
+    input_to_.reset();
+    cleared_sequence_ = input_sequence_;
+}
+
+void InterpolationStage::interpolateLoop() {
+    ENKAS_TRACE_THREAD_NAME("Replay Interpolation");
+    while (true) {
+        SystemSnapshotPtr from;
+        SystemSnapshotPtr to;
+        double progress;
+        uint64_t sequence;
+        {
+            std::unique_lock lock(mtx_);
+            cond_input_.wait(lock, [this] { return input_from_ || is_shutting_down_; });
+            if (is_shutting_down_) return;
+            from = std::move(input_from_);
+            to = std::move(input_to_);
+            progress = input_progress_;
+            sequence = input_sequence_;
+        }
+
+        SystemSnapshotPtr frame = from;
+        if (to && progress > 0.0 && from->data && to->data) {
+            ENKAS_TRACE_SCOPE("Interpolate Frame");
+            auto system = acquireFrame();
+            const double dt = to->time - from->time;
+            enkas::physics::interpolateHermite(*from->data, *to->data, dt, progress, *system);
+            frame = std::make_shared<SystemSnapshot>(std::move(system), from->time + progress * dt);
+        }
+
+        // Published under the lock, so that no frame lands in the slot after clear() returned.
+        std::scoped_lock lock(mtx_);
+        if (sequence > cleared_sequence_) output_->set(std::move(frame));
+    }
+}
+
+std::shared_ptr<enkas::data::System> InterpolationStage::acquireFrame() {
+    for (const auto& frame : frames_) {
+        if (frame.use_count() == 1) {
+            // Pairs with the release of the last other owner, whose reads must finish before the
+            // frame is overwritten.
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return frame;
+        }
+    }
+
+    auto frame = std::make_shared<enkas::data::System>();
+    if (frames_.size() < kMaxFrames) frames_.push_back(frame);
+    return frame;
+}
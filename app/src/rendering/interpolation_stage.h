@@ -0,0 +1,81 @@
+#pragma once
+
+#include <enkas/data/system.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "core/dataflow/latest_value_slot.h"
+#include "core/dataflow/snapshot.h"
+
+/**
+ * @brief Synthesizes interpolated replay frames on a background thread.
+ *
+ * The GUI thread submits the two stored snapshots around the replay time and the progress between
+ * them, and the stage publishes the Hermite-interpolated frame to the rendering slot, so the pass
+ * over all particles never runs on the GUI thread. Submissions that arrive while a frame is being
+ * interpolated are coalesced, only the latest one is interpolated next.
+ *
+ * Frames are written into a few reused systems, each of which is only overwritten once the
+ * renderer has let go of it, so steady playback does not allocate.
+ *
+ * While frames are submitted, the stage is the only producer of the rendering slot. Other
+ * producers must call clear() before they set the slot themselves.
+ */
+class InterpolationStage {
+public:
+    /**
+     * @brief Starts the stage.
+     * @param output The slot that interpolated frames are published to.
+     */
+    explicit InterpolationStage(std::shared_ptr<LatestValueSlot<SystemSnapshot>> output);
+    ~InterpolationStage();
+
+    InterpolationStage(const InterpolationStage&) = delete;
+    InterpolationStage& operator=(const InterpolationStage&) = delete;
+
+    /**
+     * @brief Queues a frame for interpolation, replacing one that has not started yet.
+     * @param from The stored snapshot before the frame.
+     * @param to The stored snapshot after the frame, or nullptr to publish @p from as it is.
+     * @param progress How far the frame is from @p from to @p to, between 0 and 1. @p from is
+     *        published as it is for a progress of 0 or less.
+     */
+    void submit(SystemSnapshotPtr from, SystemSnapshotPtr to = nullptr, double progress = 0.0);
+
+    /**
+     * @brief Discards the pending submission and the frame that is being interpolated. Once this
+     * returns, the stage does not touch the output slot until the next submit().
+     */
+    void clear();
+
+private:
+    // Enough for the frames held by the output slot and the render pipeline at the same time.
+    static constexpr size_t kMaxFrames = 6;
+
+    void interpolateLoop();
+
+    /**
+     * @brief Returns a frame that nothing else references, allocating one if all are in use.
+     */
+    std::shared_ptr<enkas::data::System> acquireFrame();
+
+    std::shared_ptr<LatestValueSlot<SystemSnapshot>> output_;
+    std::vector<std::shared_ptr<enkas::data::System>> frames_;  // Owned by the stage thread
+
+    std::mutex mtx_;
+    std::condition_variable cond_input_;
+    SystemSnapshotPtr input_from_;  // The next frame to interpolate, guarded by mtx_
+    SystemSnapshotPtr input_to_;
+    double input_progress_ = 0.0;
+    uint64_t input_sequence_ = 0;
+    uint64_t cleared_sequence_ = 0;  // Frames up to this number are discarded
+    bool is_shutting_down_ = false;
+
+    std::thread thread_;
+};
@@ -38,6 +38,22 @@ constexpr double kBaseAnimationSpeed = 0.002;
 
 // --- Draw Settings ---
 constexpr float kCrosshairNdcSize = 0.04f;
+
+/**
+ * @brief Uploads data to a vertex buffer, reallocating it only if it is too small.
+ * The buffer must be bound.
+ */
+void uploadToBuffer(QOpenGLBuffer& buffer, size_t& capacity_bytes, const std::vector<float>& data) {
+    const size_t required_bytes = data.size() * sizeof(float);
+    if (required_bytes > capacity_bytes) {
+        // The buffer is too small, we must re-allocate.
+        buffer.allocate(data.data(), static_cast<int>(required_bytes));
+        capacity_bytes = required_bytes;
+    } else {
+        // The buffer is large enough, just update its content (fast path).
+        buffer.write(0, data.data(), static_cast<int>(required_bytes));
+    }
+}
 }  // namespace
 
 ParticleRenderer::ParticleRenderer(QWidget* parent) : QOpenGLWidget(parent) {
@@ -51,8 +67,9 @@ ParticleRenderer::ParticleRenderer(QWidget* parent) : QOpenGLWidget(parent) {
 }
 
 void ParticleRenderer::updateData(SystemSnapshotPtr system) {
-    if (!system) return;
+    if (!system || system == system_) return;
     system_ = std::move(system);
+    submitSystem();
 }
 
 void ParticleRenderer::redraw(const RenderSettings& settings) {
@@ -62,6 +79,8 @@ void ParticleRenderer::redraw(const RenderSettings& settings) {
 
 void ParticleRenderer::clearData() {
     system_.reset();
+    render_snapshot_.reset();
+    render_stage_.clear();
     update();
 }
 
@@ -211,22 +230,46 @@ void ParticleRenderer::keyPressEvent(QKeyEvent* event) {
     camera_.target_pos += camera_.rel_rotation.get_reverse().rotate(displacement);
 }
 
-void ParticleRenderer::drawParticles() {
-    if (!system_ || system_->data->positions.empty()) {
-        return;
-    }
+PointLodSettings ParticleRenderer::currentLod() const {
+    // Systems within the budget are drawn particle by particle, independent of the camera.
+    if (!system_ || settings_.max_points <= 0) return {};
+    const auto max_points = static_cast<size_t>(settings_.max_points);
+    if (system_->data->count() <= max_points) return {};
+    return makePointLodSettings(camera_, max_points);
+}
+
+void ParticleRenderer::submitSystem() {
+    submitted_lod_ = currentLod();
+    render_stage_.submit(system_, submitted_lod_);
+}
+
+void ParticleRenderer::uploadParticles() {
+    // Rebuild the points when the camera or the point budget changed the level of detail.
+    if (system_ && currentLod() != submitted_lod_) submitSystem();
+
+    // Any result newer than the one on screen is used, even if the system has been replaced since.
+    // With a new snapshot every frame, each result is already one update old when it arrives.
+    auto render_snapshot = render_stage_.take();
+    if (!render_snapshot) return;
+    if (render_snapshot_ && render_snapshot->sequence <= render_snapshot_->sequence) return;
 
-    const auto& positions_d = system_->data->positions;  // 'd' for double
-    const auto num_particles = system_->data->count();
+    render_snapshot_ = std::move(render_snapshot);
 
-    // Convert to float for GPU processing
-    particle_positions_f_.clear();
-    particle_positions_f_.reserve(num_particles * 3);
+    particle_position_vbo_.bind();
+    uploadToBuffer(
+        particle_position_vbo_, particle_vbo_capacity_bytes_, render_snapshot_->positions);
+    particle_position_vbo_.release();
+
+    particle_scale_vbo_.bind();
+    uploadToBuffer(particle_scale_vbo_, scale_vbo_capacity_bytes_, render_snapshot_->scales);
+    particle_scale_vbo_.release();
+}
 
-    for (const auto& p : positions_d) {
-        particle_positions_f_.push_back(static_cast<float>(p.x));
-        particle_positions_f_.push_back(static_cast<float>(p.y));
-        particle_positions_f_.push_back(static_cast<float>(p.z));
+void ParticleRenderer::drawParticles() {
+    uploadParticles();
+
+    if (!system_ || !render_snapshot_ || render_snapshot_->count() == 0) {
+        return;
     }
 
     shader_program_.bind();
@@ -247,22 +290,9 @@ void ParticleRenderer::drawParticles() {
     }
 
     vao_.bind();
-    particle_position_vbo_.bind();
 
-    // Determine if we need to reallocate the VBO
-    const size_t required_bytes = particle_positions_f_.size() * sizeof(float);
-    if (required_bytes > particle_vbo_capacity_bytes_) {
-        // The buffer is too small, we must re-allocate.
-        particle_position_vbo_.allocate(particle_positions_f_.data(),
-                                        static_cast<int>(required_bytes));
-        particle_vbo_capacity_bytes_ = required_bytes;
-    } else {
-        // The buffer is large enough, just update its content (fast path).
-        particle_position_vbo_.write(
-            0, particle_positions_f_.data(), static_cast<int>(required_bytes));
-    }
-
-    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, num_particles);
+    glDrawArraysInstanced(
+        GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(render_snapshot_->count()));
 
     vao_.release();
     shader_program_.release();
@@ -295,6 +325,8 @@ void ParticleRenderer::initializeParticleShader() {
 
     particle_position_vbo_.create();
     particle_vbo_capacity_bytes_ = 0;
+    particle_scale_vbo_.create();
+    scale_vbo_capacity_bytes_ = 0;
 
     vao_.create();
     vao_.bind();
@@ -309,6 +341,12 @@ void ParticleRenderer::initializeParticleShader() {
 
     glVertexAttribDivisor(1, 1);
 
+    particle_scale_vbo_.bind();
+    shader_program_.enableAttributeArray(2);
+    shader_program_.setAttributeBuffer(2, GL_FLOAT, 0, 1, 0);  // location=2, 1 float
+
+    glVertexAttribDivisor(2, 1);
+
     vao_.release();
 }
 
@@ -15,6 +15,7 @@
 #include "core/dataflow/snapshot.h"
 #include "rendering/camera.h"
 #include "rendering/render_settings.h"
+#include "rendering/render_snapshot_stage.h"
 
 /**
  * @brief ParticleRenderer is a QOpenGLWidget that renders particles in a 3D space.
@@ -33,6 +34,7 @@ public:
 
     /**
      * @brief Updates the particle system data.
+     * The snapshot is converted to GPU layout in the background and drawn once it is ready.
      * @param system The new particle system snapshot.
      * @note This does not trigger a redraw.
      */
@@ -77,6 +79,9 @@ private:
     void initializeParticleShader();
     void initializeCrossShader();
     void drawParticles();
+    void uploadParticles();
+    PointLodSettings currentLod() const;
+    void submitSystem();
     void drawCross(const QPointF& center, float size, const QVector3D& color);
     QPointF projectWorldToNdc(const enkas::math::Vector3D& world_pos, bool* is_visible);
     void animation();
@@ -91,6 +96,7 @@ private:
 
     QOpenGLVertexArrayObject vao_;
     QOpenGLBuffer particle_position_vbo_;  // Holds all particle 3D positions
+    QOpenGLBuffer particle_scale_vbo_;     // Holds the size of each drawn point
     QOpenGLBuffer quad_vbo_;               // Holds the 4 vertices of a simple square
     QOpenGLShaderProgram shader_program_;
 
@@ -101,6 +107,9 @@ private:
     QMatrix4x4 projection_matrix_;
     QMatrix4x4 view_matrix_;
 
-    std::vector<float> particle_positions_f_;  // Particle positions in float format
-    size_t particle_vbo_capacity_bytes_ = 0;   // Capacity in bytes for the particle position VBO
+    RenderSnapshotStage render_stage_;        // Converts snapshots off the GUI thread
+    RenderSnapshotPtr render_snapshot_;       // The snapshot currently held by the VBOs
+    PointLodSettings submitted_lod_;          // The level of detail of the last submission
+    size_t particle_vbo_capacity_bytes_ = 0;  // Capacity in bytes for the particle position VBO
+    size_t scale_vbo_capacity_bytes_ = 0;     // Capacity in bytes for the particle scale VBO
 };
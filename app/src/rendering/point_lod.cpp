@@ -0,0 +1,142 @@
+#include "rendering/point_lod.h"
+
+#include <enkas/data/system.h>
+#include <enkas/math/vector3d.h>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "rendering/camera.h"
+
+namespace {
+// --- Cell Size ---
+constexpr double kCellSizePerDistance = 1.0 / 512.0;  // About one pixel at a 90° field of view
+constexpr double kMinCellSize = 1e-6;
+
+// --- Grid Limits ---
+constexpr double kMaxCellCoordinate = 0x1p62;  // Particles beyond this are not drawn
+constexpr int kMaxMergeLevels = 64;            // All keys are 0 or -1 after 63 halvings
+
+// --- Lookup Table ---
+constexpr size_t kMinTableSize = 64;  // Power of two, at least twice the number of cells
+
+uint64_t mixBits(uint64_t h) {
+    h ^= h >> 31;
+    h *= 0x7FB5D329728EA185ull;
+    h ^= h >> 27;
+    return h;
+}
+}  // namespace
+
+PointLodSettings makePointLodSettings(const Camera& camera, size_t max_points) {
+    const double cell_size = std::max(kMinCellSize, camera.target_distance * kCellSizePerDistance);
+    return {.max_points = max_points, .cell_size = std::exp2(std::floor(std::log2(cell_size)))};
+}
+
+void PointLodBuilder::build(const enkas::data::System& system,
+                            const PointLodSettings& settings,
+                            std::vector<float>& positions,
+                            std::vector<float>& scales) {
+    // Successive snapshots need about the same cell size. Starting one level finer than last
+    // time skips most of the merge passes, and still lets the cells shrink again over a few
+    // builds once the particles spread out. New settings start over at the finest level.
+    if (settings != last_settings_) last_cell_size_ = 0.0;
+    last_settings_ = settings;
+
+    const double finest_cell_size = std::max(settings.cell_size, kMinCellSize);
+    double cell_size = std::max(finest_cell_size, last_cell_size_ / 2);
+    binParticles(system, cell_size);
+
+    // Halving the cell coordinates merges each block of 2x2x2 cells, one octree level up.
+    for (int level = 0; settings.max_points != 0 && cells_.size() > settings.max_points &&
+                        level < kMaxMergeLevels;
+         ++level) {
+        mergeCells();
+        cell_size *= 2;
+    }
+    last_cell_size_ = cell_size;
+
+    positions.resize(3 * cells_.size());
+    scales.resize(cells_.size());
+    for (size_t i = 0; i < cells_.size(); ++i) {
+        const Cell& cell = cells_[i];
+        const enkas::math::Vector3D center =
+            cell.mass > 0.0 ? cell.weighted_position_sum / cell.mass
+                            : enkas::math::Vector3D(cell.key.x + 0.5,
+                                                    cell.key.y + 0.5,
+                                                    cell.key.z + 0.5) *
+                                  cell_size;
+        positions[3 * i + 0] = static_cast<float>(center.x);
+        positions[3 * i + 1] = static_cast<float>(center.y);
+        positions[3 * i + 2] = static_cast<float>(center.z);
+
+        // The point covers the volume of all particles in the cell.
+        scales[i] = std::cbrt(static_cast<float>(cell.count));
+    }
+}
+
+void PointLodBuilder::binParticles(const enkas::data::System& system, double cell_size) {
+    cells_.clear();
+    resetTable(system.count());
+
+    const double inverse_cell_size = 1.0 / cell_size;
+    for (size_t i = 0; i < system.count(); ++i) {
+        const enkas::math::Vector3D& position = system.positions[i];
+        const double x = std::floor(position.x * inverse_cell_size);
+        const double y = std::floor(position.y * inverse_cell_size);
+        const double z = std::floor(position.z * inverse_cell_size);
+
+        // Also rejects NaN coordinates.
+        if (!(std::abs(x) < kMaxCellCoordinate && std::abs(y) < kMaxCellCoordinate &&
+              std::abs(z) < kMaxCellCoordinate)) {
+            continue;
+        }
+
+        Cell& cell = cellAt(
+            cells_, {static_cast<int64_t>(x), static_cast<int64_t>(y), static_cast<int64_t>(z)});
+        const double mass = system.masses[i];
+        cell.weighted_position_sum += position * mass;
+        cell.mass += mass;
+        ++cell.count;
+    }
+}
+
+void PointLodBuilder::mergeCells() {
+    merged_cells_.clear();
+    resetTable(cells_.size());
+
+    for (const Cell& cell : cells_) {
+        // Arithmetic shift rounds towards negative infinity, like the floor in binParticles().
+        Cell& parent = cellAt(merged_cells_, {cell.key.x >> 1, cell.key.y >> 1, cell.key.z >> 1});
+        parent.weighted_position_sum += cell.weighted_position_sum;
+        parent.mass += cell.mass;
+        parent.count += cell.count;
+    }
+
+    std::swap(cells_, merged_cells_);
+}
+
+void PointLodBuilder::resetTable(size_t max_cells) {
+    const size_t size = std::bit_ceil(std::max(2 * max_cells, kMinTableSize));
+    table_.assign(size, 0);
+    table_mask_ = size - 1;
+}
+
+PointLodBuilder::Cell& PointLodBuilder::cellAt(std::vector<Cell>& cells, const CellKey& key) {
+    uint64_t hash = mixBits(static_cast<uint64_t>(key.x));
+    hash = mixBits(hash ^ static_cast<uint64_t>(key.y));
+    hash = mixBits(hash ^ static_cast<uint64_t>(key.z));
+
+    // The table is at most half full, so probing always ends at an empty slot.
+    for (size_t slot = hash & table_mask_;; slot = (slot + 1) & table_mask_) {
+        if (table_[slot] == 0) {
+            cells.push_back({.key = key});
+            table_[slot] = static_cast<uint32_t>(cells.size());
+            return cells.back();
+        }
+        if (cells[table_[slot] - 1].key == key) return cells[table_[slot] - 1];
+    }
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <enkas/data/system.h>
+#include <enkas/math/vector3d.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "rendering/camera.h"
+
+/**
+ * @brief Controls how far particles are merged into aggregated points for drawing.
+ */
+struct PointLodSettings {
+    size_t max_points = 0;   // Maximum number of drawn points, 0 for no limit
+    double cell_size = 0.0;  // Edge length of the finest cell that particles are merged in
+
+    bool operator==(const PointLodSettings& other) const = default;
+};
+
+/**
+ * @brief Derives the level of detail from the camera.
+ *
+ * The finest cell covers roughly one pixel at the distance of the camera target, so merging the
+ * particles in a cell is barely visible. The cell size is rounded down to a power of two, so the
+ * settings, and the aggregated points, only change when the camera distance changes noticeably.
+ *
+ * @param camera The camera the points are drawn for.
+ * @param max_points The maximum number of drawn points, 0 for no limit.
+ */
+[[nodiscard]] PointLodSettings makePointLodSettings(const Camera& camera, size_t max_points);
+
+/**
+ * @brief Aggregates the particles of a system into at most a given number of points for drawing.
+ *
+ * The particles are binned into a grid of cubic cells aligned to the world origin. Each occupied
+ * cell becomes one point at the mass-weighted center of its particles, or at the center of the
+ * cell if they are massless, with a size weight that keeps the volume of the merged particles.
+ * While there are more cells than the budget allows, cells are merged eight at a time into the
+ * cell of the next octree level.
+ *
+ * The builder keeps its buffers and the cell size of the previous build between calls, so it
+ * should be reused for successive snapshots.
+ */
+class PointLodBuilder {
+public:
+    /**
+     * @brief Builds the aggregated points of a system.
+     * @param system The system to draw.
+     * @param settings The point budget and the size of the finest cell.
+     * @param positions Receives x, y, z per point.
+     * @param scales Receives the size of each point relative to a single particle.
+     */
+    void build(const enkas::data::System& system,
+               const PointLodSettings& settings,
+               std::vector<float>& positions,
+               std::vector<float>& scales);
+
+private:
+    struct CellKey {
+        int64_t x;
+        int64_t y;
+        int64_t z;
+
+        bool operator==(const CellKey& other) const = default;
+    };
+
+    // Fits into one cache line, binning is bound by the random accesses to the cells.
+    struct Cell {
+        CellKey key;
+        enkas::math::Vector3D weighted_position_sum{};  // Sum of mass * position
+        double mass = 0.0;
+        uint32_t count = 0;
+    };
+
+    void binParticles(const enkas::data::System& system, double cell_size);
+    void mergeCells();
+
+    /**
+     * @brief Clears the cell lookup table and sizes it for up to @p max_cells cells.
+     */
+    void resetTable(size_t max_cells);
+
+    /**
+     * @brief Returns the cell with the given key, appending an empty one if there is none yet.
+     */
+    Cell& cellAt(std::vector<Cell>& cells, const CellKey& key);
+
+    std::vector<Cell> cells_;
+    std::vector<Cell> merged_cells_;
+    PointLodSettings last_settings_;
+    double last_cell_size_ = 0.0;  // The cell size the previous build ended up with
+
+    // Open addressing with linear probing, which avoids an allocation per cell. Each slot holds
+    // the index of a cell plus one, or zero if it is empty.
+    std::vector<uint32_t> table_;
+    size_t table_mask_ = 0;
+};
@@ -45,6 +45,9 @@ struct RenderSettings {
     double particle_size_param = 100;
     int fov = 90;
 
+    // Level of detail
+    int max_points = 1'000'000;  // Larger systems are drawn with nearby particles merged
+
     RenderSettings()
         : coloring_method(isDarkMode() ? ColoringMethod::BlackFog : ColoringMethod::WhiteFog) {}
 };
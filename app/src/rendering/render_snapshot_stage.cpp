@@ -0,0 +1,105 @@
+#include "rendering/render_snapshot_stage.h"
+
+#include <enkas/data/system.h>
+#include <enkas/math/vector3d.h>
+#include <enkas/tracing/trace.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "core/dataflow/snapshot.h"
+#include "rendering/point_lod.h"
+
+void packPositions(const enkas::data::System& system, std::vector<float>& out) {
+    static_assert(sizeof(enkas::math::Vector3D) == 3 * sizeof(double) &&
+                      std::is_standard_layout_v<enkas::math::Vector3D>,
+                  "Vector3D must be three tightly packed doubles");
+
+    // Positions are read as one flat array of doubles, which turns the conversion into a single
+    // loop that compilers vectorize.
+    const size_t value_count = 3 * system.count();
+    out.resize(value_count);
+    const auto* values = reinterpret_cast<const double*>(system.positions.data());
+    std::transform(values, values + value_count, out.begin(), [](double value) {
+        return static_cast<float>(value);
+    });
+}
+
+RenderSnapshotStage::RenderSnapshotStage() : thread_(&RenderSnapshotStage::convertLoop, this) {}
+
+RenderSnapshotStage::~RenderSnapshotStage() {
+    {
+        std::scoped_lock lock(mtx_);
+        is_shutting_down_ = true;
+    }
+    cond_input_.notify_one();
+    thread_.join();
+}
+
+uint64_t RenderSnapshotStage::submit(SystemSnapshotPtr snapshot, const PointLodSettings& lod) {
+    if (!snapshot) return 0;
+
+    uint64_t sequence;
+    {
+        std::scoped_lock lock(mtx_);
+        input_ = std::move(snapshot);
+        input_lod_ = lod;
+        sequence = input_sequence_ = ++last_sequence_;
+    }
+    cond_input_.notify_one();
+    return sequence;
+}
+
+void RenderSnapshotStage::clear() {
+    std::scoped_lock lock(mtx_);
+    input_.reset();
+    cleared_sequence_.store(++last_sequence_, std::memory_order_release);
+}
+
+RenderSnapshotPtr RenderSnapshotStage::take() {
+    auto render_snapshot = output_.take();
+    if (!render_snapshot ||
+        render_snapshot->sequence <= cleared_sequence_.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+    return render_snapshot;
+}
+
+void RenderSnapshotStage::convertLoop() {
+    ENKAS_TRACE_THREAD_NAME("Render Conversion");
+    while (true) {
+        SystemSnapshotPtr snapshot;
+        PointLodSettings lod;
+        uint64_t sequence;
+        {
+            std::unique_lock lock(mtx_);
+            cond_input_.wait(lock, [this] { return input_ || is_shutting_down_; });
+            if (is_shutting_down_) return;
+            snapshot = std::move(input_);
+            lod = input_lod_;
+            sequence = input_sequence_;
+        }
+
+        if (!snapshot->data) continue;
+        const auto& system = *snapshot->data;
+        ENKAS_TRACE_SCOPE("Convert Snapshot");
+
+        auto render_snapshot = pool_.acquire();
+        if (lod.max_points == 0 || system.count() <= lod.max_points) {
+            packPositions(system, render_snapshot->positions);
+            render_snapshot->scales.assign(system.count(), 1.0f);
+        } else {
+            lod_builder_.build(system, lod, render_snapshot->positions, render_snapshot->scales);
+        }
+        render_snapshot->source = std::move(snapshot);
+        render_snapshot->sequence = sequence;
+        render_snapshot->lod = lod;
+        output_.set(std::move(render_snapshot));
+    }
+}
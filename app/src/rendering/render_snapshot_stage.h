@@ -0,0 +1,115 @@
+#pragma once
+
+#include <enkas/data/system.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "core/dataflow/latest_value_slot.h"
+#include "core/dataflow/memory_pool.h"
+#include "core/dataflow/snapshot.h"
+#include "rendering/point_lod.h"
+
+/**
+ * @brief Particle data of a system snapshot in the layout the GPU consumes.
+ */
+struct RenderSnapshot {
+    SystemSnapshotPtr source;      // The snapshot the data was built from
+    uint64_t sequence = 0;         // The number of the submission the data was built from
+    PointLodSettings lod;          // The level of detail the data was built with
+    std::vector<float> positions;  // Packed x, y, z per point
+    std::vector<float> scales;     // Size per point, 1 for a single particle
+
+    [[nodiscard]] size_t count() const { return scales.size(); }
+
+    // Keeps the capacity of the buffers, so that a pooled snapshot does not reallocate.
+    void reset() {
+        source.reset();
+        sequence = 0;
+        lod = {};
+        positions.clear();
+        scales.clear();
+    }
+};
+
+using RenderSnapshotPtr = std::shared_ptr<const RenderSnapshot>;
+
+/**
+ * @brief Converts the particle positions of a system to packed single-precision floats.
+ * @param system The system to convert.
+ * @param out The buffer to write to. It is resized to three floats per particle.
+ */
+void packPositions(const enkas::data::System& system, std::vector<float>& out);
+
+/**
+ * @brief Prepares render snapshots from system snapshots on a background thread.
+ *
+ * The GUI thread submits every new system snapshot and takes the converted result on a later
+ * frame, so the per-particle work never runs inside paintGL(). Submissions that arrive while a
+ * conversion is running are coalesced, only the latest one is converted next.
+ *
+ * Systems with more particles than the point budget of the level of detail are aggregated with a
+ * PointLodBuilder, smaller systems are drawn particle by particle.
+ */
+class RenderSnapshotStage {
+public:
+    RenderSnapshotStage();
+    ~RenderSnapshotStage();
+
+    RenderSnapshotStage(const RenderSnapshotStage&) = delete;
+    RenderSnapshotStage& operator=(const RenderSnapshotStage&) = delete;
+
+    /**
+     * @brief Queues a system snapshot for conversion, replacing one that has not started yet.
+     * @param snapshot The snapshot to convert.
+     * @param lod The level of detail to draw the snapshot with. Draws every particle by default.
+     * @return The sequence number of the submission, which its render snapshot carries. Later
+     *         submissions have higher numbers.
+     */
+    uint64_t submit(SystemSnapshotPtr snapshot, const PointLodSettings& lod = {});
+
+    /**
+     * @brief Discards the pending submission and all results of earlier submissions, including
+     * a conversion that is still running.
+     */
+    void clear();
+
+    /**
+     * @brief Takes the most recently converted render snapshot.
+     *
+     * A result is returned even if newer snapshots have been submitted since, so that a display
+     * that submits faster than the stage converts still advances.
+     *
+     * @return The render snapshot, or nullptr if nothing new has been converted since the last
+     *         call or the last clear().
+     */
+    [[nodiscard]] RenderSnapshotPtr take();
+
+private:
+    // Up to two snapshots in the output slot, one held by the renderer and one being built.
+    static constexpr size_t kMaxRenderSnapshots = 4;
+
+    void convertLoop();
+
+    // Declared before the output, which holds pooled snapshots, so that it is destroyed last.
+    MemoryPool<RenderSnapshot> pool_{MemoryPoolLimits{.max_buffers = kMaxRenderSnapshots}};
+    LatestValueSlot<const RenderSnapshot> output_;
+    PointLodBuilder lod_builder_;  // Owned by the conversion thread
+
+    std::mutex mtx_;
+    std::condition_variable cond_input_;
+    SystemSnapshotPtr input_;  // The next snapshot to convert, guarded by mtx_
+    PointLodSettings input_lod_;
+    uint64_t input_sequence_ = 0;
+    uint64_t last_sequence_ = 0;                  // Last number taken by submit() or clear()
+    std::atomic<uint64_t> cleared_sequence_ = 0;  // Results up to this number are discarded
+    bool is_shutting_down_ = false;
+
+    std::thread thread_;
+};
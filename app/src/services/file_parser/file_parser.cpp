@@ -10,6 +10,7 @@
 
 #include "core/dataflow/snapshot.h"
 #include "core/files/file_constants.h"
+#include "core/files/system_snapshot_stream.h"
 #include "core/settings/settings.h"
 
 std::optional<Settings> FileParser::parseSettings(const std::filesystem::path& file_path) {
@@ -137,69 +138,36 @@ std::optional<enkas::data::System> FileParser::parseInitialSystem(
     }
 }
 
-std::optional<int> FileParser::countSnapshots(const std::filesystem::path& file_path) {
+std::optional<SystemFileMetadata> FileParser::parseSystemMetadata(
+    const std::filesystem::path& file_path) {
     if (!std::filesystem::exists(file_path)) {
         ENKAS_LOG_ERROR("File does not exist: {}", file_path.string());
         return std::nullopt;
     }
 
-    try {
-        auto format =
-            csv::CSVFormat().header_row(0).variable_columns(csv::VariableColumnPolicy::THROW);
-        csv::CSVReader reader(file_path.string(), format);
-
-        if (reader.get_col_names() != csv_headers::system) {
-            ENKAS_LOG_ERROR("Invalid CSV header in file: {}", file_path.string());
-            return std::nullopt;
-        }
-
-        std::set<double> unique_timestamps;
-        for (const auto& row : reader) {
-            unique_timestamps.insert(row["time"].get<double>());
-        }
-
-        ENKAS_LOG_INFO("Counted {} unique snapshots in file: {}",
-                       unique_timestamps.size(),
-                       file_path.string());
-        return static_cast<int>(unique_timestamps.size());
-
-    } catch (const std::exception& e) {
-        ENKAS_LOG_ERROR("Error occurred while counting snapshots: {}", e.what());
+    // The snapshot index gives us count, duration and the first snapshot's location in one pass,
+    // or without any scan at all if a persisted index is available.
+    SystemSnapshotStream stream(file_path);
+    if (!stream.initialize()) {
+        ENKAS_LOG_ERROR("Failed to index system file: {}", file_path.string());
         return std::nullopt;
     }
-}
 
-std::optional<double> FileParser::retrieveSimulationDuration(
-    const std::filesystem::path& file_path) {
-    if (!std::filesystem::exists(file_path)) {
-        ENKAS_LOG_ERROR("File does not exist: {}", file_path.string());
+    auto first_snapshot = stream.getFirstSnapshot();
+    auto last_timestamp = stream.getLastTimestamp();
+    if (!first_snapshot || !last_timestamp || first_snapshot->data->count() == 0) {
+        ENKAS_LOG_ERROR("No initial system data found in file: {}", file_path.string());
         return std::nullopt;
     }
 
-    try {
-        // We only care about the header row to find the 'time' column
-        csv::CSVReader reader(file_path.string(), csv::CSVFormat().header_row(0));
-
-        std::optional<double> last_timestamp;
-        for (const auto& row : reader) {
-            // This will continuously overwrite the value, leaving the timestamp from the last row
-            last_timestamp = row["time"].get<double>();
-        }
+    SystemFileMetadata metadata;
+    metadata.initial_system = *first_snapshot->data;
+    metadata.snapshot_count = stream.getSnapshotCount();
+    metadata.simulation_duration = *last_timestamp;
 
-        if (!last_timestamp) {
-            ENKAS_LOG_ERROR("No data rows with a 'time' column found in file: {}",
-                            file_path.string());
-            return std::nullopt;
-        }
-
-        ENKAS_LOG_INFO(
-            "Retrieved simulation duration {} from file: {}", *last_timestamp, file_path.string());
-        return last_timestamp;
-
-    } catch (const std::exception& e) {
-        ENKAS_LOG_ERROR(
-            "Error occurred while retrieving simulation duration (is 'time' column missing?): {}",
-            e.what());
-        return std::nullopt;
-    }
+    ENKAS_LOG_INFO("Read metadata ({} snapshots, duration {}) from file: {}",
+                   metadata.snapshot_count,
+                   metadata.simulation_duration,
+                   file_path.string());
+    return metadata;
 }
@@ -27,17 +27,11 @@ public:
         const std::filesystem::path& file_path) override;
 
     /**
-     * @brief Counts the number of snapshots in the specified file.
-     * @param file_path The path to the CSV file.
-     * @return An optional integer containing the snapshot count.
-     */
-    std::optional<int> countSnapshots(const std::filesystem::path& file_path) override;
-
-    /**
-     * @brief Retrieves the simulation duration from the specified file.
-     * @param file_path The path to the CSV file.
-     * @return An optional double containing the simulation duration.
+     * @brief Reads the initial system, the snapshot count and the simulation duration at once.
+     * Reuses a persisted snapshot index if one exists for the file.
+     * @param file_path The path to the CSV file containing system data.
+     * @return An optional SystemFileMetadata object containing the gathered information.
      */
-    std::optional<double> retrieveSimulationDuration(
+    std::optional<SystemFileMetadata> parseSystemMetadata(
         const std::filesystem::path& file_path) override;
 };
@@ -6,6 +6,15 @@
 #include "core/dataflow/snapshot.h"
 #include "core/settings/settings.h"
 
+/**
+ * @brief Summary of a system file, gathered in a single pass over the file.
+ */
+struct SystemFileMetadata {
+    enkas::data::System initial_system;
+    std::size_t snapshot_count = 0;
+    double simulation_duration = 0.0;
+};
+
 class IFileParser {
 public:
     virtual ~IFileParser() = default;
@@ -33,17 +42,11 @@ public:
         const std::filesystem::path& file_path) = 0;
 
     /**
-     * @brief Counts the number of snapshots in the specified file.
-     * @param file_path The path to the CSV file.
-     * @return An optional integer containing the snapshot count.
-     */
-    virtual std::optional<int> countSnapshots(const std::filesystem::path& file_path) = 0;
-
-    /**
-     * @brief Retrieves the simulation duration from the specified file.
-     * @param file_path The path to the CSV file.
-     * @return An optional double containing the simulation duration.
+     * @brief Reads the initial system, the snapshot count and the simulation duration at once.
+     * Reuses a persisted snapshot index if one exists for the file.
+     * @param file_path The path to the CSV file containing system data.
+     * @return An optional SystemFileMetadata object containing the gathered information.
      */
-    virtual std::optional<double> retrieveSimulationDuration(
+    virtual std::optional<SystemFileMetadata> parseSystemMetadata(
         const std::filesystem::path& file_path) = 0;
 };
@@ -24,10 +24,12 @@
 #include "settings_widgets/generation/uniform_sphere_schema.h"
 #include "settings_widgets/settings_widget.h"
 #include "settings_widgets/simulation/barneshut_leapfrog_schema.h"
+#include "settings_widgets/simulation/barneshut_symplectic_schema.h"
 #include "settings_widgets/simulation/euler_schema.h"
 #include "settings_widgets/simulation/hermite_schema.h"
 #include "settings_widgets/simulation/hits_schema.h"
 #include "settings_widgets/simulation/leapfrog_schema.h"
+#include "settings_widgets/simulation/symplectic_schema.h"
 #include "widgets/file_check_icon.h"
 
 NewSimulationTab::NewSimulationTab(QWidget* parent)
@@ -93,6 +95,8 @@ void NewSimulationTab::setupSettingsWidgets() {
     sim[SimulationMethod::Hermite] = std::make_shared<HermiteSchema>();
     sim[SimulationMethod::Hits] = std::make_shared<HitsSchema>();
     sim[SimulationMethod::BarnesHutLeapfrog] = std::make_shared<BarnesHutLeapfrogSchema>();
+    sim[SimulationMethod::Symplectic] = std::make_shared<SymplecticSchema>();
+    sim[SimulationMethod::BarnesHutSymplectic] = std::make_shared<BarnesHutSymplecticSchema>();
 }
 
 void NewSimulationTab::setupMethodSelection() {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <QString>
+#include <QStringList>
 #include <QVariant>
 
 #include "core/settings/setting_key.h"
@@ -17,6 +18,7 @@ constexpr int particle_count_min = 1;
 constexpr int particle_count_max = 1'000'000;
 constexpr int random_min = 0;
 constexpr int random_max = 1'000'000'000;
+constexpr int reorder_interval_max = 1'000'000;
 }  // namespace limits
 
 /**
@@ -26,7 +28,8 @@ constexpr int random_max = 1'000'000'000;
 struct SettingDescriptor {
     SettingKey key;
     QString label;
-    enum Type { Double, Int, FilePath, RandomInt } type;
+    enum Type { Double, Int, FilePath, RandomInt, Choice } type;
     QVariant defaultValue;
-    QVariant min, max;  // only for numerics
+    QVariant min, max;    // only for numerics
+    QStringList options;  // only for choices, stored as the selected string
 };
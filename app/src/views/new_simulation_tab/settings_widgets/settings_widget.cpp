@@ -1,5 +1,6 @@
 #include "settings_widget.h"
 
+#include <QComboBox>
 #include <QDoubleSpinBox>
 #include <QFileDialog>
 #include <QFormLayout>
@@ -88,6 +89,13 @@ void SettingsWidget::setSchema(const QVector<SettingDescriptor>& schema) {
 
                 editor = container;
             } break;
+
+            case SettingDescriptor::Choice: {
+                auto* cb = new QComboBox;
+                cb->addItems(desc.options);
+                cb->setCurrentText(desc.defaultValue.toString());
+                editor = cb;
+            } break;
         }
         editors_[desc.key] = editor;
         form_->addRow(desc.label, editor);
@@ -124,6 +132,11 @@ Settings SettingsWidget::getSettings() const {
                 }
                 break;
             }
+            case SettingDescriptor::Choice: {
+                auto* cb = qobject_cast<QComboBox*>(w);
+                if (cb) out.set(key, cb->currentText().toStdString());
+                break;
+            }
         }
     }
     return out;
@@ -159,6 +172,11 @@ void SettingsWidget::setSettings(const Settings& settings) {
                 }
                 break;
             }
+            case SettingDescriptor::Choice: {
+                auto* cb = qobject_cast<QComboBox*>(w);
+                if (cb) cb->setCurrentText(QString::fromStdString(settings.get<std::string>(key)));
+                break;
+            }
         }
     }
 }
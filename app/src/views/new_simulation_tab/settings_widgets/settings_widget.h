@@ -14,7 +14,7 @@
  * @brief SettingsWidget provides a dynamic form for editing settings based on a schema.
  *
  * It allows users to set various types of settings, including doubles, integers, file paths,
- * and random integers, with appropriate input widgets.
+ * random integers and choices from a list, with appropriate input widgets.
  */
 class SettingsWidget : public QWidget {
     Q_OBJECT
@@ -26,6 +26,12 @@ public:
                  SettingDescriptor::Double,
                  0.001,
                  limits::smallest_greater_than_zero,
-                 limits::double_max}};
+                 limits::double_max},
+                {SettingKey::BarnesHutLeapfrogReorderInterval,
+                 "Reorder interval",
+                 SettingDescriptor::Int,
+                 10,
+                 limits::zero,
+                 limits::reorder_interval_max}};
     }
 };
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <QString>
+
+#include "views/new_simulation_tab/settings_widgets/setting_descriptor.h"
+#include "views/new_simulation_tab/settings_widgets/settings_schema.h"
+#include "views/new_simulation_tab/settings_widgets/simulation/symplectic_schema.h"
+
+class BarnesHutSymplecticSchema : public SettingsSchema {
+public:
+    QString name() const override { return "Barnes-Hut (Symplectic)"; }
+    QVector<SettingDescriptor> settingsSchema() const override {
+        return {{SettingKey::BarnesHutSymplecticTimeStep,
+                 "Time step",
+                 SettingDescriptor::Double,
+                 0.03,
+                 limits::smallest_greater_than_zero,
+                 limits::double_max},
+                {SettingKey::BarnesHutSymplecticThetaMac,
+                 "MAC",
+                 SettingDescriptor::Double,
+                 0.01,
+                 limits::smallest_greater_than_zero,
+                 limits::double_max},
+                {SettingKey::BarnesHutSymplecticSoftening,
+                 "Softening",
+                 SettingDescriptor::Double,
+                 0.001,
+                 limits::smallest_greater_than_zero,
+                 limits::double_max},
+                {SettingKey::BarnesHutSymplecticCoefficients,
+                 "Coefficients",
+                 SettingDescriptor::Choice,
+                 "Yoshida",
+                 {},
+                 {},
+                 splittingCoefficientsOptions()},
+                {SettingKey::BarnesHutSymplecticReorderInterval,
+                 "Reorder interval",
+                 SettingDescriptor::Int,
+                 10,
+                 limits::zero,
+                 limits::reorder_interval_max}};
+    }
+};
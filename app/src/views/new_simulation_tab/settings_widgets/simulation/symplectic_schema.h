@@ -0,0 +1,45 @@
+#pragma once
+
+#include <QString>
+#include <QStringList>
+
+#include "core/settings/splitting_coefficients.h"
+#include "views/new_simulation_tab/settings_widgets/setting_descriptor.h"
+#include "views/new_simulation_tab/settings_widgets/settings_schema.h"
+
+/**
+ * @brief Returns the names of the coefficient sets of the symplectic simulators.
+ */
+inline QStringList splittingCoefficientsOptions() {
+    QStringList options;
+    for (const auto& [_, name] : SplittingCoefficientsStrings) {
+        options << QString::fromUtf8(name.data(), static_cast<qsizetype>(name.size()));
+    }
+    return options;
+}
+
+class SymplecticSchema : public SettingsSchema {
+public:
+    QString name() const override { return "Symplectic (4th order)"; }
+    QVector<SettingDescriptor> settingsSchema() const override {
+        return {{SettingKey::SymplecticTimeStep,
+                 "Time step",
+                 SettingDescriptor::Double,
+                 0.03,
+                 limits::smallest_greater_than_zero,
+                 limits::double_max},
+                {SettingKey::SymplecticSoftening,
+                 "Softening",
+                 SettingDescriptor::Double,
+                 0.001,
+                 limits::smallest_greater_than_zero,
+                 limits::double_max},
+                {SettingKey::SymplecticCoefficients,
+                 "Coefficients",
+                 SettingDescriptor::Choice,
+                 "Yoshida",
+                 {},
+                 {},
+                 splittingCoefficientsOptions()}};
+    }
+};
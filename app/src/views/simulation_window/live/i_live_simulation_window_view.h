@@ -1,5 +1,7 @@
 #pragma once
 
+#include <span>
+
 #include "core/dataflow/snapshot.h"
 #include "views/simulation_window/i_simulation_window_view.h"
 
@@ -8,10 +10,11 @@ public:
     virtual ~ILiveSimulationWindowView() = default;
 
     /**
-     * @brief Updates the charts and the particle renderer with the latest diagnostics data.
-     * @param diagnostics_snapshot The snapshot of the diagnostics data to render.
+     * @brief Updates the charts and the particle renderer with new diagnostics data.
+     * @param diagnostics_snapshots The diagnostics snapshots since the last update, oldest first.
      */
-    virtual void updateDiagnostics(DiagnosticsSnapshotPtr diagnostics_snapshot) = 0;
+    virtual void updateDiagnostics(
+        std::span<const DiagnosticsSnapshotPtr> diagnostics_snapshots) = 0;
 
     /**
      * @brief Updates the debug information displayed in the UI.
@@ -12,6 +12,7 @@ LiveSimulationWindow::LiveSimulationWindow(std::shared_ptr<LiveDebugInfo> debug_
     ui_->btnStepForward->setVisible(false);
     ui_->btnJumpToEnd->setVisible(false);
     ui_->hslStepsPerSecond->setVisible(false);
+    ui_->chkInterpolate->setVisible(false);
     ui_->hslPlaybackBar->setEnabled(false);
 
     connect(ui_->btnToggleDebugInfo,
@@ -38,10 +39,18 @@ LiveSimulationWindow::LiveSimulationWindow(std::shared_ptr<LiveDebugInfo> debug_
          .size_member = &LiveDebugInfo::diagnostics_snapshot_pool_size,
          .capacity_member = &LiveDebugInfo::diagnostics_snapshot_pool_capacity,
          .more_is_better = true},
+        {.name = "Pool Memory [MiB]",
+         .size_member = &LiveDebugInfo::pool_memory_mib,
+         .capacity_member = &LiveDebugInfo::pool_memory_capacity_mib,
+         .more_is_better = false},
         {.name = "Chart Queue",
          .size_member = &LiveDebugInfo::chart_queue_size,
          .capacity_member = &LiveDebugInfo::chart_queue_capacity,
          .more_is_better = false},
+        {.name = "Chart Batch",
+         .size_member = &LiveDebugInfo::chart_batch_size,
+         .capacity_member = &LiveDebugInfo::chart_batch_capacity,
+         .more_is_better = false},
         {.name = "System Storage Queue",
          .size_member = &LiveDebugInfo::system_storage_queue_size,
          .capacity_member = &LiveDebugInfo::system_storage_queue_capacity,
@@ -50,15 +59,49 @@ LiveSimulationWindow::LiveSimulationWindow(std::shared_ptr<LiveDebugInfo> debug_
          .size_member = &LiveDebugInfo::diagnostics_storage_queue_size,
          .capacity_member = &LiveDebugInfo::diagnostics_storage_queue_capacity,
          .more_is_better = false},
+        {.name = "Chart Drops",
+         .size_member = &LiveDebugInfo::chart_queue_dropped,
+         .capacity_member = &LiveDebugInfo::chart_queue_offered,
+         .more_is_better = false},
+        {.name = "System Storage Drops",
+         .size_member = &LiveDebugInfo::system_storage_queue_dropped,
+         .capacity_member = &LiveDebugInfo::system_storage_queue_offered,
+         .more_is_better = false},
+        {.name = "System Storage Spills",
+         .size_member = &LiveDebugInfo::system_storage_queue_spilled,
+         .capacity_member = &LiveDebugInfo::system_storage_queue_offered,
+         .more_is_better = false},
+        {.name = "Diagnostics Storage Drops",
+         .size_member = &LiveDebugInfo::diagnostics_storage_queue_dropped,
+         .capacity_member = &LiveDebugInfo::diagnostics_storage_queue_offered,
+         .more_is_better = false},
+        {.name = "Diagnostics Storage Spills",
+         .size_member = &LiveDebugInfo::diagnostics_storage_queue_spilled,
+         .capacity_member = &LiveDebugInfo::diagnostics_storage_queue_offered,
+         .more_is_better = false},
     };
 
-    ui_->wgtDebugInfo->setupInfo<LiveDebugInfo>(live_debug_mapping);
+    static const std::vector<DebugLatencyRow<LiveDebugInfo>> live_latency_mapping = {
+        {.name = "Step", .histogram_member = &LiveDebugInfo::step_latency},
+        {.name = "Force Evaluation", .histogram_member = &LiveDebugInfo::force_latency},
+        {.name = "Pool Acquire", .histogram_member = &LiveDebugInfo::pool_acquire_latency},
+        {.name = "Queue Push", .histogram_member = &LiveDebugInfo::queue_push_latency},
+        {.name = "System File Write",
+         .histogram_member = &LiveDebugInfo::system_file_write_latency},
+        {.name = "Diagnostics File Write",
+         .histogram_member = &LiveDebugInfo::diagnostics_file_write_latency},
+    };
+
+    ui_->wgtDebugInfo->setupInfo<LiveDebugInfo>(live_debug_mapping, live_latency_mapping);
 }
 
-void LiveSimulationWindow::updateDiagnostics(DiagnosticsSnapshotPtr diagnostics_snapshot) {
-    if (!diagnostics_snapshot) return;
-    ui_->wgtDiagnostics->updateData(*diagnostics_snapshot);
-    ui_->oglParticleRenderer->updateCenterOfMass(diagnostics_snapshot->data->com_pos);
+void LiveSimulationWindow::updateDiagnostics(
+    std::span<const DiagnosticsSnapshotPtr> diagnostics_snapshots) {
+    if (diagnostics_snapshots.empty()) return;
+    for (const auto& diagnostics_snapshot : diagnostics_snapshots) {
+        ui_->wgtDiagnostics->updateData(*diagnostics_snapshot);
+    }
+    ui_->oglParticleRenderer->updateCenterOfMass(diagnostics_snapshots.back()->data->com_pos);
 }
 
 void LiveSimulationWindow::updateDebugInfo(int sps) {
@@ -12,7 +12,7 @@ public:
                                   QWidget *parent = nullptr);
     ~LiveSimulationWindow() override = default;
 
-    void updateDiagnostics(DiagnosticsSnapshotPtr diagnostics_snapshot) override;
+    void updateDiagnostics(std::span<const DiagnosticsSnapshotPtr> diagnostics_snapshots) override;
     void updateDebugInfo(int sps) override;
 
 private slots:
@@ -1,5 +1,6 @@
 #include "replay_simulation_window.h"
 
+#include <QCheckBox>
 #include <QPushButton>
 #include <QSlider>
 
@@ -26,6 +27,7 @@ ReplaySimulationWindow::ReplaySimulationWindow(
     ui_->btnStepForward->setVisible(enable_playback_elements);
     ui_->btnJumpToEnd->setVisible(enable_playback_elements);
     ui_->hslStepsPerSecond->setVisible(enable_playback_elements);
+    ui_->chkInterpolate->setVisible(enable_playback_elements);
     ui_->hslPlaybackBar->setEnabled(enable_playback_elements);
 
     // Setup the steps per second slider
@@ -80,6 +82,9 @@ ReplaySimulationWindow::ReplaySimulationWindow(
             &QSlider::valueChanged,
             this,
             &ReplaySimulationWindow::onStepsPerSecondChanged);
+    connect(ui_->chkInterpolate, &QCheckBox::toggled, this, [this](bool checked) {
+        emit interpolationToggled(checked);
+    });
 }
 
 void ReplaySimulationWindow::fillCharts(const DiagnosticsSeries& series) {
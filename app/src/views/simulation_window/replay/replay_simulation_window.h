@@ -42,6 +42,11 @@ signals:
      */
     void stepsPerSecondChanged(int sps);
 
+    /** @signal
+     * @brief Emitted when interpolation between snapshots is switched on or off.
+     */
+    void interpolationToggled(bool enabled);
+
     /** @signal
      * @brief Emitted when a jump is requested.
      * @param fraction The fraction to jump to (0.0 to 1.0).
@@ -3,6 +3,22 @@
 #include <QFormLayout>
 #include <QLabel>
 #include <QWidget>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace {
+/**
+ * @brief Formats a duration with a unit that keeps three significant digits readable.
+ */
+QString formatDuration(uint64_t duration_ns) {
+    const auto value = static_cast<double>(duration_ns);
+    if (duration_ns < 1'000) return QString("%1 ns").arg(duration_ns);
+    if (duration_ns < 1'000'000) return QString("%1 µs").arg(value / 1e3, 0, 'f', 1);
+    if (duration_ns < 1'000'000'000) return QString("%1 ms").arg(value / 1e6, 0, 'f', 2);
+    return QString("%1 s").arg(value / 1e9, 0, 'f', 2);
+}
+}  // namespace
 
 DebugInfoWidget::DebugInfoWidget(QWidget* parent)
     : QWidget(parent), layout_(new QFormLayout(this)) {
@@ -21,3 +37,27 @@ void DebugInfoWidget::clearInfo() {
     }
     ui_rows_.reset();
 }
+
+QLabel* DebugInfoWidget::createNameLabel(std::string_view name) {
+    auto* nameLabel = new QLabel(QString::fromStdString(std::string(name)), this);
+    QFont font = nameLabel->font();
+    font.setBold(true);
+    nameLabel->setFont(font);
+    nameLabel->setFixedHeight(nameLabel->sizeHint().height());
+    nameLabel->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
+    return nameLabel;
+}
+
+void DebugInfoWidget::setLatencyText(QLabel* label, const enkas::tracing::LatencySummary& summary) {
+    if (summary.count == 0) {
+        label->setText("No samples");
+        label->setStyleSheet("color:#888;font-style:italic;");
+        return;
+    }
+
+    if (!label->styleSheet().isEmpty()) label->setStyleSheet({});
+    label->setText(QString("p50 %1   p99 %2   max %3")
+                       .arg(formatDuration(summary.p50_ns),
+                            formatDuration(summary.p99_ns),
+                            formatDuration(summary.max_ns)));
+}
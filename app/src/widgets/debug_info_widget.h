@@ -1,5 +1,7 @@
 #pragma once
 
+#include <enkas/tracing/latency_histogram.h>
+
 #include <QtWidgets>
 #include <any>
 #include <atomic>
@@ -142,6 +144,13 @@ struct DebugInfoRow {
     bool more_is_better = false;  // If true, higher values are better
 };
 
+template <typename T>
+struct DebugLatencyRow {
+    using DebugStruct = T;
+    std::string_view name;
+    enkas::tracing::LatencyHistogram T::* histogram_member;
+};
+
 /**
  * @brief A widget that displays debug information for multiple data structures.
  */
@@ -153,21 +162,21 @@ public:
 
     void clearInfo();
 
+    /**
+     * @brief Creates a value bar for each row, followed by a percentile label for each latency
+     * row.
+     */
     template <typename T>
-    void setupInfo(std::span<const DebugInfoRow<T>> rows) {
+    void setupInfo(std::span<const DebugInfoRow<T>> rows,
+                   std::span<const DebugLatencyRow<T>> latency_rows = {}) {
         clearInfo();
 
-        std::vector<UiRow<T>> concrete_ui_rows;
-        concrete_ui_rows.reserve(rows.size());
+        UiRows<T> concrete_ui_rows;
+        concrete_ui_rows.bars.reserve(rows.size());
+        concrete_ui_rows.latencies.reserve(latency_rows.size());
 
         for (const auto& row : rows) {
-            // Name label
-            auto* nameLabel = new QLabel(QString::fromStdString(std::string(row.name)), this);
-            QFont font = nameLabel->font();
-            font.setBold(true);
-            nameLabel->setFont(font);
-            nameLabel->setFixedHeight(nameLabel->sizeHint().height());
-            nameLabel->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
+            auto* nameLabel = createNameLabel(row.name);
 
             // Value bar with custom colored progress
             auto* valueBar = new ValueBarWidget(row.more_is_better, this);
@@ -175,20 +184,33 @@ public:
 
             layout_->addRow(nameLabel, valueBar);
 
-            concrete_ui_rows.push_back(UiRow<T>{.value_bar = valueBar,
-                                                .size_member = row.size_member,
-                                                .capacity_member = row.capacity_member});
+            concrete_ui_rows.bars.push_back(UiRow<T>{.value_bar = valueBar,
+                                                     .size_member = row.size_member,
+                                                     .capacity_member = row.capacity_member});
+        }
+
+        for (const auto& row : latency_rows) {
+            auto* nameLabel = createNameLabel(row.name);
+
+            auto* percentileLabel = new QLabel(this);
+            percentileLabel->setContentsMargins(5, 0, 5, 0);
+            setLatencyText(percentileLabel, {});
+
+            layout_->addRow(nameLabel, percentileLabel);
+
+            concrete_ui_rows.latencies.push_back(UiLatencyRow<T>{
+                .percentile_label = percentileLabel, .histogram_member = row.histogram_member});
         }
 
-        ui_rows_.emplace<std::vector<UiRow<T>>>(std::move(concrete_ui_rows));
+        ui_rows_.emplace<UiRows<T>>(std::move(concrete_ui_rows));
     }
 
     template <typename T>
     void updateInfo(const T& info) {
-        if (!ui_rows_.has_value() || ui_rows_.type() != typeid(std::vector<UiRow<T>>)) return;
+        if (!ui_rows_.has_value() || ui_rows_.type() != typeid(UiRows<T>)) return;
 
-        const auto& rows = std::any_cast<const std::vector<UiRow<T>>&>(ui_rows_);
-        for (const auto& r : rows) {
+        const auto& ui_rows = std::any_cast<const UiRows<T>&>(ui_rows_);
+        for (const auto& r : ui_rows.bars) {
             size_t size = (info.*(r.size_member)).load(std::memory_order_relaxed);
             size_t cap = info.*(r.capacity_member);
 
@@ -198,6 +220,10 @@ public:
                 r.value_bar->updateValues(size, cap);
             }
         }
+
+        for (const auto& r : ui_rows.latencies) {
+            setLatencyText(r.percentile_label, (info.*(r.histogram_member)).summary());
+        }
     }
 
 private:
@@ -209,6 +235,26 @@ private:
         size_t T::* capacity_member;
     };
 
+    // A single latency row's UI data
+    template <typename T>
+    struct UiLatencyRow {
+        QLabel* percentile_label;
+        enkas::tracing::LatencyHistogram T::* histogram_member;
+    };
+
+    template <typename T>
+    struct UiRows {
+        std::vector<UiRow<T>> bars;
+        std::vector<UiLatencyRow<T>> latencies;
+    };
+
+    QLabel* createNameLabel(std::string_view name);
+
+    /**
+     * @brief Shows the median, the 99th percentile and the maximum of a latency histogram.
+     */
+    static void setLatencyText(QLabel* label, const enkas::tracing::LatencySummary& summary);
+
     std::any ui_rows_;
     QFormLayout* layout_;
     static constexpr size_t QUEUE_NOT_PRESENT = std::numeric_limits<size_t>::max();
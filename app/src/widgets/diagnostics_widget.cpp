@@ -14,7 +14,7 @@
 #include <functional>
 #include <vector>
 
-#include "core/charts/downsampling.h"
+#include "core/charts/min_max_pyramid.h"
 #include "core/dataflow/snapshot.h"
 #include "rendering/is_darkmode.h"
 
@@ -155,7 +155,7 @@ void DiagnosticsWidget::updateData(const DiagnosticsSnapshot& diagnostics) {
 
     for (size_t i = 0; i < definitions_.size(); ++i) {
         const double value = definitions_[i].value_extractor(diagnostics);
-        full_data_[i].emplace_back(timestamp, value);
+        full_data_[i].append(QPointF(timestamp, value));
 
         min_values_[i] = std::min(min_values_[i], value);
         max_values_[i] = std::max(max_values_[i], value);
@@ -202,11 +202,10 @@ void DiagnosticsWidget::refreshCharts() {
             continue;
         }
 
-        // Downsample the data for the visible chart
-        const size_t threshold = chart_view->width() * 2;
+        // Reduce the data to one bucket per pixel column, independent of the run length
+        const auto columns = static_cast<size_t>(chart_view->width());
 
-        std::vector<QPointF> downsampled_points =
-            largestTriangleThreeBuckets(full_data_[i], threshold);
+        std::vector<QPointF> downsampled_points = full_data_[i].downsample(columns);
 
         QList<QPointF> list;
         list.reserve(downsampled_points.size());
@@ -11,6 +11,7 @@
 #include <functional>
 #include <vector>
 
+#include "core/charts/min_max_pyramid.h"
 #include "core/dataflow/snapshot.h"
 
 /**
@@ -76,7 +77,8 @@ private:
     std::vector<double> min_values_;
     std::vector<double> max_values_;
 
-    std::vector<std::vector<QPointF>> full_data_;
+    // All points of each chart, with a min/max pyramid for drawing them at the chart's resolution
+    std::vector<MinMaxPyramid<QPointF>> full_data_;
 
     bool refresh_automatically_ = true;
 };
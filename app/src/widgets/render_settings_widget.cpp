@@ -74,6 +74,8 @@ RenderSettingsWidget::RenderSettingsWidget(QWidget* parent)
             &QDoubleSpinBox::valueChanged,
             this,
             &RenderSettingsWidget::settingsChanged);
+    connect(
+        ui->sbxMaxPoints, &QSpinBox::valueChanged, this, &RenderSettingsWidget::settingsChanged);
 }
 
 void RenderSettingsWidget::disableAnimationSpeed(int idx) {
@@ -107,6 +109,7 @@ void RenderSettingsWidget::loadRenderSettings(const RenderSettings& settings) {
 
     ui->sbxFOV->setValue(settings.fov);
     ui->dsbParticleSize->setValue(settings.particle_size_param);
+    ui->sbxMaxPoints->setValue(settings.max_points);
 }
 
 RenderSettings RenderSettingsWidget::getRenderSettings() const {
@@ -128,6 +131,7 @@ RenderSettings RenderSettingsWidget::getRenderSettings() const {
 
     settings.fov = ui->sbxFOV->value();
     settings.particle_size_param = ui->dsbParticleSize->value();
+    settings.max_points = ui->sbxMaxPoints->value();
 
     return settings;
 }
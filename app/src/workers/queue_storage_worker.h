@@ -1,13 +1,17 @@
 #pragma once
 
 #include <enkas/logging/logger.h>
+#include <enkas/tracing/trace.h>
 #include <qassert.h>
 
 #include <QObject>
+#include <cstddef>
 #include <functional>
 #include <memory>
+#include <span>
+#include <vector>
 
-#include "core/dataflow/blocking_queue.h"
+#include "core/dataflow/output_channel.h"
 
 class QueueStorageWorkerBase : public QObject {
     Q_OBJECT
@@ -24,12 +28,14 @@ signals:
     void workFinished();
 };
 
-template <typename SnapshotPtr>
+template <typename T>
 class QueueStorageWorker : public QueueStorageWorkerBase {
 public:
-    using SaveFn = std::function<void(const SnapshotPtr&)>;
+    using SnapshotPtr = typename OutputChannel<T>::SnapshotPtr;
+    // Called with batches of snapshots in queue order.
+    using SaveFn = std::function<void(std::span<const SnapshotPtr>)>;
 
-    QueueStorageWorker(std::shared_ptr<BlockingQueue<SnapshotPtr>> queue,
+    QueueStorageWorker(std::shared_ptr<OutputChannel<T>> queue,
                        SaveFn save_function,
                        QObject* parent = nullptr)
         : QueueStorageWorkerBase(parent),
@@ -41,30 +47,48 @@ public:
 public:
     /**
      * @brief Runs the worker, processing snapshots from the queue and saving them using the
-     * provided function. Continues until an abort signal is received in the form of a nullptr
-     * snapshot.
+     * provided function. Continues until the queue is closed and all remaining snapshots have been
+     * processed. Snapshots that are already queued are drained together and saved as one batch.
      */
     void run() override {
         ENKAS_LOG_INFO("Queue storage worker started.");
+        ENKAS_TRACE_THREAD_NAME("Storage");
+        std::vector<SnapshotPtr> batch;
+        batch.reserve(kMaxBatchSize);
         while (true) {
             auto snapshot = queue_->popBlocking();
-            if (!snapshot) break;  // sentinel on abort()
-            save_function_(snapshot);
+            if (!snapshot) break;  // queue closed by abort()
+            batch.push_back(std::move(snapshot));
+
+            while (batch.size() < kMaxBatchSize) {
+                auto next = queue_->tryPop();
+                if (!next) break;
+                batch.push_back(std::move(*next));
+            }
+
+            {
+                ENKAS_TRACE_SCOPE("Storage Write");
+                save_function_(batch);
+            }
+            batch.clear();  // Hand the snapshots back to their pools
         }
         ENKAS_LOG_INFO("Queue storage worker finished processing.");
         emit workFinished();
     }
 
     /**
-     * @brief Aborts the worker by pushing a nullptr to the queue, which will break the processing
-     * loop in run().
+     * @brief Aborts the worker by closing the queue, which will break the processing loop in run()
+     * once the queued snapshots are drained. Closing rather than pushing a sentinel keeps the
+     * queue single-producer, as this is called from a thread other than the simulation thread.
      */
     void abort() override {
         ENKAS_LOG_INFO("Aborting queue storage worker.");
-        queue_->pushBlocking(nullptr);  // sentinel to stop processing
+        queue_->close();
     }
 
 private:
-    std::shared_ptr<BlockingQueue<SnapshotPtr>> queue_;
+    static constexpr size_t kMaxBatchSize = 64;
+
+    std::shared_ptr<OutputChannel<T>> queue_;
     SaveFn save_function_;
 };
@@ -2,17 +2,72 @@
 
 #include <enkas/data/system.h>
 #include <enkas/generation/generator.h>
+#include <enkas/generation/settings_hash.h>
 #include <enkas/logging/logger.h>
+#include <enkas/math/vector3d.h>
+#include <enkas/physics/helpers.h>
 #include <enkas/simulation/simulator.h>
+#include <enkas/tracing/latency_histogram.h>
+#include <enkas/tracing/trace.h>
 
+#include <QStandardPaths>
+#include <cstddef>
+#include <filesystem>
 #include <memory>
 
 #include "core/dataflow/snapshot.h"
 #include "core/factories/generator_factory.h"
 #include "core/factories/simulator_factory.h"
+#include "core/files/file_constants.h"
+#include "core/files/initial_system_cache.h"
 #include "core/settings/settings.h"
 #include "services/file_parser/file_parser.h"
 
+namespace {
+// --- Memory pools ---
+constexpr size_t kMaxPoolBuffers = 512;
+constexpr size_t kSystemDataPoolByteBudget = size_t{1} << 30;  // 1 GiB
+// The simulator holds two system buffers and the rendering slot up to three more, so the pool
+// must always allow a few buffers on top of those to make progress.
+constexpr size_t kMinSystemDataBuffers = 8;
+// Buffers that are not held by the storage queue: the five above plus the one being acquired.
+constexpr size_t kReservedSystemDataBuffers = 6;
+
+// --- Initial system cache ---
+// Smaller systems are generated faster than they are read from disk.
+constexpr size_t kMinCachedParticles = 10000;
+static_assert(kMinCachedParticles >= enkas::simulation::Simulator::kMinHintedParticles,
+              "The simulator must use the cached potential energy of every cached system");
+
+/**
+ * @brief Estimates the heap memory used by a system with the given number of particles.
+ */
+size_t estimateSystemBytes(size_t particle_count) {
+    const size_t particle_bytes = 2 * sizeof(enkas::math::Vector3D) + sizeof(double);
+    return sizeof(enkas::data::System) + particle_count * particle_bytes;
+}
+
+/**
+ * @brief Acquires a buffer from a memory pool and records how long that took.
+ */
+template <typename Pool>
+auto timedAcquire(Pool& pool, enkas::tracing::LatencyHistogram& latency) {
+    const enkas::tracing::ScopedLatency timer(&latency);
+    return pool.acquire();
+}
+
+/**
+ * @brief Pushes a snapshot onto an output queue and records how long that took.
+ */
+template <typename Queue, typename SnapshotPtr>
+void timedPush(Queue& queue,
+               const SnapshotPtr& snapshot,
+               enkas::tracing::LatencyHistogram& latency) {
+    const enkas::tracing::ScopedLatency timer(&latency);
+    queue.push(snapshot);
+}
+}  // namespace
+
 SimulationWorker::SimulationWorker(const Settings& settings,
                                    std::shared_ptr<MemoryPools> memory_pools,
                                    std::shared_ptr<SimulationOutputs> outputs,
@@ -34,25 +89,32 @@ SimulationWorker::SimulationWorker(const Settings& settings,
         file_path_ = settings.get<std::string>(SettingKey::FilePath);
     } else {
         generator_ = GeneratorFactory::create(settings);
+
+        if (const auto generation_settings = GeneratorFactory::createSettings(settings)) {
+            cache_key_ = InitialSystemCache::Key{
+                .hash = enkas::generation::hashSettings(*generation_settings),
+                .settings = enkas::generation::serializeSettings(*generation_settings)};
+            const std::filesystem::path cache_root =
+                QStandardPaths::writableLocation(QStandardPaths::CacheLocation).toStdString();
+            system_cache_ = std::make_unique<InitialSystemCache>(cache_root /
+                                                                 file_names::initial_system_cache);
+        }
     }
 
     // Setup simulator
     simulator_ = SimulatorFactory::create(settings);
+    if (simulator_) simulator_->setForceLatency(&debug_info_->force_latency);
 
     // Setup memory pools for diagnostics data and snapshots. The system data pool will be
-    // initialized later with the particle count from the initial system.
+    // initialized later with the particle count from the initial system. All pools allocate
+    // lazily, so only the buffers that are actually needed take up memory.
+    const MemoryPoolLimits limits{.max_buffers = kMaxPoolBuffers};
     memory_pools_->diagnostics_data_pool =
-        std::make_shared<MemoryPool<enkas::data::Diagnostics>>(pool_size_);
+        std::make_shared<MemoryPool<enkas::data::Diagnostics>>(limits);
     memory_pools_->system_snapshot_pool =
-        std::make_shared<MemoryPool<Snapshot<enkas::data::System>>>(pool_size_);
+        std::make_shared<MemoryPool<Snapshot<enkas::data::System>>>(limits);
     memory_pools_->diagnostics_snapshot_pool =
-        std::make_shared<MemoryPool<Snapshot<enkas::data::Diagnostics>>>(pool_size_);
-
-    // Update debug info
-    debug_info_->system_data_pool_capacity = pool_size_;
-    debug_info_->diagnostics_data_pool_capacity = pool_size_;
-    debug_info_->system_snapshot_pool_capacity = pool_size_;
-    debug_info_->diagnostics_snapshot_pool_capacity = pool_size_;
+        std::make_shared<MemoryPool<Snapshot<enkas::data::Diagnostics>>>(limits);
 
     ENKAS_LOG_INFO("Simulation worker initialized successfully.");
 }
@@ -67,7 +129,9 @@ void SimulationWorker::startGeneration() {
             return;
         }
 
-        initial_system_ = std::make_unique<enkas::data::System>(std::move(*initial_system_opt));
+        createSystemDataPool(initial_system_opt->count());
+        initial_system_ = memory_pools_->system_data_pool->acquire();
+        *initial_system_ = std::move(*initial_system_opt);
     } else {
         // Generate the initial system using the generator
         if (!generator_) {
@@ -75,15 +139,26 @@ void SimulationWorker::startGeneration() {
             return;
         }
 
-        initial_system_ = std::make_unique<enkas::data::System>(generator_->createSystem());
+        if (const auto particle_count = generator_->particleCount()) {
+            // Read or generate straight into a pooled buffer, without any intermediate system.
+            createSystemDataPool(*particle_count);
+            initial_system_ = memory_pools_->system_data_pool->acquire();
+            if (!loadCachedSystem()) {
+                generator_->generateInto(*initial_system_);
+                initial_potential_energy_ = generator_->potentialEnergy();
+                storeCachedSystem();
+            }
+        } else {
+            auto system = generator_->createSystem();
+            createSystemDataPool(system.count());
+            initial_system_ = memory_pools_->system_data_pool->acquire();
+            *initial_system_ = std::move(system);
+            initial_potential_energy_ = generator_->potentialEnergy();
+        }
     }
 
-    // Initialize the system data pool with the particle count from the initial system
-    const size_t particle_count = initial_system_->count();
-    memory_pools_->system_data_pool =
-        std::make_shared<MemoryPool<enkas::data::System, size_t>>(pool_size_, particle_count);
-
-    ENKAS_LOG_INFO("Initial system generated successfully with {} particles.", particle_count);
+    ENKAS_LOG_INFO("Initial system generated successfully with {} particles.",
+                   initial_system_->count());
     emit generationCompleted();
 }
 
@@ -93,18 +168,72 @@ void SimulationWorker::startInitialization() {
         return;
     }
 
-    // Pass two initial data buffers to the simulator
-    auto initial_system_data = memory_pools_->system_data_pool->acquire();
-    *initial_system_data = *initial_system_;
-
+    // Pass two initial data buffers to the simulator. The initial system already lives in a
+    // pooled buffer, so it is handed over without a copy.
     auto temp_system_buffer = memory_pools_->system_data_pool->acquire();
 
-    simulator_->initialize(initial_system_data, temp_system_buffer);
+    // Models with a known or cached potential energy skip computing it over all particle pairs.
+    simulator_->setPotentialEnergyHint(initial_potential_energy_);
+
+    simulator_->initialize(std::move(initial_system_), temp_system_buffer);
 
     ENKAS_LOG_INFO("Simulator successfully initialized with the initial system.");
     emit initializationCompleted();
 }
 
+void SimulationWorker::createSystemDataPool(size_t particle_count) {
+    // Large systems get fewer buffers, so that the pool stays within its byte budget.
+    const MemoryPoolLimits system_data_limits{.max_buffers = kMaxPoolBuffers,
+                                              .byte_budget = kSystemDataPoolByteBudget,
+                                              .buffer_bytes = estimateSystemBytes(particle_count),
+                                              .min_buffers = kMinSystemDataBuffers};
+    memory_pools_->system_data_pool = std::make_shared<MemoryPool<enkas::data::System, size_t>>(
+        system_data_limits, particle_count);
+
+    // Every queued system snapshot pins a pool buffer. Spill before the queue holds so many that
+    // the next acquire() would wait for the storage writer.
+    if (outputs_->system_storage_queue) {
+        const size_t capacity = memory_pools_->system_data_pool->capacity();
+        outputs_->system_storage_queue->setSpillThreshold(
+            capacity > kReservedSystemDataBuffers ? capacity - kReservedSystemDataBuffers : 1);
+    }
+}
+
+bool SimulationWorker::loadCachedSystem() {
+    if (!system_cache_ || !cache_key_) return false;
+
+    const auto entry = system_cache_->find(*cache_key_);
+    if (!entry || entry->particle_count != initial_system_->count()) return false;
+    if (!system_cache_->read(*entry, *initial_system_)) return false;
+
+    // An analytic value does not depend on the softening, a computed one only applies to the
+    // softening it was computed with. Without either, the simulator computes it.
+    initial_potential_energy_ = generator_->potentialEnergy();
+    if (!initial_potential_energy_ && simulator_ &&
+        entry->softening_sqr == simulator_->getSofteningSqr()) {
+        initial_potential_energy_ = entry->potential_energy;
+    }
+    ENKAS_LOG_INFO("Loaded the initial system from the cache: {}", entry->path.string());
+    return true;
+}
+
+void SimulationWorker::storeCachedSystem() {
+    if (!simulator_ || !system_cache_ || !cache_key_ ||
+        initial_system_->count() < kMinCachedParticles) {
+        return;
+    }
+
+    // Without an analytic value, the potential energy is computed once here, with the softening
+    // the simulator would use, so that neither this run's simulator nor later runs with the same
+    // settings and softening have to compute it again.
+    const double softening_sqr = simulator_->getSofteningSqr();
+    if (!initial_potential_energy_) {
+        initial_potential_energy_ =
+            enkas::physics::getPotentialEnergy(*initial_system_, softening_sqr) * enkas::physics::G;
+    }
+    system_cache_->store(*cache_key_, *initial_system_, *initial_potential_energy_, softening_sqr);
+}
+
 void SimulationWorker::runSimulation() {
     if (!simulator_) {
         ENKAS_LOG_ERROR("Simulator is not initialized, cannot run simulation.");
@@ -112,12 +241,16 @@ void SimulationWorker::runSimulation() {
     }
 
     ENKAS_LOG_INFO("Starting simulation...");
+    ENKAS_TRACE_THREAD_NAME("Simulation");
 
     // Reset time and step count
     double time = 0.0;
     time_.store(time);
     debug_info_->current_step.store(0, std::memory_order_relaxed);
     while (time < duration_ && !stop_requested_.load()) {
+        ENKAS_TRACE_SCOPE("Step");
+        const enkas::tracing::ScopedLatency step_latency(&debug_info_->step_latency);
+
         const bool retrieve_system_data = (time - last_system_update_ >= system_step_);
         const bool retrieve_diagnostics_data =
             (time - last_diagnostics_update_ >= diagnostics_step_);
@@ -125,20 +258,30 @@ void SimulationWorker::runSimulation() {
         std::shared_ptr<enkas::data::System> system_data = nullptr;
         std::shared_ptr<enkas::data::Diagnostics> diagnostics_data = nullptr;
 
-        if (retrieve_system_data) {
-            system_data = memory_pools_->system_data_pool->acquire();
-        }
+        {
+            ENKAS_TRACE_SCOPE("Pool Acquire");
+            if (retrieve_system_data) {
+                system_data = timedAcquire(*memory_pools_->system_data_pool,
+                                           debug_info_->pool_acquire_latency);
+            }
 
-        if (retrieve_diagnostics_data) {
-            diagnostics_data = memory_pools_->diagnostics_data_pool->acquire();
+            if (retrieve_diagnostics_data) {
+                diagnostics_data = timedAcquire(*memory_pools_->diagnostics_data_pool,
+                                                debug_info_->pool_acquire_latency);
+            }
         }
 
-        simulator_->step(system_data, diagnostics_data);
+        {
+            ENKAS_TRACE_SCOPE("Simulator Step");
+            simulator_->step(system_data, diagnostics_data);
+        }
         time = simulator_->getSystemTime();
         time_.store(time);
 
+        ENKAS_TRACE_SCOPE("Publish");
         if (retrieve_system_data) {
-            auto system_snapshot = memory_pools_->system_snapshot_pool->acquire();
+            auto system_snapshot = timedAcquire(*memory_pools_->system_snapshot_pool,
+                                                debug_info_->pool_acquire_latency);
             system_snapshot->data = std::move(system_data);
             system_snapshot->time = time;
 
@@ -147,23 +290,30 @@ void SimulationWorker::runSimulation() {
             }
 
             if (outputs_->system_storage_queue) {
-                outputs_->system_storage_queue->pushBlocking(system_snapshot);
+                timedPush(*outputs_->system_storage_queue,
+                          system_snapshot,
+                          debug_info_->queue_push_latency);
             }
 
             last_system_update_ = time;
         }
 
         if (retrieve_diagnostics_data) {
-            auto diagnostics_snapshot = memory_pools_->diagnostics_snapshot_pool->acquire();
+            auto diagnostics_snapshot = timedAcquire(*memory_pools_->diagnostics_snapshot_pool,
+                                                     debug_info_->pool_acquire_latency);
             diagnostics_snapshot->data = std::move(diagnostics_data);
             diagnostics_snapshot->time = time;
 
             if (outputs_->chart_queue) {
-                outputs_->chart_queue->pushBlocking(diagnostics_snapshot);
+                timedPush(*outputs_->chart_queue,
+                          diagnostics_snapshot,
+                          debug_info_->queue_push_latency);
             }
 
             if (outputs_->diagnostics_storage_queue) {
-                outputs_->diagnostics_storage_queue->pushBlocking(diagnostics_snapshot);
+                timedPush(*outputs_->diagnostics_storage_queue,
+                          diagnostics_snapshot,
+                          debug_info_->queue_push_latency);
             }
 
             last_diagnostics_update_ = time;
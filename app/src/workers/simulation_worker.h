@@ -7,18 +7,21 @@
 #include <QObject>
 #include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <memory>
+#include <optional>
 
-#include "core/dataflow/blocking_queue.h"
 #include "core/dataflow/debug_info.h"
 #include "core/dataflow/latest_value_slot.h"
 #include "core/dataflow/memory_pool.h"
+#include "core/dataflow/output_channel.h"
 #include "core/dataflow/snapshot.h"
+#include "core/files/initial_system_cache.h"
 #include "core/settings/settings.h"
 
 /**
- * @brief Contains memory pools which contain pre-allocated memory for system and diagnostics data,
+ * @brief Contains memory pools which provide reusable memory for system and diagnostics data,
  * as well as snapshots of these data types. This is used to avoid frequent memory allocations and
  * deep copies during the simulation process, which can be expensive in terms of performance.
  */
@@ -32,13 +35,14 @@ struct MemoryPools {
 
 /**
  * @brief Contains shared pointers which hold snapshot pointers to generated data. This is used to
- * share data between the producer and the consumers.
+ * share data between the producer and the consumers. Each queue applies its own backpressure
+ * policy, so a slow consumer only stalls the simulation if its output is configured to block.
  */
 struct SimulationOutputs {
     std::shared_ptr<LatestValueSlot<SystemSnapshot>> rendering_snapshot = nullptr;
-    std::shared_ptr<BlockingQueue<DiagnosticsSnapshotPtr>> chart_queue = nullptr;
-    std::shared_ptr<BlockingQueue<SystemSnapshotPtr>> system_storage_queue = nullptr;
-    std::shared_ptr<BlockingQueue<DiagnosticsSnapshotPtr>> diagnostics_storage_queue = nullptr;
+    std::shared_ptr<DiagnosticsOutputChannel> chart_queue = nullptr;
+    std::shared_ptr<SystemOutputChannel> system_storage_queue = nullptr;
+    std::shared_ptr<DiagnosticsOutputChannel> diagnostics_storage_queue = nullptr;
 };
 
 /**
@@ -105,16 +109,36 @@ signals:
     void initializationCompleted();
 
 private:
+    /**
+     * @brief Creates the system data pool for systems of the given particle count.
+     */
+    void createSystemDataPool(size_t particle_count);
+
+    /**
+     * @brief Reads the initial system from the cache into the initial system buffer.
+     * @return True on a cache hit, false if the system has to be generated.
+     */
+    bool loadCachedSystem();
+
+    /**
+     * @brief Stores the generated initial system and its potential energy in the cache, computing
+     * the energy with the softening of the simulator if it has no analytic value.
+     */
+    void storeCachedSystem();
+
     std::unique_ptr<enkas::generation::Generator> generator_;
     std::unique_ptr<enkas::simulation::Simulator> simulator_;
 
     std::shared_ptr<LiveDebugInfo> debug_info_;
 
-    const size_t pool_size_ = 512;  // Default size for memory pools
     std::shared_ptr<MemoryPools> memory_pools_;
     std::shared_ptr<SimulationOutputs> outputs_;
 
-    std::unique_ptr<enkas::data::System> initial_system_;
+    std::shared_ptr<enkas::data::System> initial_system_;  // A buffer of the system data pool
+    std::optional<double> initial_potential_energy_;       // Known potential energy, including G
+
+    std::unique_ptr<InitialSystemCache> system_cache_;  // Only set for generated systems
+    std::optional<InitialSystemCache::Key> cache_key_;  // Key of the generation settings
 
     bool file_mode_;                   // Indicates if the initial system is loaded from a file
     std::filesystem::path file_path_;  // Path to the file containing the initial system
@@ -2,8 +2,35 @@
 
 #include <enkas/logging/logger.h>
 
+#include <algorithm>
+#include <thread>
+
 #include "core/dataflow/snapshot.h"
 
+namespace {
+// --- Stream Constants ---
+constexpr unsigned kMaxDecodeThreads = 8;
+
+/**
+ * @brief Uses half of the hardware threads for decoding, leaving room for rendering and the GUI.
+ */
+size_t decodeThreadCount() {
+    const unsigned hardware_threads = std::max(std::thread::hardware_concurrency(), 2u);
+    return std::min(hardware_threads / 2, kMaxDecodeThreads);
+}
+}  // namespace
+
+SystemBufferWorker::SystemBufferWorker(std::shared_ptr<SystemRingBuffer> buffer,
+                                       const std::filesystem::path& file_path,
+                                       size_t cache_capacity,
+                                       size_t max_prefetch_count,
+                                       QObject* parent)
+    : QObject(parent),
+      buffer_(std::move(buffer)),
+      file_path_(file_path),
+      stream_(std::make_unique<SystemSnapshotStream>(
+          file_path, cache_capacity, decodeThreadCount(), max_prefetch_count)) {}
+
 void SystemBufferWorker::run() {
     if (!stream_ || !stream_->initialize()) {
         ENKAS_LOG_ERROR("Failed to initialize SystemSnapshotStream for file: {}",
@@ -12,6 +39,9 @@ void SystemBufferWorker::run() {
     }
 
     while (!stop_requested_.load(std::memory_order_acquire)) {
+        // Capture the change counter before looking for work so that no wake-up is lost.
+        const auto seen_change_count = buffer_->changeCount();
+
         int steps;
         while ((steps = backward_steps_.load(std::memory_order_acquire)) > 0) {
             if (backward_steps_.compare_exchange_weak(
@@ -27,17 +57,31 @@ void SystemBufferWorker::run() {
             jump_fraction_.store(jump_unset_, std::memory_order_release);
         }
 
-        if (!stop_requested_.load(std::memory_order_acquire)) {
+        if (stop_requested_.load(std::memory_order_acquire)) break;
+
+        if (needsReadAhead()) {
             stepForward();
+            continue;
         }
+
+        // Nothing to do until the reader moves or a new request comes in.
+        if (!buffer_->waitForChange(seen_change_count)) break;
     }
 }
 
+bool SystemBufferWorker::needsReadAhead() const {
+    if (end_of_stream_ || buffer_->isFull()) return false;
+    return buffer_->aheadCount() < read_ahead_.load(std::memory_order_acquire);
+}
+
 void SystemBufferWorker::stepBackward() {
     if (auto tail_time = buffer_->tailTime()) {
         if (auto snapshot = stream_->getPrecedingSnapshot(*tail_time)) {
             bool success = buffer_->pushTail(std::make_shared<SystemSnapshot>(*snapshot));
-            if (buffer_->isFull() && success) stream_->retreatIndexIterator();
+            if (buffer_->isFull() && success) {
+                stream_->retreatIndexIterator();
+                end_of_stream_ = false;
+            }
         }
     }
 }
@@ -53,6 +97,8 @@ void SystemBufferWorker::stepForward() {
         // If pushing failed for any reason, retreat the index iterator to ensure no snapshot is
         // dropped.
         if (!success) stream_->retreatIndexIterator();
+    } else {
+        end_of_stream_ = true;
     }
 }
 
@@ -60,8 +106,15 @@ void SystemBufferWorker::jump() {
     float jump_fraction = jump_fraction_.load(std::memory_order_acquire);
     if (std::isnan(jump_fraction)) return;  // No valid jump requested
 
+    // A target that is already buffered only needs the read pointer to move.
+    if (auto timestamp = stream_->getTimestampAtFraction(jump_fraction)) {
+        if (buffer_->seekTo(*timestamp)) return;
+    }
+
+    // Otherwise restart the buffer there. Recently visited snapshots come from the stream's cache.
     if (auto snapshot = stream_->getSnapshotAtFraction(jump_fraction)) {
         last_timestamp_ = snapshot->time;
+        end_of_stream_ = false;
         buffer_->clear();  // Reset the buffer before jumping
         buffer_->pushHead(std::make_shared<SystemSnapshot>(*snapshot));
     }
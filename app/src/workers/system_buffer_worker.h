@@ -3,6 +3,7 @@
 #include <QObject>
 #include <QThread>
 #include <atomic>
+#include <cstddef>
 #include <filesystem>
 #include <limits>
 #include <memory>
@@ -12,18 +13,28 @@
 
 /**
  * @brief Worker for writing to the system ring buffer by parsing files.
+ *
+ * The worker reads ahead of the playback position by a configurable number of snapshots and
+ * sleeps on the buffer while there is nothing to do. It wakes up when the reader consumes or
+ * seeks, or when a step backward, jump or read-ahead change is requested. Snapshots ahead of
+ * the read direction are decoded in parallel by the stream's decode pool and pushed in order.
  */
 class SystemBufferWorker : public QObject {
     Q_OBJECT
 
 public:
+    /**
+     * @param buffer The ring buffer to fill.
+     * @param file_path The path to the system CSV file.
+     * @param cache_capacity The number of decoded snapshots the stream keeps in its LRU cache.
+     * @param max_prefetch_count The most snapshots the stream decodes ahead of the reader.
+     * @param parent The parent object.
+     */
     SystemBufferWorker(std::shared_ptr<SystemRingBuffer> buffer,
                        const std::filesystem::path& file_path,
-                       QObject* parent = nullptr)
-        : QObject(parent),
-          buffer_(std::move(buffer)),
-          file_path_(file_path),
-          stream_(std::make_unique<SystemSnapshotStream>(file_path)) {}
+                       size_t cache_capacity,
+                       size_t max_prefetch_count,
+                       QObject* parent = nullptr);
 
     /**
      * @brief Aborts the worker, stopping any further processing and shutting down the buffer.
@@ -36,14 +47,28 @@ public:
     /**
      * @brief Requests parsing a snapshot at the tail of the buffer and pushing it to the tail.
      */
-
-    void requestStepBackward() { backward_steps_.fetch_add(1, std::memory_order_release); }
+    void requestStepBackward() {
+        backward_steps_.fetch_add(1, std::memory_order_release);
+        buffer_->notifyWriter();
+    }
 
     /**
      * @brief Requests jumping to a specific fraction of the playback bar. This will reset the
      * buffer.
      */
-    void requestJump(float fraction) { jump_fraction_.store(fraction); }
+    void requestJump(float fraction) {
+        jump_fraction_.store(fraction);
+        buffer_->notifyWriter();
+    }
+
+    /**
+     * @brief Sets how many snapshots the worker keeps buffered ahead of the reader.
+     * @param snapshot_count The read-ahead in snapshots, limited by the buffer capacity.
+     */
+    void setReadAhead(size_t snapshot_count) {
+        read_ahead_.store(snapshot_count, std::memory_order_release);
+        buffer_->notifyWriter();
+    }
 
 public slots:
     /**
@@ -56,16 +81,19 @@ private:
     void stepBackward();
     void stepForward();
     void jump();
+    bool needsReadAhead() const;
 
     std::shared_ptr<SystemRingBuffer> buffer_;
     std::filesystem::path file_path_;
 
     std::atomic<int> backward_steps_ = 0;
     std::atomic<bool> stop_requested_ = false;
+    std::atomic<size_t> read_ahead_ = std::numeric_limits<size_t>::max();
 
     static constexpr float jump_unset_ = std::numeric_limits<float>::quiet_NaN();
     std::atomic<float> jump_fraction_ = jump_unset_;
 
     std::unique_ptr<SystemSnapshotStream> stream_ = nullptr;
     double last_timestamp_ = 0.0;
+    bool end_of_stream_ = false;
 };
\ No newline at end of file
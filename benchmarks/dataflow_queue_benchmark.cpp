@@ -0,0 +1,124 @@
+/**
+ * @brief Compares the mutex-based BlockingQueue with the lock-free SpscQueue on the simulation
+ * output path.
+ *
+ * Two scenarios are measured:
+ * - A single producer/consumer pair passing snapshot pointers as fast as possible.
+ * - One producer fanning every item out to three queues with one consumer each, which mirrors the
+ *   chart, system storage and diagnostics storage queues fed by the simulation thread.
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <format>
+#include <iostream>
+#include <memory>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "core/dataflow/blocking_queue.h"
+#include "core/dataflow/spsc_queue.h"
+
+namespace {
+// --- Benchmark parameters ---
+constexpr size_t kItemsPerRun = 2'000'000;
+constexpr size_t kPayloadCount = 1024;
+constexpr int kRepetitions = 5;
+constexpr size_t kCapacities[] = {64, 512};
+constexpr size_t kFanOut = 3;
+
+using Item = std::shared_ptr<int>;
+
+/**
+ * @brief Preallocated payloads, so the benchmark measures the queue rather than the allocator.
+ */
+std::vector<Item> makePayloads() {
+    std::vector<Item> payloads;
+    payloads.reserve(kPayloadCount);
+    for (size_t i = 0; i < kPayloadCount; ++i) {
+        payloads.push_back(std::make_shared<int>(static_cast<int>(i)));
+    }
+    return payloads;
+}
+
+/**
+ * @brief Pushes kItemsPerRun items into every queue and pops them on one thread per queue.
+ * @return The elapsed wall-clock time in seconds.
+ */
+template <typename Queue>
+double runFanOut(size_t queue_count, size_t capacity, const std::vector<Item>& payloads) {
+    std::vector<std::unique_ptr<Queue>> queues;
+    for (size_t i = 0; i < queue_count; ++i) {
+        queues.push_back(std::make_unique<Queue>(capacity));
+    }
+
+    std::vector<std::thread> consumers;
+    std::vector<size_t> checksums(queue_count, 0);
+    for (size_t i = 0; i < queue_count; ++i) {
+        consumers.emplace_back([&, i]() {
+            size_t checksum = 0;
+            for (size_t n = 0; n < kItemsPerRun; ++n) {
+                checksum += static_cast<size_t>(*queues[i]->popBlocking());
+            }
+            checksums[i] = checksum;
+        });
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t n = 0; n < kItemsPerRun; ++n) {
+        const Item& item = payloads[n % payloads.size()];
+        for (auto& queue : queues) {
+            queue->pushBlocking(item);
+        }
+    }
+    for (auto& consumer : consumers) {
+        consumer.join();
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    for (size_t checksum : checksums) {
+        if (checksum != checksums.front()) {
+            std::cerr << "Checksum mismatch between consumers.\n";
+        }
+    }
+
+    return std::chrono::duration<double>(end - start).count();
+}
+
+/**
+ * @brief Runs a scenario several times and prints the best throughput.
+ */
+template <typename Queue>
+void report(std::string_view queue_name,
+            size_t queue_count,
+            size_t capacity,
+            const std::vector<Item>& payloads) {
+    double best_seconds = 0.0;
+    for (int i = 0; i < kRepetitions; ++i) {
+        const double seconds = runFanOut<Queue>(queue_count, capacity, payloads);
+        if (i == 0 || seconds < best_seconds) best_seconds = seconds;
+    }
+
+    const double items = static_cast<double>(kItemsPerRun * queue_count);
+    std::cout << std::format("{:<14} queues={} capacity={:<4} {:>8.1f} ns/item {:>8.2f} Mitems/s\n",
+                             queue_name,
+                             queue_count,
+                             capacity,
+                             best_seconds * 1e9 / items,
+                             items / best_seconds / 1e6);
+}
+}  // namespace
+
+int main() {
+    const auto payloads = makePayloads();
+
+    for (size_t queue_count : {size_t{1}, kFanOut}) {
+        for (size_t capacity : kCapacities) {
+            report<BlockingQueue<Item>>("BlockingQueue", queue_count, capacity, payloads);
+            report<SpscQueue<Item>>("SpscQueue", queue_count, capacity, payloads);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,113 @@
+/**
+ * @brief Measures how long the producer spends in LatestValueSlot::set() while a consumer keeps
+ * taking values, compared to the previous mutex-based slot.
+ *
+ * The producer publishes at a fixed rate of 10k steps per second, like a fast simulation, and the
+ * per-call latency distribution shows whether the hand-off adds jitter to the simulation thread.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <format>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "core/dataflow/latest_value_slot.h"
+
+namespace {
+// --- Benchmark parameters ---
+constexpr int kStepsPerSecond = 10'000;
+constexpr int kStepCount = 50'000;
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief The mutex-based slot that LatestValueSlot replaced, kept as a baseline.
+ */
+template <typename T>
+class MutexSlot {
+public:
+    void set(std::shared_ptr<T> data) {
+        std::lock_guard lock(mutex_);
+        slot_ = std::move(data);
+    }
+
+    std::shared_ptr<T> take() {
+        std::lock_guard lock(mutex_);
+        return std::exchange(slot_, nullptr);
+    }
+
+private:
+    std::shared_ptr<T> slot_;
+    std::mutex mutex_;
+};
+
+/**
+ * @brief Publishes kStepCount values at kStepsPerSecond while another thread takes them in a tight
+ * loop, and prints percentiles of the time spent in set().
+ */
+template <typename Slot>
+void report(std::string_view slot_name) {
+    Slot slot;
+    std::atomic<bool> done = false;
+    size_t taken = 0;
+
+    std::thread consumer([&]() {
+        while (!done.load(std::memory_order_relaxed)) {
+            if (slot.take()) ++taken;
+        }
+    });
+
+    std::vector<std::shared_ptr<std::vector<double>>> payloads;
+    for (int i = 0; i < 8; ++i) {
+        payloads.push_back(std::make_shared<std::vector<double>>(1024, 1.0));
+    }
+
+    std::vector<double> latencies_ns;
+    latencies_ns.reserve(kStepCount);
+    const auto interval = std::chrono::nanoseconds(1'000'000'000 / kStepsPerSecond);
+    auto next_step = Clock::now();
+
+    for (int i = 0; i < kStepCount; ++i) {
+        while (Clock::now() < next_step) {
+        }
+        next_step += interval;
+
+        const auto start = Clock::now();
+        slot.set(payloads[i % payloads.size()]);
+        const auto end = Clock::now();
+        latencies_ns.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+    }
+
+    done = true;
+    consumer.join();
+
+    std::sort(latencies_ns.begin(), latencies_ns.end());
+    const auto percentile = [&](double p) {
+        return latencies_ns[static_cast<size_t>(p * (latencies_ns.size() - 1))];
+    };
+
+    std::cout << std::format(
+        "{:<16} set(): p50 {:>7.0f} ns  p99 {:>7.0f} ns  p99.9 {:>8.0f} ns  max {:>9.0f} ns  "
+        "taken {}\n",
+        slot_name,
+        percentile(0.5),
+        percentile(0.99),
+        percentile(0.999),
+        latencies_ns.back(),
+        taken);
+}
+}  // namespace
+
+int main() {
+    report<MutexSlot<std::vector<double>>>("MutexSlot");
+    report<LatestValueSlot<std::vector<double>>>("LatestValueSlot");
+    return 0;
+}
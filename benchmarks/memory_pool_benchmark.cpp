@@ -0,0 +1,153 @@
+/**
+ * @brief Compares the lock-free MemoryPool with a mutex-based pool in the shape of the simulation
+ * output path.
+ *
+ * One producer acquires a buffer per step and hands it to three consumers through SPSC queues,
+ * like the simulation thread feeding the chart, system storage and diagnostics storage queues.
+ * The last consumer to drop a buffer returns it to the pool, so acquire and return run on
+ * different threads and contend with each other.
+ */
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <format>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "core/dataflow/memory_pool.h"
+#include "core/dataflow/spsc_queue.h"
+
+namespace {
+// --- Benchmark parameters ---
+constexpr size_t kItemsPerRun = 1'000'000;
+constexpr int kRepetitions = 5;
+constexpr size_t kConsumerCount = 3;
+constexpr size_t kPoolSizes[] = {16, 512};
+constexpr size_t kQueueCapacity = 512;
+
+/**
+ * @brief A small payload comparable to a diagnostics record.
+ */
+struct Payload {
+    std::array<double, 16> values{};
+    void reset() { values[0] = 0.0; }
+};
+
+/**
+ * @brief The previous pool design, kept as a baseline: a mutex and condition variable around a
+ * queue of preallocated buffers.
+ */
+template <typename T>
+class LockedPool {
+public:
+    explicit LockedPool(size_t pool_size) {
+        for (size_t i = 0; i < pool_size; ++i) buffers_.push(new T());
+    }
+
+    ~LockedPool() {
+        while (!buffers_.empty()) {
+            delete buffers_.front();
+            buffers_.pop();
+        }
+    }
+
+    std::shared_ptr<T> acquire() {
+        std::unique_lock lock(mtx_);
+        cv_.wait(lock, [&] { return !buffers_.empty(); });
+
+        T* ptr = buffers_.front();
+        buffers_.pop();
+
+        return {ptr, [this](T* p) {
+                    p->reset();
+                    {
+                        std::scoped_lock lock(mtx_);
+                        buffers_.push(p);
+                    }
+                    cv_.notify_one();
+                }};
+    }
+
+private:
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    std::queue<T*> buffers_;
+};
+
+/**
+ * @brief Runs kItemsPerRun steps of the producer/consumer pipeline.
+ * @return The elapsed wall-clock time in seconds.
+ */
+template <typename Pool>
+double runPipeline(Pool& pool) {
+    using Item = std::shared_ptr<Payload>;
+
+    std::vector<std::unique_ptr<SpscQueue<Item>>> queues;
+    for (size_t i = 0; i < kConsumerCount; ++i) {
+        queues.push_back(std::make_unique<SpscQueue<Item>>(kQueueCapacity));
+    }
+
+    std::vector<std::thread> consumers;
+    for (size_t i = 0; i < kConsumerCount; ++i) {
+        consumers.emplace_back([&, i]() {
+            for (size_t n = 0; n < kItemsPerRun; ++n) {
+                Item item = queues[i]->popBlocking();
+            }
+        });
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t n = 0; n < kItemsPerRun; ++n) {
+        Item item = pool.acquire();
+        item->values[0] = static_cast<double>(n);
+        for (auto& queue : queues) {
+            queue->pushBlocking(item);
+        }
+    }
+    for (auto& consumer : consumers) {
+        consumer.join();
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double>(end - start).count();
+}
+
+/**
+ * @brief Runs the pipeline several times and prints the best throughput.
+ */
+template <typename Pool>
+void report(std::string_view pool_name, size_t pool_size, Pool& pool) {
+    double best_seconds = 0.0;
+    for (int i = 0; i < kRepetitions; ++i) {
+        const double seconds = runPipeline(pool);
+        if (i == 0 || seconds < best_seconds) best_seconds = seconds;
+    }
+
+    const double items = static_cast<double>(kItemsPerRun);
+    std::cout << std::format("{:<12} pool={:<4} consumers={} {:>8.1f} ns/step {:>8.2f} Msteps/s\n",
+                             pool_name,
+                             pool_size,
+                             kConsumerCount,
+                             best_seconds * 1e9 / items,
+                             items / best_seconds / 1e6);
+}
+}  // namespace
+
+int main() {
+    for (size_t pool_size : kPoolSizes) {
+        LockedPool<Payload> locked_pool(pool_size);
+        report("LockedPool", pool_size, locked_pool);
+
+        MemoryPool<Payload> lock_free_pool(MemoryPoolLimits{.max_buffers = pool_size});
+        report("MemoryPool", pool_size, lock_free_pool);
+    }
+
+    return 0;
+}
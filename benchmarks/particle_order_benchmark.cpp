@@ -0,0 +1,166 @@
+/**
+ * @brief Measures how sorting the particles along a Morton curve speeds up the Barnes-Hut
+ * simulator.
+ *
+ * Generated systems store their particles in random spatial order, so the tree build and the force
+ * walk jump around in memory. The simulator is run on a Plummer sphere with several reorder
+ * intervals, reporting the time per step and, where the kernel allows it, the cache misses per
+ * step.
+ */
+
+#include <enkas/data/system.h>
+#include <enkas/generation/generation_factory.h>
+#include <enkas/generation/generator.h>
+#include <enkas/generation/settings/plummer_sphere_settings.h>
+#include <enkas/simulation/settings/barneshutleapfrog_settings.h>
+#include <enkas/simulation/simulators/barneshutleapfrog_simulator.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+// --- Benchmark parameters ---
+constexpr int kParticleCounts[] = {20'000, 100'000};
+constexpr int kSteps = 10;
+constexpr size_t kReorderIntervals[] = {0, 1, 10, 50};
+
+/**
+ * @brief Counts the hardware cache misses of the calling thread, if perf events are available.
+ */
+class CacheMissCounter {
+public:
+    CacheMissCounter() {
+#ifdef __linux__
+        perf_event_attr attr{};
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+
+    ~CacheMissCounter() {
+#ifdef __linux__
+        if (fd_ >= 0) close(fd_);
+#endif
+    }
+
+    CacheMissCounter(const CacheMissCounter&) = delete;
+    CacheMissCounter& operator=(const CacheMissCounter&) = delete;
+
+    void start() {
+#ifdef __linux__
+        if (fd_ < 0) return;
+        ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+
+    /**
+     * @return The cache misses since start(), or std::nullopt if they cannot be counted.
+     */
+    std::optional<uint64_t> stop() {
+#ifdef __linux__
+        if (fd_ < 0) return std::nullopt;
+        ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+        uint64_t count = 0;
+        if (read(fd_, &count, sizeof(count)) != sizeof(count)) return std::nullopt;
+        return count;
+#else
+        return std::nullopt;
+#endif
+    }
+
+private:
+    int fd_ = -1;
+};
+
+struct RunResult {
+    double seconds_per_step = 0.0;
+    std::optional<uint64_t> cache_misses_per_step;
+};
+
+/**
+ * @brief Runs kSteps steps of the Barnes-Hut simulator on a copy of a system.
+ */
+RunResult run(const enkas::data::System& initial_system,
+              std::optional<double> potential_energy,
+              size_t reorder_interval) {
+    enkas::simulation::BarnesHutLeapfrogSimulator simulator(
+        {.time_step = 0.001,
+         .theta_mac = 0.5,
+         .softening_parameter = 0.001,
+         .reorder_interval = reorder_interval});
+
+    // The analytic potential energy spares the scaling a pass over all particle pairs
+    const size_t particle_count = initial_system.count();
+    simulator.setPotentialEnergyHint(potential_energy);
+    simulator.initialize(std::make_shared<enkas::data::System>(initial_system),
+                         std::make_shared<enkas::data::System>(particle_count));
+    // Alternate between two output buffers, like the pool buffers of SimulationWorker, whose
+    // previous buffer is still being published while the next step runs.
+    const std::array buffers = {std::make_shared<enkas::data::System>(particle_count),
+                                std::make_shared<enkas::data::System>(particle_count)};
+
+    CacheMissCounter cache_misses;
+    cache_misses.start();
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kSteps; ++i) simulator.step(buffers[i % buffers.size()]);
+    const auto end = std::chrono::steady_clock::now();
+    const auto misses = cache_misses.stop();
+
+    RunResult result;
+    result.seconds_per_step = std::chrono::duration<double>(end - start).count() / kSteps;
+    if (misses) result.cache_misses_per_step = *misses / kSteps;
+    return result;
+}
+
+std::string formatMisses(const std::optional<uint64_t>& misses) {
+    return misses ? std::format("{:.2f} M", static_cast<double>(*misses) / 1e6) : "n/a";
+}
+}  // namespace
+
+int main() {
+    for (const int particle_count : kParticleCounts) {
+        auto generator = enkas::generation::Factory::create(
+            enkas::generation::PlummerSphereSettings{.seed = 42,
+                                                     .particle_count = particle_count,
+                                                     .sphere_radius = 1.0,
+                                                     .total_mass = 1e6});
+        const enkas::data::System initial_system = generator->createSystem();
+        const std::optional<double> potential_energy = generator->potentialEnergy();
+
+        const RunResult baseline = run(initial_system, potential_energy, 0);
+        for (const size_t reorder_interval : kReorderIntervals) {
+            const RunResult result = reorder_interval == 0
+                                         ? baseline
+                                         : run(initial_system, potential_energy, reorder_interval);
+            std::cout << std::format(
+                "N={:<7} reorder every {:<3} {:>8.2f} ms/step {:>5.2f}x {:>10} cache misses/step\n",
+                particle_count,
+                reorder_interval == 0 ? std::string("-") : std::to_string(reorder_interval),
+                result.seconds_per_step * 1e3,
+                baseline.seconds_per_step / result.seconds_per_step,
+                formatMisses(result.cache_misses_per_step));
+        }
+    }
+
+    return 0;
+}
@@ -2,10 +2,38 @@
 
 #include <enkas/math/vector3d.h>
 
+#include <cstddef>
+#include <span>
 #include <vector>
 
 namespace enkas::data {
 
+/**
+ * @brief A non-owning view of a contiguous range of particles, e.g. of a System.
+ *
+ * Lets a range of particles be filled or modified in place, without copying them out of the
+ * buffers they live in.
+ */
+struct SystemView {
+    std::span<math::Vector3D> positions;
+    std::span<math::Vector3D> velocities;
+    std::span<double> masses;
+
+    /**
+     * @brief Returns the number of particles in the view.
+     */
+    [[nodiscard]] size_t count() const noexcept { return positions.size(); }
+
+    /**
+     * @brief Returns a view of @p particle_count particles, starting at @p offset.
+     */
+    [[nodiscard]] SystemView subview(size_t offset, size_t particle_count) const {
+        return {positions.subspan(offset, particle_count),
+                velocities.subspan(offset, particle_count),
+                masses.subspan(offset, particle_count)};
+    }
+};
+
 struct System {
     std::vector<math::Vector3D> positions;
     std::vector<math::Vector3D> velocities;
@@ -39,6 +67,12 @@ struct System {
         masses.resize(n);
     }
 
+    /**
+     * @brief Returns a view of all particles of the system.
+     * The view is invalidated when the system is resized.
+     */
+    [[nodiscard]] SystemView view() noexcept { return {positions, velocities, masses}; }
+
     bool operator==(const System& other) const {
         return positions == other.positions && velocities == other.velocities &&
                masses == other.masses;
@@ -2,6 +2,9 @@
 
 #include <enkas/data/system.h>
 
+#include <cstddef>
+#include <optional>
+
 namespace enkas::generation {
 
 class Generator {
@@ -14,6 +17,45 @@ public:
      *         of pc, solar mass, and km/s.
      */
     [[nodiscard]] virtual data::System createSystem() = 0;
+
+    /**
+     * @brief Returns the number of particles the generated system will contain, if it is known
+     *        without generating it, so that a caller can allocate the system up front.
+     */
+    [[nodiscard]] virtual std::optional<size_t> particleCount() const { return std::nullopt; }
+
+    /**
+     * @brief Generates the system into @p system, replacing its particles.
+     *
+     * Generators that know their particle count write the particles straight into the buffers of
+     * @p system, so a preallocated system, e.g. one from a memory pool, is filled without creating
+     * any intermediate system. By default, the result of createSystem() is moved into @p system.
+     *
+     * @param system The system to overwrite with the generated one.
+     */
+    virtual void generateInto(data::System& system) { system = createSystem(); }
+
+    /**
+     * @brief Returns the potential energy of the generated system, if it is known analytically.
+     *
+     * The value is the expectation for the sampled particle count, including G, in units of pc,
+     * solar mass, and km/s, and without softening. It lets a simulator scale the system to Hénon
+     * units without computing the potential energy over all particle pairs.
+     */
+    [[nodiscard]] virtual std::optional<double> potentialEnergy() const { return std::nullopt; }
+
+    /**
+     * @brief Limits the number of threads that generate particles.
+     *
+     * Every particle draws from its own random stream, keyed by the seed and the particle index,
+     * so the generated system is the same for any thread count.
+     *
+     * @param thread_count The maximum number of threads, 0 for the number of hardware threads.
+     */
+    void setThreadCount(size_t thread_count) { thread_count_ = thread_count; }
+
+protected:
+    size_t thread_count_ = 0;
 };
 
 }  // namespace enkas::generation
@@ -1,19 +1,43 @@
 #pragma once
 
 #include <enkas/data/system.h>
-#include <enkas/generation/generator.h>
+#include <enkas/generation/generators/plummer_sphere_generator.h>
+#include <enkas/generation/particle_generator.h>
 #include <enkas/generation/settings/collision_model_settings.h>
 
+#include <cstddef>
+#include <optional>
+#include <string_view>
+
 namespace enkas::generation {
 
-class CollisionModelGenerator : public Generator {
+/**
+ * @brief Generates two Plummer spheres on a collision course.
+ *
+ * The first sphere occupies the first particle_count_1 particles, the second one the rest. Both are
+ * generated directly into their part of the system, without building a system per sphere.
+ */
+class CollisionModelGenerator : public ParticleGenerator {
 public:
     explicit CollisionModelGenerator(const CollisionModelSettings& settings);
 
-    [[nodiscard]] data::System createSystem() override;
+    [[nodiscard]] std::optional<size_t> particleCount() const override;
+
+    void generateRange(const data::SystemView& particles, size_t first_index) const override;
+
+    /**
+     * @brief Centers each sphere, moves them apart and onto their trajectories, and centers the
+     *        whole system.
+     */
+    void finalize(const data::SystemView& particles) const override;
+
+protected:
+    [[nodiscard]] std::string_view name() const override { return "CollisionModel"; }
 
 private:
     CollisionModelSettings settings_;
+    PlummerSphereGenerator sphere1_;
+    PlummerSphereGenerator sphere2_;
 };
 
 }  // namespace enkas::generation
\ No newline at end of file
@@ -1,16 +1,25 @@
 #pragma once
 
 #include <enkas/data/system.h>
-#include <enkas/generation/generator.h>
+#include <enkas/generation/particle_generator.h>
 #include <enkas/generation/settings/normal_sphere_settings.h>
 
+#include <cstddef>
+#include <optional>
+#include <string_view>
+
 namespace enkas::generation {
 
-class NormalSphereGenerator : public Generator {
+class NormalSphereGenerator : public ParticleGenerator {
 public:
     explicit NormalSphereGenerator(const NormalSphereSettings& settings);
 
-    [[nodiscard]] data::System createSystem() override;
+    [[nodiscard]] std::optional<size_t> particleCount() const override;
+
+    void generateRange(const data::SystemView& particles, size_t first_index) const override;
+
+protected:
+    [[nodiscard]] std::string_view name() const override { return "NormalSphere"; }
 
 private:
     NormalSphereSettings settings_;
@@ -1,24 +1,33 @@
 #pragma once
 
 #include <enkas/data/system.h>
-#include <enkas/generation/generator.h>
+#include <enkas/generation/particle_generator.h>
 #include <enkas/generation/settings/plummer_sphere_settings.h>
 
+#include <cstddef>
+#include <optional>
+#include <string_view>
+
 namespace enkas::generation {
 
-class PlummerSphereGenerator : public Generator {
+class PlummerSphereGenerator : public ParticleGenerator {
 public:
     explicit PlummerSphereGenerator(const PlummerSphereSettings& settings);
 
+    [[nodiscard]] std::optional<size_t> particleCount() const override;
+
+    [[nodiscard]] std::optional<double> potentialEnergy() const override;
+
     /**
-     * @brief Generates a system of particles following the Plummer sphere distribution.
+     * @brief Generates particles following the Plummer sphere distribution.
      *
      * Uses the algorithm provided by Aarseth et. al. in Astronomy and Astrophysics,
      * vol. 37, no. 1, Dec. 1974, p. 183-187.
-     *
-     * @return A System object containing the generated particles.
      */
-    [[nodiscard]] data::System createSystem() override;
+    void generateRange(const data::SystemView& particles, size_t first_index) const override;
+
+protected:
+    [[nodiscard]] std::string_view name() const override { return "PlummerSphere"; }
 
 private:
     PlummerSphereSettings settings_;
@@ -1,16 +1,30 @@
 #pragma once
 
 #include <enkas/data/system.h>
-#include <enkas/generation/generator.h>
+#include <enkas/generation/particle_generator.h>
 #include <enkas/generation/settings/spiral_galaxy_settings.h>
 
+#include <cstddef>
+#include <optional>
+#include <string_view>
+
 namespace enkas::generation {
 
-class SpiralGalaxyGenerator : public Generator {
+class SpiralGalaxyGenerator : public ParticleGenerator {
 public:
     explicit SpiralGalaxyGenerator(const SpiralGalaxySettings& settings);
 
-    [[nodiscard]] data::System createSystem() override;
+    [[nodiscard]] std::optional<size_t> particleCount() const override;
+
+    void generateRange(const data::SystemView& particles, size_t first_index) const override;
+
+    /**
+     * @brief Centers the disk, leaving the black hole, the last particle, at the origin.
+     */
+    void finalize(const data::SystemView& particles) const override;
+
+protected:
+    [[nodiscard]] std::string_view name() const override { return "SpiralGalaxy"; }
 
 private:
     SpiralGalaxySettings settings_;
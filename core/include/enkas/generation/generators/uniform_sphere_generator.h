@@ -1,16 +1,27 @@
 #pragma once
 
 #include <enkas/data/system.h>
-#include <enkas/generation/generator.h>
+#include <enkas/generation/particle_generator.h>
 #include <enkas/generation/settings/uniform_sphere_settings.h>
 
+#include <cstddef>
+#include <optional>
+#include <string_view>
+
 namespace enkas::generation {
 
-class UniformSphereGenerator : public Generator {
+class UniformSphereGenerator : public ParticleGenerator {
 public:
     explicit UniformSphereGenerator(const UniformSphereSettings& settings);
 
-    [[nodiscard]] data::System createSystem() override;
+    [[nodiscard]] std::optional<size_t> particleCount() const override;
+
+    [[nodiscard]] std::optional<double> potentialEnergy() const override;
+
+    void generateRange(const data::SystemView& particles, size_t first_index) const override;
+
+protected:
+    [[nodiscard]] std::string_view name() const override { return "UniformSphere"; }
 
 private:
     UniformSphereSettings settings_;
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace enkas::generation {
+
+/**
+ * @brief Below this many cheap items per thread, starting a thread costs more than it saves.
+ */
+inline constexpr size_t kMinItemsPerThread = 4096;
+
+/**
+ * @brief Calls @p body for contiguous ranges that together cover [0, count), spread over threads.
+ *
+ * The ranges are processed concurrently, so @p body must only write to data of its own range.
+ * Counts too small to be worth a thread run on the calling thread.
+ *
+ * @param count The number of items.
+ * @param body Called with the begin and end index of each range.
+ * @param thread_count The maximum number of threads, 0 for the number of hardware threads.
+ * @param min_items_per_thread The smallest number of items worth a thread of its own.
+ */
+void parallelFor(size_t count,
+                 const std::function<void(size_t begin, size_t end)>& body,
+                 size_t thread_count = 0,
+                 size_t min_items_per_thread = kMinItemsPerThread);
+
+}  // namespace enkas::generation
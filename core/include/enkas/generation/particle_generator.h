@@ -0,0 +1,63 @@
+#pragma once
+
+#include <enkas/data/system.h>
+#include <enkas/generation/generator.h>
+
+#include <cstddef>
+#include <string_view>
+
+namespace enkas::generation {
+
+/**
+ * @brief A generator whose particles only depend on the settings and their own index.
+ *
+ * Any range of particles can therefore be generated on its own, in any order and on any thread,
+ * directly into the memory it ends up in. Particles are first generated range by range and then
+ * finalized together, e.g. centered, once all of them exist.
+ */
+class ParticleGenerator : public Generator {
+public:
+    /**
+     * @brief Creates a new system by generating into an empty one.
+     */
+    [[nodiscard]] data::System createSystem() override;
+
+    /**
+     * @brief Resizes @p system to particleCount() and generates the particles in place.
+     * Reuses the capacity of @p system, so a pooled system is filled without reallocating.
+     */
+    void generateInto(data::System& system) override;
+
+    /**
+     * @brief Generates all particles into caller-provided buffers, in parallel.
+     * @param particles The buffers to fill, which must hold exactly particleCount() particles.
+     * @return True if the particles were generated, false if the view has the wrong size.
+     */
+    [[nodiscard]] bool generateInto(const data::SystemView& particles) const;
+
+    /**
+     * @brief Generates the particles [first_index, first_index + particles.count()) without
+     *        finalizing them.
+     *
+     * Generating all particles in one call or in several disjoint ranges gives the same result.
+     * Safe to call concurrently for disjoint ranges.
+     *
+     * @param particles The buffers the range of particles is written to.
+     * @param first_index The index of the first particle of the range within the whole system.
+     */
+    virtual void generateRange(const data::SystemView& particles, size_t first_index) const = 0;
+
+    /**
+     * @brief Post-processes the whole system once all particles are generated.
+     * Centers the system by default.
+     */
+    virtual void finalize(const data::SystemView& particles) const;
+
+protected:
+    /**
+     * @brief Returns the name of the model, for logging.
+     */
+    [[nodiscard]] virtual std::string_view name() const = 0;
+};
+
+}  // namespace enkas::generation
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <enkas/generation/generation_settings.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace enkas::generation {
+
+/**
+ * @brief The version of the generation algorithms.
+ * Bump it whenever a generator produces different particles for the same settings, so that systems
+ * cached under the old version are no longer found.
+ */
+inline constexpr uint32_t kGeneratorVersion = 1;
+
+/**
+ * @brief Serializes generation settings together with kGeneratorVersion into a canonical byte
+ * string.
+ *
+ * The bytes only depend on the model and the values of its settings, field by field, so they are
+ * stable across runs. Equal bytes mean equal settings, and settings of different models always
+ * differ, even if their values are the same.
+ *
+ * @param settings The settings of any generator.
+ * @return The version, the index of the model and the values of its settings.
+ */
+[[nodiscard]] std::vector<std::byte> serializeSettings(const Settings& settings);
+
+/**
+ * @brief Hashes the canonical bytes of generation settings (see serializeSettings()).
+ *
+ * The hash is stable across runs, so it can name systems stored on disk. Like any 64-bit hash it
+ * may collide for different settings, so whoever keys data by it must also compare the bytes of
+ * serializeSettings() before trusting a match.
+ *
+ * @param settings The settings of any generator.
+ * @return A 64-bit FNV-1a hash.
+ */
+[[nodiscard]] uint64_t hashSettings(const Settings& settings);
+
+}  // namespace enkas::generation
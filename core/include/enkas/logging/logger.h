@@ -1,20 +1,47 @@
 #pragma once
 
+#include <enkas/logging/mpsc_queue.h>
+
+#include <atomic>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <format>
 #include <memory>
 #include <mutex>
 #include <source_location>
+#include <string>
 #include <string_view>
+#include <thread>
+
+/**
+ * @brief The lowest log level that is compiled in, as the numeric value of a LogLevel.
+ * Defaults to INFO in release builds, so TRACE and DEBUG messages cost nothing there.
+ */
+#ifndef ENKAS_LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define ENKAS_LOG_MIN_LEVEL 2
+#else
+#define ENKAS_LOG_MIN_LEVEL 0
+#endif
+#endif
 
 namespace enkas::logging {
 
 enum class LogLevel { TRACE, DEBUG, INFO, WARNING, ERROR, CRITICAL, NONE };
 
+inline constexpr LogLevel kMinLogLevel = static_cast<LogLevel>(ENKAS_LOG_MIN_LEVEL);
+
 class LogSink {
 public:
     virtual ~LogSink() = default;
     virtual void log(LogLevel level, std::string_view message) = 0;
+
+    /**
+     * @brief Pushes buffered messages to their destination.
+     * Called after every batch of messages, instead of after every single message.
+     */
+    virtual void flush() {}
 };
 
 /**
@@ -55,43 +82,77 @@ inline std::string_view logLevelToString(LogLevel level) {
     return "UNKNOWN";
 }
 
+/**
+ * @brief A log message waiting to be written to the sink.
+ */
+struct LogRecord {
+    LogLevel level = LogLevel::NONE;
+    std::chrono::system_clock::time_point time;
+    const char* file = "";  // From std::source_location, which has static storage duration
+    uint_least32_t line = 0;
+    std::string message;
+};
+
+/**
+ * @brief An asynchronous logger.
+ *
+ * The calling thread only checks the level with a relaxed atomic load, formats the message
+ * arguments and pushes a record onto a lock-free queue. Timestamps, the record prefix and the
+ * sink are handled by a writer thread, which is started by the first call to configure(). If the
+ * queue is full, records are dropped and the writer reports how many.
+ *
+ * CRITICAL records bypass the queue: the calling thread writes the queued records and then its own
+ * record, and flushes the sink before the call returns, so that the record is not lost if the
+ * process terminates right after.
+ *
+ * Messages below ENKAS_LOG_MIN_LEVEL are removed at compile time.
+ */
 class Logger {
 public:
-    void configure(LogLevel level, std::shared_ptr<LogSink> sink) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        level_ = level;
-        sink_ = std::move(sink);
+    Logger();
+    ~Logger();
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    /**
+     * @brief Sets the level and the sink. Records logged before the call go to the old sink.
+     */
+    void configure(LogLevel level, std::shared_ptr<LogSink> sink);
+
+    /**
+     * @brief Blocks until every record logged so far has been written to the sink.
+     */
+    void flush();
+
+    /**
+     * @brief Returns whether messages of the given level are currently logged.
+     */
+    [[nodiscard]] bool isEnabled(LogLevel level) const {
+        return level >= kMinLogLevel && level >= level_.load(std::memory_order_relaxed);
     }
 
+    /**
+     * @brief Returns the number of records dropped so far because the queue was full.
+     */
+    [[nodiscard]] size_t dropped() const { return dropped_total_.load(std::memory_order_relaxed); }
+
     template <typename... Args>
     void log(LogLevel level,
              const std::source_location& loc,
              const std::format_string<Args...>& fmt,
              Args&&... args) {
-        LogLevel current_level;
-        std::shared_ptr<LogSink> current_sink;
-
-        {
-            std::lock_guard<std::mutex> lock(mutex_);
-            current_level = level_;
-            current_sink = sink_;
-        }
-
-        if (level < current_level || !current_sink) {
+        if (!isEnabled(level)) {
             return;
         }
 
-        auto const time_now = std::chrono::system_clock::now();
-
-        auto formatted_message =
-            std::format("[{:%Y-%m-%d %H:%M:%S}] [{}:{}] [{}] {}",
-                        time_now,
-                        get_filename(loc.file_name()),
-                        loc.line(),
-                        logLevelToString(level),
-                        std::vformat(fmt.get(), std::make_format_args(args...)));
-
-        current_sink->log(level, formatted_message);
+        // The arguments are formatted here, because they may refer to data that does not outlive
+        // the call. Everything else is left to the writer thread.
+        enqueue({.level = level,
+                 .time = std::chrono::system_clock::now(),
+                 .file = loc.file_name(),
+                 .line = loc.line(),
+                 .message = std::vformat(fmt.get(), std::make_format_args(args...))});
     }
 
     template <typename... Args>
@@ -137,9 +198,42 @@ public:
     }
 
 private:
-    std::mutex mutex_;
-    LogLevel level_ = LogLevel::NONE;
+    static constexpr size_t kQueueCapacity = 8192;
+
+    void enqueue(LogRecord&& record);
+    void writeLoop();
+
+    /**
+     * @brief Writes all queued records to the sink. Called by the writer thread.
+     * @return The number of records taken from the queue.
+     */
+    size_t writeQueued();
+
+    /**
+     * @brief Writes the queued records and then @p record to the sink, and flushes it.
+     * Called by the logging thread for records that must not wait for the writer thread.
+     */
+    void writeNow(const LogRecord& record);
+
+    /**
+     * @brief Like writeQueued(), for callers that already hold the sink mutex.
+     */
+    size_t writeQueuedLocked();
+
+    std::atomic<LogLevel> level_ = LogLevel::NONE;
+    MpscQueue<LogRecord> queue_{kQueueCapacity};
+
+    // Bumped after every push, the writer thread sleeps on it while the queue is empty.
+    std::atomic<uint32_t> published_ = 0;
+    std::atomic<bool> writer_is_waiting_ = false;
+    std::atomic<size_t> written_ = 0;  // Records taken from the queue so far
+    std::atomic<size_t> dropped_ = 0;  // Dropped records not reported yet
+    std::atomic<size_t> dropped_total_ = 0;
+
+    std::mutex sink_mutex_;  // Taken by configure(), the writer thread and CRITICAL log() calls
     std::shared_ptr<LogSink> sink_;
+    std::thread writer_;
+    std::atomic<bool> is_shutting_down_ = false;
 };
 
 /**
@@ -157,16 +251,19 @@ inline Logger& getLogger() {
 // These macros allow for easy logging without needing to specify the source location manually.
 // Instead of passing the source location, they automatically use the current source location.
 // Additionally, no need to take a reference to the logger.
+// Below ENKAS_LOG_MIN_LEVEL, neither the call nor its arguments are compiled in.
+
+#define ENKAS_LOG_AT(level, method, fmt, ...)                                              \
+    do {                                                                                   \
+        if constexpr (enkas::logging::LogLevel::level >= enkas::logging::kMinLogLevel) {   \
+            enkas::logging::getLogger().method(                                            \
+                std::source_location::current(), fmt, ##__VA_ARGS__);                      \
+        }                                                                                  \
+    } while (false)
 
-#define ENKAS_LOG_TRACE(fmt, ...) \
-    enkas::logging::getLogger().trace(std::source_location::current(), fmt, ##__VA_ARGS__)
-#define ENKAS_LOG_DEBUG(fmt, ...) \
-    enkas::logging::getLogger().debug(std::source_location::current(), fmt, ##__VA_ARGS__)
-#define ENKAS_LOG_INFO(fmt, ...) \
-    enkas::logging::getLogger().info(std::source_location::current(), fmt, ##__VA_ARGS__)
-#define ENKAS_LOG_WARNING(fmt, ...) \
-    enkas::logging::getLogger().warning(std::source_location::current(), fmt, ##__VA_ARGS__)
-#define ENKAS_LOG_ERROR(fmt, ...) \
-    enkas::logging::getLogger().error(std::source_location::current(), fmt, ##__VA_ARGS__)
-#define ENKAS_LOG_CRITICAL(fmt, ...) \
-    enkas::logging::getLogger().critical(std::source_location::current(), fmt, ##__VA_ARGS__)
+#define ENKAS_LOG_TRACE(fmt, ...) ENKAS_LOG_AT(TRACE, trace, fmt, ##__VA_ARGS__)
+#define ENKAS_LOG_DEBUG(fmt, ...) ENKAS_LOG_AT(DEBUG, debug, fmt, ##__VA_ARGS__)
+#define ENKAS_LOG_INFO(fmt, ...) ENKAS_LOG_AT(INFO, info, fmt, ##__VA_ARGS__)
+#define ENKAS_LOG_WARNING(fmt, ...) ENKAS_LOG_AT(WARNING, warning, fmt, ##__VA_ARGS__)
+#define ENKAS_LOG_ERROR(fmt, ...) ENKAS_LOG_AT(ERROR, error, fmt, ##__VA_ARGS__)
+#define ENKAS_LOG_CRITICAL(fmt, ...) ENKAS_LOG_AT(CRITICAL, critical, fmt, ##__VA_ARGS__)
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace enkas::logging {
+
+/**
+ * @brief A bounded, lock-free multi-producer/single-consumer queue.
+ *
+ * Every slot carries a sequence number that tells producers and the consumer whose turn it is, so
+ * a push is one compare-and-swap on the shared write index plus a release store, and a pop never
+ * touches an index shared with the producers. A full queue rejects the push instead of blocking.
+ *
+ * @tparam T The element type. Must be default-constructible and move-assignable.
+ */
+template <typename T>
+class MpscQueue {
+public:
+    /**
+     * @brief Constructs a queue with room for at least @p capacity elements.
+     * The capacity is rounded up to a power of two.
+     */
+    explicit MpscQueue(size_t capacity)
+        : capacity_(std::bit_ceil(std::max<size_t>(capacity, 2))),
+          mask_(capacity_ - 1),
+          slots_(std::make_unique<Slot[]>(capacity_)) {
+        for (size_t i = 0; i < capacity_; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    /**
+     * @brief Appends an element. Safe to call from any number of threads.
+     * @return False if the queue is full, in which case @p value is left untouched.
+     */
+    bool tryPush(T&& value) {
+        size_t pos = write_index_.load(std::memory_order_relaxed);
+        while (true) {
+            Slot& slot = slots_[pos & mask_];
+            const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+            if (diff == 0) {
+                // The slot is free for this position, claim it.
+                if (write_index_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.value = std::move(value);
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // The slot still holds the element from one lap ago
+            } else {
+                pos = write_index_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Removes the oldest element. Must only be called from the consumer thread.
+     * @return False if the queue is empty, or if the oldest element is still being written.
+     */
+    bool tryPop(T& out) {
+        Slot& slot = slots_[read_index_ & mask_];
+        if (slot.sequence.load(std::memory_order_acquire) != read_index_ + 1) return false;
+
+        out = std::move(slot.value);
+        slot.sequence.store(read_index_ + capacity_, std::memory_order_release);
+        ++read_index_;
+        return true;
+    }
+
+    /**
+     * @brief Returns the number of pushes so far, including ones that are still being written.
+     */
+    [[nodiscard]] size_t pushCount() const { return write_index_.load(std::memory_order_acquire); }
+
+    [[nodiscard]] size_t capacity() const { return capacity_; }
+
+private:
+    static constexpr size_t kCacheLineSize = 64;
+
+    struct Slot {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    const size_t capacity_;
+    const size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+
+    alignas(kCacheLineSize) std::atomic<size_t> write_index_ = 0;  // Shared by the producers
+    alignas(kCacheLineSize) size_t read_index_ = 0;                // Owned by the consumer
+};
+
+}  // namespace enkas::logging
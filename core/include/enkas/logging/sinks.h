@@ -11,7 +11,8 @@ namespace enkas::logging {
 
 /**
  * @brief A thread-safe sink that writes log messages to the console.
- * Writes WARNING and above to std::cerr, and lower levels to std::cout.
+ * Writes WARNING and above to std::cerr, and lower levels to std::cout. Standard output is only
+ * flushed once per batch of messages.
  */
 class ConsoleSink : public LogSink {
 public:
@@ -19,12 +20,18 @@ public:
         // Lock to prevent garbled output from multiple threads writing at once.
         std::lock_guard<std::mutex> lock(mutex_);
         if (level >= LogLevel::WARNING) {
-            std::cerr << message << std::endl;
+            std::cerr << message << '\n';
         } else {
-            std::cout << message << std::endl;
+            std::cout << message << '\n';
         }
     }
 
+    void flush() override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::cout.flush();
+        std::cerr.flush();
+    }
+
 private:
     std::mutex mutex_;
 };
@@ -59,6 +66,13 @@ public:
         }
     }
 
+    void flush() override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& sink : sinks_) {
+            sink->flush();
+        }
+    }
+
 private:
     std::mutex mutex_;
     std::vector<std::shared_ptr<LogSink>> sinks_;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <enkas/math/philox.h>
 #include <enkas/math/vector3d.h>
 
 #include <numbers>
@@ -29,4 +30,21 @@ inline math::Vector3D getRandOnSphere(std::mt19937& gen, double norm = 1.0) noex
     return Vector3D{r * std::cos(phi), r * std::sin(phi), z} * norm;
 }
 
+/**
+ * @brief Generate a random 3D vector on the surface of a sphere from a counter-based stream.
+ *
+ * Same distribution as the overload above, but the result only depends on the state of @p rng,
+ * not on the standard library's distributions.
+ *
+ * @param norm The desired magnitude (norm) of the generated vector.
+ * @return A Vector3D representing a random vector on the sphere's surface, scaled by 'norm'.
+ */
+inline math::Vector3D getRandOnSphere(CounterRng& rng, double norm = 1.0) noexcept {
+    const double z = rng.uniform(-1.0, 1.0);
+    const double phi = rng.uniform(0.0, 2 * std::numbers::pi);
+    const double r = std::sqrt(1.0 - z * z);
+
+    return Vector3D{r * std::cos(phi), r * std::sin(phi), z} * norm;
+}
+
 }  // namespace enkas::math
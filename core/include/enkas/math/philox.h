@@ -0,0 +1,113 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+
+namespace enkas::math {
+
+/**
+ * @brief The Philox-4x32-10 block function: encrypts a 128-bit counter with a 64-bit key.
+ *
+ * Every distinct counter gives four independent, uniformly distributed 32-bit words, so random
+ * numbers can be computed in any order and on any thread without sharing state.
+ *
+ * @see Salmon, J. K. et al.; 2011; Parallel Random Numbers: As Easy as 1, 2, 3
+ */
+[[nodiscard]] constexpr std::array<uint32_t, 4> philox4x32(std::array<uint32_t, 4> counter,
+                                                          std::array<uint32_t, 2> key) noexcept {
+    constexpr uint64_t kMultiplier0 = 0xD2511F53;
+    constexpr uint64_t kMultiplier1 = 0xCD9E8D57;
+    constexpr uint32_t kWeyl0 = 0x9E3779B9;
+    constexpr uint32_t kWeyl1 = 0xBB67AE85;
+    constexpr int kRounds = 10;
+
+    for (int round = 0; round < kRounds; ++round) {
+        const uint64_t product0 = kMultiplier0 * counter[0];
+        const uint64_t product1 = kMultiplier1 * counter[2];
+        counter = {static_cast<uint32_t>(product1 >> 32) ^ counter[1] ^ key[0],
+                   static_cast<uint32_t>(product1),
+                   static_cast<uint32_t>(product0 >> 32) ^ counter[3] ^ key[1],
+                   static_cast<uint32_t>(product0)};
+        key[0] += kWeyl0;
+        key[1] += kWeyl1;
+    }
+    return counter;
+}
+
+/**
+ * @brief A stream of random numbers identified by a seed and a stream index.
+ *
+ * The numbers are the Philox outputs for successive counters within the stream, so the stream of
+ * a particle only depends on the seed and the index of the particle. Generators that give every
+ * particle its own stream produce identical systems no matter how the particles are split across
+ * threads. The distributions are implemented here rather than taken from <random>, whose results
+ * differ between standard libraries.
+ *
+ * Satisfies UniformRandomBitGenerator.
+ */
+class CounterRng {
+public:
+    using result_type = uint32_t;
+
+    constexpr CounterRng(uint64_t seed, uint64_t stream) noexcept
+        : key_{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)},
+          stream_{static_cast<uint32_t>(stream), static_cast<uint32_t>(stream >> 32)} {}
+
+    [[nodiscard]] static constexpr result_type min() noexcept { return 0; }
+    [[nodiscard]] static constexpr result_type max() noexcept {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    /**
+     * @brief Returns the next 32 random bits of the stream.
+     */
+    constexpr result_type operator()() noexcept {
+        if (lane_ == block_.size()) {
+            block_ = philox4x32({static_cast<uint32_t>(block_index_),
+                                 static_cast<uint32_t>(block_index_ >> 32),
+                                 stream_[0],
+                                 stream_[1]},
+                                key_);
+            ++block_index_;
+            lane_ = 0;
+        }
+        return block_[lane_++];
+    }
+
+    /**
+     * @brief Returns a uniformly distributed number in [0, 1) with 53 random bits.
+     */
+    double uniform() noexcept {
+        const uint64_t high = (*this)() >> 5;  // 27 bits
+        const uint64_t low = (*this)() >> 6;   // 26 bits
+        return static_cast<double>((high << 26) | low) * 0x1.0p-53;
+    }
+
+    /**
+     * @brief Returns a uniformly distributed number in [min, max).
+     */
+    double uniform(double min, double max) noexcept { return min + (max - min) * uniform(); }
+
+    /**
+     * @brief Returns a normally distributed number, using the Box-Muller transform.
+     */
+    double normal(double mean, double std_dev) noexcept {
+        const double u1 = 1.0 - uniform();  // In (0, 1], so the logarithm is finite
+        const double u2 = uniform();
+        const double radius = std::sqrt(-2.0 * std::log(u1));
+        return mean + std_dev * radius * std::cos(2.0 * std::numbers::pi * u2);
+    }
+
+private:
+    std::array<uint32_t, 2> key_;
+    std::array<uint32_t, 2> stream_;
+    uint64_t block_index_ = 0;
+    std::array<uint32_t, 4> block_{};
+    size_t lane_ = 4;  // Index of the next unused word of block_
+};
+
+}  // namespace enkas::math
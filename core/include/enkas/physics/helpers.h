@@ -70,6 +70,22 @@ inline double getPotentialEnergy(const data::System& system, double softening_pa
     return potential_energy;
 }
 
+/**
+ * @brief Returns the expected potential energy of N equal-mass particles sampled from a density.
+ *
+ * The particles only interact in distinct pairs, so the energy of the sample lacks the
+ * self-interaction of the continuous density and is smaller by a factor of (N - 1) / N.
+ *
+ * @param continuum_energy The potential energy of the continuous density.
+ * @param particle_count The number of sampled particles N.
+ */
+[[nodiscard]] inline double getSampledPotentialEnergy(double continuum_energy,
+                                                      size_t particle_count) noexcept {
+    if (particle_count == 0) return 0.0;
+    const double n = static_cast<double>(particle_count);
+    return continuum_energy * (n - 1.0) / n;
+}
+
 /**
  * @brief Calculates the total angular momentum of a system.
  * @param system The system containing the particles.
@@ -102,14 +118,13 @@ struct CenterOfMass {
     math::Vector3D velocity;
 };
 
+namespace detail {
 /**
- * @brief Calculates the center of mass position and velocity for a system.
- * @param system The system to analyze.
- * @return A CenterOfMass struct containing the calculated properties.
- *         Returns a zeroed struct if the total mass is zero.
+ * @brief Calculates the center of mass of a System or a SystemView.
  */
-[[nodiscard]] inline CenterOfMass getCenterOfMass(const data::System& system) {
-    const size_t particle_count = system.count();
+template <typename Particles>
+[[nodiscard]] CenterOfMass centerOfMass(const Particles& particles) {
+    const size_t particle_count = particles.count();
     if (particle_count == 0) return {};
 
     math::Vector3D weighted_pos_sum;
@@ -117,9 +132,9 @@ struct CenterOfMass {
     double total_mass = 0.0;
 
     for (size_t i = 0; i < particle_count; ++i) {
-        const double mass = system.masses[i];
-        weighted_pos_sum += system.positions[i] * mass;
-        weighted_vel_sum += system.velocities[i] * mass;
+        const double mass = particles.masses[i];
+        weighted_pos_sum += particles.positions[i] * mass;
+        weighted_vel_sum += particles.velocities[i] * mass;
         total_mass += mass;
     }
 
@@ -131,24 +146,49 @@ struct CenterOfMass {
 
     return com;
 }
+}  // namespace detail
 
 /**
- * @brief Translates a system so its center of mass is at the origin (0,0,0)
+ * @brief Calculates the center of mass position and velocity for a system.
+ * @param system The system to analyze.
+ * @return A CenterOfMass struct containing the calculated properties.
+ *         Returns a zeroed struct if the total mass is zero.
+ */
+[[nodiscard]] inline CenterOfMass getCenterOfMass(const data::System& system) {
+    return detail::centerOfMass(system);
+}
+
+/**
+ * @brief Calculates the center of mass position and velocity for a range of particles.
+ */
+[[nodiscard]] inline CenterOfMass getCenterOfMass(const data::SystemView& particles) {
+    return detail::centerOfMass(particles);
+}
+
+/**
+ * @brief Translates a range of particles so its center of mass is at the origin (0,0,0)
  *        and its total momentum is zero.
- * @param system The system containing the particles to be centered.
+ * @param particles The particles to be centered in place.
  */
-inline void centerSystem(data::System& system) {
-    const size_t particle_count = system.count();
+inline void centerSystem(const data::SystemView& particles) {
+    const size_t particle_count = particles.count();
     if (particle_count == 0) return;
 
-    const CenterOfMass com = getCenterOfMass(system);
+    const CenterOfMass com = getCenterOfMass(particles);
 
     for (size_t i = 0; i < particle_count; ++i) {
-        system.positions[i] -= com.position;
-        system.velocities[i] -= com.velocity;
+        particles.positions[i] -= com.position;
+        particles.velocities[i] -= com.velocity;
     }
 }
 
+/**
+ * @brief Translates a system so its center of mass is at the origin (0,0,0)
+ *        and its total momentum is zero.
+ * @param system The system containing the particles to be centered.
+ */
+inline void centerSystem(data::System& system) { centerSystem(system.view()); }
+
 /**
  * @brief Scale the properties of particles to Hénon units.
  *
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <enkas/data/system.h>
+#include <enkas/math/vector3d.h>
+
+#include <cstddef>
+
+namespace enkas::physics {
+
+/**
+ * @brief Interpolates a system between two stored states using cubic Hermite splines.
+ *
+ * Each particle follows the cubic that matches both positions and both velocities, so the
+ * resulting trajectory is continuous in position and velocity across consecutive states. The
+ * interpolated velocities are the time derivative of that cubic.
+ *
+ * @param from The earlier state.
+ * @param to The later state, containing the same particles in the same order.
+ * @param dt The time between both states.
+ * @param s The interpolation parameter, 0 for @p from and 1 for @p to.
+ * @param out The interpolated state. It is resized to match the inputs.
+ * @note If the particle counts differ, the nearer of the two states is copied instead.
+ */
+inline void interpolateHermite(const data::System& from,
+                               const data::System& to,
+                               double dt,
+                               double s,
+                               data::System& out) {
+    if (from.count() != to.count() || dt <= 0.0) {
+        out = s < 0.5 ? from : to;
+        return;
+    }
+
+    const size_t particle_count = from.count();
+    out.resize(particle_count);
+
+    // Hermite basis functions and their derivatives with respect to s
+    const double s2 = s * s;
+    const double s3 = s2 * s;
+    const double h00 = 2.0 * s3 - 3.0 * s2 + 1.0;
+    const double h10 = s3 - 2.0 * s2 + s;
+    const double h01 = -2.0 * s3 + 3.0 * s2;
+    const double h11 = s3 - s2;
+
+    const double dh00 = 6.0 * s2 - 6.0 * s;
+    const double dh10 = 3.0 * s2 - 4.0 * s + 1.0;
+    const double dh01 = -6.0 * s2 + 6.0 * s;
+    const double dh11 = 3.0 * s2 - 2.0 * s;
+
+    for (size_t i = 0; i < particle_count; ++i) {
+        const auto& p0 = from.positions[i];
+        const auto& p1 = to.positions[i];
+        const auto& v0 = from.velocities[i];
+        const auto& v1 = to.velocities[i];
+
+        out.positions[i] = h00 * p0 + (h10 * dt) * v0 + h01 * p1 + (h11 * dt) * v1;
+        out.velocities[i] = (dh00 / dt) * p0 + dh10 * v0 + (dh01 / dt) * p1 + dh11 * v1;
+        out.masses[i] = from.masses[i];
+    }
+}
+
+}  // namespace enkas::physics
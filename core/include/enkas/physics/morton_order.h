@@ -0,0 +1,69 @@
+#pragma once
+
+#include <enkas/data/system.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace enkas::physics {
+
+/**
+ * @brief Interleaves the lowest 21 bits of three grid coordinates into a 63 bit Morton key.
+ *
+ * Sorting by this key orders cells along a Z-order curve, which keeps cells that are close in
+ * space mostly close in the order as well.
+ */
+[[nodiscard]] constexpr uint64_t mortonKey(uint32_t x, uint32_t y, uint32_t z) {
+    const auto spread = [](uint64_t v) {
+        v &= 0x1fffff;
+        v = (v | v << 32) & 0x1f00000000ffff;
+        v = (v | v << 16) & 0x1f0000ff0000ff;
+        v = (v | v << 8) & 0x100f00f00f00f00f;
+        v = (v | v << 4) & 0x10c30c30c30c30c3;
+        v = (v | v << 2) & 0x1249249249249249;
+        return v;
+    };
+    return spread(x) | spread(y) << 1 | spread(z) << 2;
+}
+
+/**
+ * @brief Returns the order of the particles of a system along a Morton curve through their
+ * bounding box, so that particles close in space are mostly close in memory, too.
+ *
+ * @param system The system to order.
+ * @return The permutation @c order, where @c order[k] is the index of the particle that belongs
+ *         at position k. Particles in the same grid cell keep their relative order.
+ */
+[[nodiscard]] std::vector<size_t> getMortonOrder(const data::System& system);
+
+/**
+ * @brief Rearranges values by a permutation, so that @c values[k] becomes the old
+ * @c values[order[k]].
+ */
+template <typename T>
+void applyOrder(std::vector<T>& values, std::span<const size_t> order) {
+    std::vector<T> ordered;
+    ordered.reserve(order.size());
+    for (const size_t index : order) ordered.push_back(std::move(values[index]));
+    values = std::move(ordered);
+}
+
+/**
+ * @brief Writes the particles of a system into another one by a permutation, so that particle k
+ * of @p target is particle @c order[k] of @p source. @p target is resized to match.
+ */
+inline void applyOrder(const data::System& source,
+                       std::span<const size_t> order,
+                       data::System& target) {
+    target.resize(order.size());
+    for (size_t k = 0; k < order.size(); ++k) {
+        target.positions[k] = source.positions[order[k]];
+        target.velocities[k] = source.velocities[order[k]];
+        target.masses[k] = source.masses[order[k]];
+    }
+}
+
+}  // namespace enkas::physics
@@ -0,0 +1,320 @@
+#pragma once
+
+#include <enkas/data/system.h>
+#include <enkas/generation/parallel_for.h>
+#include <enkas/math/vector3d.h>
+#include <enkas/simulation/simulators/barneshut_tree.h>
+#include <enkas/tracing/latency_histogram.h>
+#include <enkas/tracing/trace.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace enkas::simulation {
+
+/**
+ * @brief A force backend computes the accelerations of all particles of a system.
+ *
+ * computeForces() overwrites the accelerations, returns the potential energy of the system and
+ * may return early once the stop flag is set.
+ */
+template <typename T>
+concept ForceBackend = requires(T backend,
+                                const T const_backend,
+                                const data::System& system,
+                                std::vector<math::Vector3D>& accelerations,
+                                const std::atomic_bool& stop) {
+    { backend.computeForces(system, accelerations, stop) } -> std::same_as<double>;
+    { const_backend.softeningSqr() } -> std::same_as<double>;
+    { T::kName } -> std::convertible_to<std::string_view>;
+};
+
+/**
+ * @brief A force backend that also computes the jerks, the time derivatives of the accelerations.
+ */
+template <typename T>
+concept JerkForceBackend = ForceBackend<T> && requires(T backend,
+                                                       const data::System& system,
+                                                       std::vector<math::Vector3D>& accelerations,
+                                                       std::vector<math::Vector3D>& jerks,
+                                                       const std::atomic_bool& stop) {
+    { backend.computeForcesAndJerks(system, accelerations, jerks, stop) } -> std::same_as<double>;
+};
+
+namespace detail {
+/**
+ * @brief Returns the acceleration of a particle towards a particle of unit mass at separation
+ * @p r_ij, and stores their softened inverse distance in @p dist_inv.
+ */
+[[nodiscard]] inline math::Vector3D pairAcceleration(const math::Vector3D& r_ij,
+                                                     double softening_sqr,
+                                                     double& dist_inv) {
+    const double dist_sqr = r_ij.norm2() + softening_sqr;
+    dist_inv = dist_sqr > 0.0 ? 1.0 / std::sqrt(dist_sqr) : 0.0;
+    return r_ij * (dist_inv * dist_inv * dist_inv);
+}
+
+/**
+ * @brief Returns the jerk of a particle from a particle of unit mass, given their separation,
+ * relative velocity and inverse distance.
+ */
+[[nodiscard]] inline math::Vector3D pairJerk(const math::Vector3D& r_ij,
+                                             const math::Vector3D& v_ij,
+                                             double dist_inv) {
+    const double dist_inv_cubed = dist_inv * dist_inv * dist_inv;
+    const double r_dot_v = math::dotProduct(r_ij, v_ij);
+    return (v_ij - r_ij * (3.0 * r_dot_v * dist_inv * dist_inv)) * dist_inv_cubed;
+}
+}  // namespace detail
+
+/**
+ * @brief Direct summation over all particle pairs on the calling thread.
+ * Every pair is visited once and acts on both of its particles.
+ */
+class DirectForces {
+public:
+    static constexpr std::string_view kName = "direct";
+
+    explicit DirectForces(double softening_parameter)
+        : softening_sqr_(softening_parameter * softening_parameter) {}
+
+    [[nodiscard]] double softeningSqr() const { return softening_sqr_; }
+
+    double computeForces(const data::System& system,
+                         std::vector<math::Vector3D>& accelerations,
+                         const std::atomic_bool& stop) const {
+        std::fill(accelerations.begin(), accelerations.end(), math::Vector3D{});
+
+        const size_t particle_count = system.count();
+        const auto& positions = system.positions;
+        const auto& masses = system.masses;
+        double potential_energy = 0.0;
+
+        for (size_t i = 0; i < particle_count; ++i) {
+            if (stop.load(std::memory_order_relaxed)) break;
+            for (size_t j = i + 1; j < particle_count; ++j) {
+                double dist_inv;
+                const math::Vector3D acc_term =
+                    detail::pairAcceleration(positions[j] - positions[i], softening_sqr_, dist_inv);
+
+                accelerations[i] += acc_term * masses[j];
+                accelerations[j] -= acc_term * masses[i];
+                potential_energy -= masses[i] * masses[j] * dist_inv;
+            }
+        }
+        return potential_energy;
+    }
+
+    double computeForcesAndJerks(const data::System& system,
+                                 std::vector<math::Vector3D>& accelerations,
+                                 std::vector<math::Vector3D>& jerks,
+                                 const std::atomic_bool& stop) const {
+        std::fill(accelerations.begin(), accelerations.end(), math::Vector3D{});
+        std::fill(jerks.begin(), jerks.end(), math::Vector3D{});
+
+        const size_t particle_count = system.count();
+        const auto& positions = system.positions;
+        const auto& velocities = system.velocities;
+        const auto& masses = system.masses;
+        double potential_energy = 0.0;
+
+        for (size_t i = 0; i < particle_count; ++i) {
+            if (stop.load(std::memory_order_relaxed)) break;
+            for (size_t j = i + 1; j < particle_count; ++j) {
+                const math::Vector3D r_ij = positions[j] - positions[i];
+                double dist_inv;
+                const math::Vector3D acc_term =
+                    detail::pairAcceleration(r_ij, softening_sqr_, dist_inv);
+                const math::Vector3D jerk_term =
+                    detail::pairJerk(r_ij, velocities[j] - velocities[i], dist_inv);
+
+                accelerations[i] += acc_term * masses[j];
+                accelerations[j] -= acc_term * masses[i];
+                jerks[i] += jerk_term * masses[j];
+                jerks[j] -= jerk_term * masses[i];
+                potential_energy -= masses[i] * masses[j] * dist_inv;
+            }
+        }
+        return potential_energy;
+    }
+
+private:
+    double softening_sqr_;
+};
+
+/**
+ * @brief Direct summation with the particles split over threads.
+ *
+ * Each thread sums all interactions of its own particles, so no two threads write to the same
+ * particle. This does every pair twice, which pays off from a few hundred particles on.
+ */
+class ParallelDirectForces {
+public:
+    static constexpr std::string_view kName = "parallel direct";
+
+    /**
+     * @param softening_parameter The softening length.
+     * @param thread_count The maximum number of threads, 0 for the number of hardware threads.
+     */
+    explicit ParallelDirectForces(double softening_parameter, size_t thread_count = 0)
+        : softening_sqr_(softening_parameter * softening_parameter), thread_count_(thread_count) {}
+
+    [[nodiscard]] double softeningSqr() const { return softening_sqr_; }
+
+    double computeForces(const data::System& system,
+                         std::vector<math::Vector3D>& accelerations,
+                         const std::atomic_bool& stop) const {
+        const auto& positions = system.positions;
+        const auto& masses = system.masses;
+
+        return forEachRange(system.count(), [&](size_t begin, size_t end) {
+            double potential_energy = 0.0;
+            for (size_t i = begin; i < end; ++i) {
+                if (stop.load(std::memory_order_relaxed)) break;
+                math::Vector3D acceleration;
+                for (size_t j = 0; j < positions.size(); ++j) {
+                    if (j == i) continue;
+                    double dist_inv;
+                    acceleration += detail::pairAcceleration(
+                                        positions[j] - positions[i], softening_sqr_, dist_inv) *
+                                    masses[j];
+                    potential_energy -= masses[i] * masses[j] * dist_inv;
+                }
+                accelerations[i] = acceleration;
+            }
+            return potential_energy;
+        });
+    }
+
+    double computeForcesAndJerks(const data::System& system,
+                                 std::vector<math::Vector3D>& accelerations,
+                                 std::vector<math::Vector3D>& jerks,
+                                 const std::atomic_bool& stop) const {
+        const auto& positions = system.positions;
+        const auto& velocities = system.velocities;
+        const auto& masses = system.masses;
+
+        return forEachRange(system.count(), [&](size_t begin, size_t end) {
+            double potential_energy = 0.0;
+            for (size_t i = begin; i < end; ++i) {
+                if (stop.load(std::memory_order_relaxed)) break;
+                math::Vector3D acceleration;
+                math::Vector3D jerk;
+                for (size_t j = 0; j < positions.size(); ++j) {
+                    if (j == i) continue;
+                    const math::Vector3D r_ij = positions[j] - positions[i];
+                    double dist_inv;
+                    acceleration +=
+                        detail::pairAcceleration(r_ij, softening_sqr_, dist_inv) * masses[j];
+                    jerk +=
+                        detail::pairJerk(r_ij, velocities[j] - velocities[i], dist_inv) * masses[j];
+                    potential_energy -= masses[i] * masses[j] * dist_inv;
+                }
+                accelerations[i] = acceleration;
+                jerks[i] = jerk;
+            }
+            return potential_energy;
+        });
+    }
+
+private:
+    // Below this many pair interactions per thread, starting a thread costs more than it saves.
+    static constexpr size_t kMinPairsPerThread = size_t{1} << 16;
+
+    /**
+     * @brief Runs @p body on ranges of particles in parallel and returns the potential energy from
+     * the sum of its results, in which every pair was counted twice.
+     */
+    template <typename Body>
+    double forEachRange(size_t particle_count, const Body& body) const {
+        std::atomic<double> potential_energy = 0.0;
+        generation::parallelFor(
+            particle_count,
+            [&](size_t begin, size_t end) {
+                potential_energy.fetch_add(body(begin, end), std::memory_order_relaxed);
+            },
+            thread_count_,
+            std::max<size_t>(kMinPairsPerThread / std::max<size_t>(particle_count, 1), 1));
+        return 0.5 * potential_energy.load(std::memory_order_relaxed);
+    }
+
+    double softening_sqr_;
+    size_t thread_count_;
+};
+
+/**
+ * @brief Barnes-Hut tree code: distant groups of particles act through their center of mass.
+ */
+class TreeForces {
+public:
+    static constexpr std::string_view kName = "Barnes-Hut";
+
+    /**
+     * @param theta_mac The multipole acceptance criterion.
+     * @param softening_parameter The softening length.
+     */
+    TreeForces(double theta_mac, double softening_parameter)
+        : theta_mac_sqr_(theta_mac * theta_mac),
+          softening_sqr_(softening_parameter * softening_parameter) {}
+
+    [[nodiscard]] double softeningSqr() const { return softening_sqr_; }
+
+    double computeForces(const data::System& system,
+                         std::vector<math::Vector3D>& accelerations,
+                         const std::atomic_bool& /*stop*/) {
+        tree_.build(system);
+        return tree_.updateForces(system, theta_mac_sqr_, softening_sqr_, accelerations);
+    }
+
+private:
+    double theta_mac_sqr_;
+    double softening_sqr_;
+    BarnesHutTree tree_;
+};
+
+/**
+ * @brief Calls a force backend, recording each evaluation as a trace zone and into the force
+ * latency histogram of the simulator.
+ */
+template <ForceBackend Backend>
+class ForceEvaluator {
+public:
+    ForceEvaluator(Backend& backend,
+                   tracing::LatencyHistogram* latency,
+                   const std::atomic_bool& stop)
+        : backend_(backend), latency_(latency), stop_(stop) {}
+
+    /**
+     * @brief Computes the accelerations of a system and returns its potential energy.
+     */
+    double operator()(const data::System& system, std::vector<math::Vector3D>& accelerations) {
+        ENKAS_TRACE_SCOPE("Force Evaluation");
+        const tracing::ScopedLatency timer(latency_);
+        return backend_.computeForces(system, accelerations, stop_);
+    }
+
+    /**
+     * @brief Computes the accelerations and jerks of a system and returns its potential energy.
+     */
+    double operator()(const data::System& system,
+                      std::vector<math::Vector3D>& accelerations,
+                      std::vector<math::Vector3D>& jerks)
+        requires JerkForceBackend<Backend>
+    {
+        ENKAS_TRACE_SCOPE("Force Evaluation");
+        const tracing::ScopedLatency timer(latency_);
+        return backend_.computeForcesAndJerks(system, accelerations, jerks, stop_);
+    }
+
+private:
+    Backend& backend_;
+    tracing::LatencyHistogram* latency_;
+    const std::atomic_bool& stop_;
+};
+
+}  // namespace enkas::simulation
@@ -0,0 +1,307 @@
+#pragma once
+
+#include <enkas/data/system.h>
+#include <enkas/math/vector3d.h>
+#include <enkas/physics/morton_order.h>
+#include <enkas/simulation/settings/symplectic_settings.h>
+#include <enkas/tracing/trace.h>
+
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace enkas::simulation {
+
+/**
+ * Integrator policies advance a system by one time step. They are combined with a force backend
+ * in ComposedSimulator, which owns the system buffers and calls, for an integrator and a force
+ * evaluator `forces` (see ForceEvaluator):
+ *
+ *   initialize(system, forces)           once with the scaled initial system,
+ *   step(previous, next, forces)         to write the state one time step after previous into
+ *                                        next, whose masses are already set,
+ *   potentialEnergy(next, forces)        for the diagnostics of the state after a step,
+ *   reorder(order)                       when the simulator rearranges the particles, to move
+ *                                        the per particle state along (see applyOrder()).
+ *
+ * The force evaluator is a template parameter, so all force calls are resolved at compile time.
+ */
+
+/**
+ * @brief Explicit first-order Euler integration.
+ */
+class EulerIntegrator {
+public:
+    static constexpr std::string_view kName = "Euler";
+    static constexpr bool kRequiresJerks = false;
+
+    explicit EulerIntegrator(double time_step) : time_step_(time_step) {}
+
+    [[nodiscard]] double timeStep() const { return time_step_; }
+
+    template <typename Forces>
+    void initialize(const data::System& system, Forces& forces) {
+        accelerations_.resize(system.count());
+        potential_energy_ = forces(system, accelerations_);
+    }
+
+    template <typename Forces>
+    void step(const data::System& previous, data::System& next, Forces& forces) {
+        const double dt = time_step_;
+        for (size_t i = 0; i < next.count(); ++i) {
+            next.positions[i] = previous.positions[i] + previous.velocities[i] * dt;
+            next.velocities[i] = previous.velocities[i] + accelerations_[i] * dt;
+        }
+
+        // The accelerations of the new state are the ones of the next step
+        potential_energy_ = forces(next, accelerations_);
+    }
+
+    template <typename Forces>
+    double potentialEnergy(const data::System& /*system*/, Forces& /*forces*/) const {
+        return potential_energy_;
+    }
+
+    void reorder(std::span<const size_t> order) { physics::applyOrder(accelerations_, order); }
+
+private:
+    double time_step_;
+    double potential_energy_ = 0.0;
+    std::vector<math::Vector3D> accelerations_;
+};
+
+/**
+ * @brief Second-order kick-drift-kick leapfrog integration.
+ */
+class LeapfrogIntegrator {
+public:
+    static constexpr std::string_view kName = "Leapfrog";
+    static constexpr bool kRequiresJerks = false;
+
+    explicit LeapfrogIntegrator(double time_step) : time_step_(time_step) {}
+
+    [[nodiscard]] double timeStep() const { return time_step_; }
+
+    template <typename Forces>
+    void initialize(const data::System& system, Forces& forces) {
+        accelerations_.resize(system.count());
+        potential_energy_ = forces(system, accelerations_);
+    }
+
+    template <typename Forces>
+    void step(const data::System& previous, data::System& next, Forces& forces) {
+        const size_t particle_count = next.count();
+        const double dt = time_step_;
+
+        {
+            ENKAS_TRACE_SCOPE("Kick and Drift");
+            for (size_t i = 0; i < particle_count; ++i) {
+                next.velocities[i] = previous.velocities[i] + accelerations_[i] * dt * 0.5;
+                next.positions[i] = previous.positions[i] + next.velocities[i] * dt;
+            }
+        }
+
+        potential_energy_ = forces(next, accelerations_);
+
+        ENKAS_TRACE_SCOPE("Kick");
+        for (size_t i = 0; i < particle_count; ++i) {
+            next.velocities[i] += accelerations_[i] * dt * 0.5;
+        }
+    }
+
+    template <typename Forces>
+    double potentialEnergy(const data::System& /*system*/, Forces& /*forces*/) const {
+        return potential_energy_;
+    }
+
+    void reorder(std::span<const size_t> order) { physics::applyOrder(accelerations_, order); }
+
+private:
+    double time_step_;
+    double potential_energy_ = 0.0;
+    std::vector<math::Vector3D> accelerations_;
+};
+
+/**
+ * @brief Fourth-order Hermite predictor-corrector integration. Needs a force backend that
+ * computes jerks.
+ *
+ * @see Makino, J. and Aarseth, S. J.; 1992; On a Hermite integrator with Ahmad-Cohen scheme for
+ * gravitational many-body problems
+ */
+class HermiteIntegrator {
+public:
+    static constexpr std::string_view kName = "Hermite";
+    static constexpr bool kRequiresJerks = true;
+
+    explicit HermiteIntegrator(double time_step) : time_step_(time_step) {}
+
+    [[nodiscard]] double timeStep() const { return time_step_; }
+
+    template <typename Forces>
+    void initialize(const data::System& system, Forces& forces) {
+        accelerations_.resize(system.count());
+        jerks_.resize(system.count());
+        old_accelerations_.resize(system.count());
+        old_jerks_.resize(system.count());
+        potential_energy_ = forces(system, accelerations_, jerks_);
+    }
+
+    template <typename Forces>
+    void step(const data::System& previous, data::System& next, Forces& forces) {
+        const size_t particle_count = next.count();
+        const double dt = time_step_;
+        const double dt2 = dt * dt;
+        const double dt3 = dt2 * dt;
+
+        std::swap(accelerations_, old_accelerations_);
+        std::swap(jerks_, old_jerks_);
+
+        // Predict particle position and velocity up to order jerk
+        for (size_t i = 0; i < particle_count; ++i) {
+            next.positions[i] = previous.positions[i] + previous.velocities[i] * dt +
+                                old_accelerations_[i] * dt2 * 0.5 + old_jerks_[i] * dt3 / 6.0;
+            next.velocities[i] =
+                previous.velocities[i] + old_accelerations_[i] * dt + old_jerks_[i] * dt2 * 0.5;
+        }
+
+        // Calculate acceleration and jerk of the predicted system
+        potential_energy_ = forces(next, accelerations_, jerks_);
+
+        // Correct particle position and velocity using hermite scheme
+        for (size_t i = 0; i < particle_count; ++i) {
+            next.velocities[i] = previous.velocities[i] +
+                                 (old_accelerations_[i] + accelerations_[i]) * dt * 0.5 +
+                                 (old_jerks_[i] - jerks_[i]) * dt2 / 12.0;
+            next.positions[i] = previous.positions[i] +
+                                (previous.velocities[i] + next.velocities[i]) * dt * 0.5 +
+                                (old_accelerations_[i] - accelerations_[i]) * dt2 / 12.0;
+        }
+    }
+
+    template <typename Forces>
+    double potentialEnergy(const data::System& /*system*/, Forces& /*forces*/) const {
+        return potential_energy_;
+    }
+
+    void reorder(std::span<const size_t> order) {
+        // The old values are overwritten in the next step, so only the current ones have to move
+        physics::applyOrder(accelerations_, order);
+        physics::applyOrder(jerks_, order);
+    }
+
+private:
+    double time_step_;
+    double potential_energy_ = 0.0;
+    std::vector<math::Vector3D> accelerations_;
+    std::vector<math::Vector3D> jerks_;
+    std::vector<math::Vector3D> old_accelerations_;  // accelerations at the start of the step
+    std::vector<math::Vector3D> old_jerks_;          // jerks at the start of the step
+};
+
+/**
+ * @brief The coefficients of a symmetric splitting of a time step into drifts and kicks.
+ *
+ * A step applies drift(drifts[0]), kick(kicks[0]), drift(drifts[1]), ..., kick(kicks[n - 1]),
+ * drift(drifts[n]), each scaled by the time step. A zero drift is skipped, so that a kick right
+ * after another one reuses its accelerations.
+ */
+struct SplittingScheme {
+    std::span<const double> drifts;
+    std::span<const double> kicks;
+};
+
+/**
+ * @brief Returns the splitting scheme of a coefficient set.
+ */
+[[nodiscard]] SplittingScheme getSplittingScheme(SplittingCoefficients coefficients);
+
+/**
+ * @brief Fourth-order symplectic integration by a sequence of drifts and kicks.
+ *
+ * The accelerations are only recomputed after a drift, so schemes that start and end with a kick
+ * need one force evaluation less per step than they have kicks.
+ *
+ * @see Yoshida, H.; 1990; Construction of higher order symplectic integrators
+ * @see Omelyan, I. P. et al.; 2002; Optimized Forest-Ruth- and Suzuki-like algorithms for
+ * integration of motion in many-body systems
+ */
+class SplittingIntegrator {
+public:
+    static constexpr std::string_view kName = "Symplectic";
+    static constexpr bool kRequiresJerks = false;
+
+    SplittingIntegrator(double time_step, SplittingCoefficients coefficients)
+        : time_step_(time_step), scheme_(getSplittingScheme(coefficients)) {}
+
+    [[nodiscard]] double timeStep() const { return time_step_; }
+
+    template <typename Forces>
+    void initialize(const data::System& system, Forces& forces) {
+        accelerations_.resize(system.count());
+        potential_energy_ = forces(system, accelerations_);
+        forces_current_ = true;
+    }
+
+    template <typename Forces>
+    void step(const data::System& previous, data::System& next, Forces& forces) {
+        const size_t particle_count = next.count();
+        auto& positions = next.positions;
+        auto& velocities = next.velocities;
+
+        {
+            ENKAS_TRACE_SCOPE("Copy State");
+            positions = previous.positions;
+            velocities = previous.velocities;
+        }
+
+        const auto drift = [&](double coefficient) {
+            if (coefficient == 0.0) return;
+
+            ENKAS_TRACE_SCOPE("Drift");
+            const double h = coefficient * time_step_;
+            for (size_t i = 0; i < particle_count; ++i) positions[i] += velocities[i] * h;
+            forces_current_ = false;
+        };
+
+        for (size_t stage = 0; stage < scheme_.kicks.size(); ++stage) {
+            drift(scheme_.drifts[stage]);
+
+            if (!forces_current_) {
+                potential_energy_ = forces(next, accelerations_);
+                forces_current_ = true;
+            }
+
+            ENKAS_TRACE_SCOPE("Kick");
+            const double h = scheme_.kicks[stage] * time_step_;
+            for (size_t i = 0; i < particle_count; ++i) velocities[i] += accelerations_[i] * h;
+        }
+        drift(scheme_.drifts.back());
+    }
+
+    /**
+     * Schemes that end with a drift only know the potential energy of an earlier stage, so this
+     * evaluates the forces of the new state.
+     */
+    template <typename Forces>
+    double potentialEnergy(const data::System& system, Forces& forces) {
+        if (!forces_current_) {
+            potential_energy_ = forces(system, accelerations_);
+            forces_current_ = true;
+        }
+        return potential_energy_;
+    }
+
+    void reorder(std::span<const size_t> order) { physics::applyOrder(accelerations_, order); }
+
+private:
+    double time_step_;
+    SplittingScheme scheme_;
+    double potential_energy_ = 0.0;  // potential energy at the last force evaluation
+    bool forces_current_ = false;    // whether accelerations_ belong to the current positions
+    std::vector<math::Vector3D> accelerations_;
+};
+
+}  // namespace enkas::simulation
@@ -1,11 +1,14 @@
 #pragma once
 
+#include <cstddef>
+
 namespace enkas::simulation {
 
 struct BarnesHutLeapfrogSettings {
     double time_step;
     double theta_mac;  // multipole acceptance criterion
     double softening_parameter;
+    size_t reorder_interval = 0;  // steps between sorting particles by Morton key, 0 for never
 
     [[nodiscard]] bool isValid() const {
         return (time_step > 0.0 && theta_mac >= 0.0 && softening_parameter > 0.0);
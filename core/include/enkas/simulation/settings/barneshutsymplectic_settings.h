@@ -0,0 +1,21 @@
+#pragma once
+
+#include <enkas/simulation/settings/symplectic_settings.h>
+
+#include <cstddef>
+
+namespace enkas::simulation {
+
+struct BarnesHutSymplecticSettings {
+    double time_step;
+    double theta_mac;  // multipole acceptance criterion
+    double softening_parameter;
+    SplittingCoefficients coefficients = SplittingCoefficients::Yoshida;
+    size_t reorder_interval = 0;  // steps between sorting particles by Morton key, 0 for never
+
+    [[nodiscard]] bool isValid() const {
+        return (time_step > 0.0 && theta_mac >= 0.0 && softening_parameter > 0.0);
+    }
+};
+
+}  // namespace enkas::simulation
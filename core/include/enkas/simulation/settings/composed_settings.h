@@ -0,0 +1,34 @@
+#pragma once
+
+#include <enkas/simulation/settings/symplectic_settings.h>
+
+#include <cstddef>
+
+namespace enkas::simulation {
+
+enum class IntegratorMethod { Euler, Leapfrog, Hermite, Symplectic };
+
+enum class ForceMethod { Direct, ParallelDirect, BarnesHut };
+
+/**
+ * @brief Settings for any combination of a fixed time step integrator and a force backend.
+ */
+struct ComposedSettings {
+    IntegratorMethod integrator = IntegratorMethod::Leapfrog;
+    ForceMethod force_method = ForceMethod::Direct;
+    double time_step;
+    double softening_parameter;
+    double theta_mac = 0.5;  // multipole acceptance criterion, only for Barnes-Hut
+    SplittingCoefficients coefficients = SplittingCoefficients::Yoshida;  // only for Symplectic
+    size_t thread_count = 0;  // only for ParallelDirect, 0 for the number of hardware threads
+    size_t reorder_interval = 0;  // steps between sorting particles by Morton key, 0 for never
+
+    [[nodiscard]] bool isValid() const {
+        // The tree does not compute the jerks that Hermite needs
+        const bool composable =
+            !(integrator == IntegratorMethod::Hermite && force_method == ForceMethod::BarnesHut);
+        return (composable && time_step > 0.0 && softening_parameter > 0.0 && theta_mac >= 0.0);
+    }
+};
+
+}  // namespace enkas::simulation
@@ -0,0 +1,22 @@
+#pragma once
+
+namespace enkas::simulation {
+
+/**
+ * @brief The coefficient sets of the fourth-order symplectic splitting integrators.
+ */
+enum class SplittingCoefficients {
+    Yoshida,     // Yoshida's triple jump of kick-drift-kick leapfrog, 3 force evaluations per step
+    ForestRuth,  // Forest and Ruth's drift-first form of the triple jump, 3 force evaluations
+    PEFRL        // Omelyan et al.'s position extended Forest-Ruth like, 4 force evaluations
+};
+
+struct SymplecticSettings {
+    double time_step;
+    double softening_parameter;
+    SplittingCoefficients coefficients = SplittingCoefficients::Yoshida;
+
+    [[nodiscard]] bool isValid() const { return (time_step > 0.0 && softening_parameter > 0.0); }
+};
+
+}  // namespace enkas::simulation
@@ -1,10 +1,13 @@
 #pragma once
 
 #include <enkas/simulation/settings/barneshutleapfrog_settings.h>
+#include <enkas/simulation/settings/barneshutsymplectic_settings.h>
+#include <enkas/simulation/settings/composed_settings.h>
 #include <enkas/simulation/settings/euler_settings.h>
 #include <enkas/simulation/settings/hermite_settings.h>
 #include <enkas/simulation/settings/hits_settings.h>
 #include <enkas/simulation/settings/leapfrog_settings.h>
+#include <enkas/simulation/settings/symplectic_settings.h>
 
 #include <variant>
 
@@ -14,6 +17,9 @@ using Settings = std::variant<EulerSettings,
                               LeapfrogSettings,
                               HermiteSettings,
                               HitsSettings,
-                              BarnesHutLeapfrogSettings>;
+                              BarnesHutLeapfrogSettings,
+                              SymplecticSettings,
+                              BarnesHutSymplecticSettings,
+                              ComposedSettings>;
 
 }  // namespace enkas::simulation
@@ -2,14 +2,23 @@
 
 #include <enkas/data/diagnostics.h>
 #include <enkas/data/system.h>
+#include <enkas/tracing/latency_histogram.h>
 
 #include <atomic>
+#include <cstddef>
 #include <memory>
+#include <optional>
 
 namespace enkas::simulation {
 
 class Simulator {
 public:
+    /**
+     * @brief The particle count from which initialize() uses a potential energy hint. Below it,
+     * the exact softened sum is cheap enough to compute and is used instead.
+     */
+    static constexpr size_t kMinHintedParticles = 10000;
+
     virtual ~Simulator() = default;
 
     /**
@@ -48,8 +57,42 @@ public:
      */
     [[nodiscard]] virtual double getSystemTime() const = 0;
 
+    /**
+     * @brief Returns the squared softening that initialize() computes the potential energy of the
+     * initial system with when it does not use a hint.
+     * @return The squared softening parameter.
+     */
+    [[nodiscard]] virtual double getSofteningSqr() const = 0;
+
+    /**
+     * @brief Sets the histogram that the duration of every force evaluation is recorded into.
+     * @param histogram The histogram, or nullptr to stop recording. Must outlive the simulator.
+     */
+    void setForceLatency(tracing::LatencyHistogram* histogram) { force_latency_ = histogram; }
+
+    /**
+     * @brief Sets the potential energy of the next initial system, so that initialize() does not
+     * have to compute it over all particle pairs.
+     * @param potential_energy The potential energy including G, in units of pc, solar mass, and
+     * km/s, or std::nullopt to compute it. Only used by the next call to initialize(), and only
+     * if that system has at least kMinHintedParticles particles.
+     */
+    void setPotentialEnergyHint(std::optional<double> potential_energy) {
+        potential_energy_hint_ = potential_energy;
+    }
+
 protected:
+    /**
+     * @brief Scales a system to Hénon units, using the potential energy hint if one was set and
+     * the system has at least kMinHintedParticles particles.
+     * @param system The system to scale in place.
+     * @param softening The softening passed on to physics::getPotentialEnergy without a hint.
+     */
+    void scaleInitialSystem(data::System& system, double softening);
+
     std::atomic_bool stop_requested_{false};
+    tracing::LatencyHistogram* force_latency_ = nullptr;
+    std::optional<double> potential_energy_hint_;
 };
 
 }  // namespace enkas::simulation
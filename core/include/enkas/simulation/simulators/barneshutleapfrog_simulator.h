@@ -1,45 +1,20 @@
 #pragma once
 
-#include <enkas/data/system.h>
+#include <enkas/simulation/policies/force_backends.h>
+#include <enkas/simulation/policies/integrators.h>
 #include <enkas/simulation/settings/barneshutleapfrog_settings.h>
-#include <enkas/simulation/simulator.h>
-#include <enkas/simulation/simulators/barneshut_tree.h>
-
-#include <vector>
+#include <enkas/simulation/simulators/composed_simulator.h>
 
 namespace enkas::simulation {
 
-class BarnesHutLeapfrogSimulator : public Simulator {
+extern template class ComposedSimulator<LeapfrogIntegrator, TreeForces>;
+
+/**
+ * @brief Leapfrog simulator with force evaluation by a Barnes-Hut tree.
+ */
+class BarnesHutLeapfrogSimulator : public ComposedSimulator<LeapfrogIntegrator, TreeForces> {
 public:
     explicit BarnesHutLeapfrogSimulator(const BarnesHutLeapfrogSettings& settings);
-
-    ~BarnesHutLeapfrogSimulator() override = default;
-
-    void initialize(std::shared_ptr<data::System> initial_system,
-                    std::shared_ptr<data::System> system_buffer) override;
-
-    void step(std::shared_ptr<data::System> system_buffer = nullptr,
-              std::shared_ptr<data::Diagnostics> diagnostics_buffer = nullptr) override;
-
-    [[nodiscard]] double getSystemTime() const override;
-
-private:
-    void updateForces(const data::System& system);
-    void calculateNextSystemState();
-
-    BarnesHutLeapfrogSettings settings_;
-
-    double system_time_ = 0.0;       // current time of the system
-    const double theta_mac_sqr_;     // squared multipole acceptance criterion
-    const double softening_sqr_;     // squared softening parameters
-    double potential_energy_ = 0.0;  // potential energy of the system
-
-    // state of the system at the previous step
-    std::shared_ptr<data::System> previous_system_ = nullptr;
-    std::shared_ptr<data::System> system_ = nullptr;  // system to write the new state to
-
-    BarnesHutTree barneshut_tree_;               // Barnes-Hut tree for acceleration calculations
-    std::vector<math::Vector3D> accelerations_;  // accelerations of particles
 };
 
 }  // namespace enkas::simulation
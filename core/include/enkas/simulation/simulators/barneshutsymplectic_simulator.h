@@ -0,0 +1,20 @@
+#pragma once
+
+#include <enkas/simulation/policies/force_backends.h>
+#include <enkas/simulation/policies/integrators.h>
+#include <enkas/simulation/settings/barneshutsymplectic_settings.h>
+#include <enkas/simulation/simulators/composed_simulator.h>
+
+namespace enkas::simulation {
+
+extern template class ComposedSimulator<SplittingIntegrator, TreeForces>;
+
+/**
+ * @brief Fourth-order symplectic simulator with force evaluation by a Barnes-Hut tree.
+ */
+class BarnesHutSymplecticSimulator : public ComposedSimulator<SplittingIntegrator, TreeForces> {
+public:
+    explicit BarnesHutSymplecticSimulator(const BarnesHutSymplecticSettings& settings);
+};
+
+}  // namespace enkas::simulation
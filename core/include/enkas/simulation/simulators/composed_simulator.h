@@ -0,0 +1,177 @@
+#pragma once
+
+#include <enkas/data/diagnostics.h>
+#include <enkas/data/system.h>
+#include <enkas/logging/logger.h>
+#include <enkas/physics/helpers.h>
+#include <enkas/physics/morton_order.h>
+#include <enkas/simulation/policies/force_backends.h>
+#include <enkas/simulation/policies/integrators.h>
+#include <enkas/simulation/simulator.h>
+#include <enkas/tracing/trace.h>
+
+#include <cstddef>
+#include <memory>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace enkas::simulation {
+
+/**
+ * @brief Whether an integrator policy can run on a force backend policy.
+ */
+template <typename Integrator, typename Backend>
+concept ComposableWith = ForceBackend<Backend> &&
+                         (!Integrator::kRequiresJerks || JerkForceBackend<Backend>);
+
+/**
+ * @brief A simulator that combines an integrator policy with a force backend policy.
+ *
+ * Holds the state that all fixed time step simulators share: the system buffers, the buffer swap
+ * and the diagnostics. The integrator calls the backend through a ForceEvaluator, so force calls
+ * are statically dispatched and can be inlined. Any integrator runs on any backend that provides
+ * what it needs, e.g. Hermite needs jerks.
+ *
+ * Optionally, the particles are sorted along a Morton curve every few steps, so that particles
+ * that interact a lot also sit close in memory. The simulator then steps its own two buffers and
+ * copies each requested state back into the original particle order.
+ */
+template <typename Integrator, typename Backend>
+    requires ComposableWith<Integrator, Backend>
+class ComposedSimulator : public Simulator {
+public:
+    /**
+     * @param integrator The integrator policy.
+     * @param backend The force backend policy.
+     * @param reorder_interval The number of steps between sorting the particles by their Morton
+     *        key, 0 to keep the initial order.
+     */
+    ComposedSimulator(Integrator integrator, Backend backend, size_t reorder_interval = 0)
+        : integrator_(std::move(integrator)),
+          backend_(std::move(backend)),
+          reorder_interval_(reorder_interval) {}
+
+    ~ComposedSimulator() override = default;
+
+    void initialize(std::shared_ptr<data::System> initial_system,
+                    std::shared_ptr<data::System> system_buffer) override {
+        ENKAS_LOG_INFO("Setting up {} simulator with {} forces and new initial system...",
+                       Integrator::kName,
+                       Backend::kName);
+
+        previous_system_ = std::move(initial_system);
+        system_ = std::move(system_buffer);
+        ENKAS_LOG_DEBUG("System contains {} particles.", previous_system_->count());
+
+        // Scale particles to Hénon Units
+        scaleInitialSystem(*previous_system_, backend_.softeningSqr());
+
+        // Update system masses after scaling
+        system_->masses = previous_system_->masses;
+
+        // Initialize accelerations of the initial system
+        ENKAS_LOG_INFO("Initializing accelerations...");
+        auto forces = forceEvaluator();
+        integrator_.initialize(*previous_system_, forces);
+
+        // The simulator starts in the original order of the particles
+        step_count_ = 0;
+        original_index_.clear();
+        if (reorder_interval_ > 0) {
+            original_index_.resize(previous_system_->count());
+            std::iota(original_index_.begin(), original_index_.end(), size_t{0});
+        }
+
+        system_time_ = 0.0;
+        ENKAS_LOG_INFO("System setup complete. Simulation ready to start.");
+    }
+
+    void step(std::shared_ptr<data::System> system_buffer = nullptr,
+              std::shared_ptr<data::Diagnostics> diagnostics_buffer = nullptr) override {
+        if (reorder_interval_ > 0) {
+            // Keep stepping the own buffers, the provided one only gets a copy in original order
+            if (step_count_ % reorder_interval_ == 0) reorderParticles();
+        } else if (system_buffer) {
+            // Use new memory buffer if provided, otherwise use the existing one
+            system_ = std::move(system_buffer);
+            system_->masses = previous_system_->masses;
+        }
+        ++step_count_;
+
+        auto forces = forceEvaluator();
+        if (!isStopRequested() && system_->count() > 0) {
+            integrator_.step(*previous_system_, *system_, forces);
+            system_time_ += integrator_.timeStep();
+        }
+
+        // If diagnostics buffer is provided, fill it with the current diagnostics data
+        if (diagnostics_buffer) {
+            const double potential_energy = integrator_.potentialEnergy(*system_, forces);
+
+            ENKAS_TRACE_SCOPE("Diagnostics");
+            physics::fillDiagnostics(*system_, potential_energy, *diagnostics_buffer);
+        }
+
+        if (reorder_interval_ > 0 && system_buffer) {
+            writeInOriginalOrder(*system_, *system_buffer);
+        }
+
+        // Swap the previous system with the new one
+        std::swap(previous_system_, system_);
+    }
+
+    [[nodiscard]] double getSystemTime() const override { return system_time_; }
+    [[nodiscard]] double getSofteningSqr() const override { return backend_.softeningSqr(); }
+
+private:
+    [[nodiscard]] ForceEvaluator<Backend> forceEvaluator() {
+        return {backend_, force_latency_, stop_requested_};
+    }
+
+    /**
+     * @brief Sorts the previous system, the state of the integrator and the original indices by
+     * the Morton keys of the particles.
+     */
+    void reorderParticles() {
+        ENKAS_TRACE_SCOPE("Reorder Particles");
+        const std::vector<size_t> order = physics::getMortonOrder(*previous_system_);
+
+        // The buffer for the next state is free, so the sorted system is written into it
+        physics::applyOrder(*previous_system_, order, *system_);
+        std::swap(previous_system_, system_);
+        system_->masses = previous_system_->masses;
+
+        physics::applyOrder(original_index_, order);
+        integrator_.reorder(order);
+    }
+
+    /**
+     * @brief Copies a system in the internal order into @p target in the original order.
+     */
+    void writeInOriginalOrder(const data::System& source, data::System& target) const {
+        ENKAS_TRACE_SCOPE("Restore Order");
+        target.resize(source.count());
+        for (size_t k = 0; k < source.count(); ++k) {
+            const size_t index = original_index_[k];
+            target.positions[index] = source.positions[k];
+            target.velocities[index] = source.velocities[k];
+            target.masses[index] = source.masses[k];
+        }
+    }
+
+    Integrator integrator_;
+    Backend backend_;
+
+    size_t reorder_interval_;  // steps between sorting the particles, 0 for never
+    size_t step_count_ = 0;
+    std::vector<size_t> original_index_;  // original index of each particle in internal order
+
+    double system_time_ = 0.0;  // current time of the system
+
+    // state of the system at the previous step
+    std::shared_ptr<data::System> previous_system_ = nullptr;
+    std::shared_ptr<data::System> system_ = nullptr;  // system to write the new state to
+};
+
+}  // namespace enkas::simulation
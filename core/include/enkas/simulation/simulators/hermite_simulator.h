@@ -1,45 +1,20 @@
 #pragma once
 
-#include <enkas/data/system.h>
-#include <enkas/math/vector3d.h>
+#include <enkas/simulation/policies/force_backends.h>
+#include <enkas/simulation/policies/integrators.h>
 #include <enkas/simulation/settings/hermite_settings.h>
-#include <enkas/simulation/simulator.h>
-
-#include <vector>
+#include <enkas/simulation/simulators/composed_simulator.h>
 
 namespace enkas::simulation {
 
-class HermiteSimulator : public Simulator {
+extern template class ComposedSimulator<HermiteIntegrator, DirectForces>;
+
+/**
+ * @brief Fourth-order Hermite simulator with direct pair-wise force evaluation.
+ */
+class HermiteSimulator : public ComposedSimulator<HermiteIntegrator, DirectForces> {
 public:
     explicit HermiteSimulator(const HermiteSettings& settings);
-
-    ~HermiteSimulator() override = default;
-
-    void initialize(std::shared_ptr<data::System> initial_system,
-                    std::shared_ptr<data::System> system_buffer) override;
-
-    void step(std::shared_ptr<data::System> system_buffer = nullptr,
-              std::shared_ptr<data::Diagnostics> diagnostics_buffer = nullptr) override;
-
-    [[nodiscard]] double getSystemTime() const override;
-
-private:
-    void updateForces();
-    void calculateNextSystemState();
-
-private:
-    HermiteSettings settings_;
-
-    double system_time_ = 0.0;       // current time of the system
-    const double softening_sqr_;     // squared softening parameters
-    double potential_energy_ = 0.0;  // potential energy of the system
-
-    // state of the system at the previous step
-    std::shared_ptr<data::System> previous_system_ = nullptr;
-    std::shared_ptr<data::System> system_ = nullptr;  // system to write the new state to
-
-    std::vector<math::Vector3D> accelerations_;  // accelerations of the particles
-    std::vector<math::Vector3D> jerks_;          // jerks of the particles
 };
 
 }  // namespace enkas::simulation
@@ -23,6 +23,7 @@ public:
               std::shared_ptr<data::Diagnostics> diagnostics_buffer = nullptr) override;
 
     [[nodiscard]] double getSystemTime() const override;
+    [[nodiscard]] double getSofteningSqr() const override;
 
 private:
     void updateParticle(size_t particle_index);
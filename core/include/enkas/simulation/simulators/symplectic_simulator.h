@@ -0,0 +1,20 @@
+#pragma once
+
+#include <enkas/simulation/policies/force_backends.h>
+#include <enkas/simulation/policies/integrators.h>
+#include <enkas/simulation/settings/symplectic_settings.h>
+#include <enkas/simulation/simulators/composed_simulator.h>
+
+namespace enkas::simulation {
+
+extern template class ComposedSimulator<SplittingIntegrator, DirectForces>;
+
+/**
+ * @brief Fourth-order symplectic simulator with direct pair-wise force evaluation.
+ */
+class SymplecticSimulator : public ComposedSimulator<SplittingIntegrator, DirectForces> {
+public:
+    explicit SymplecticSimulator(const SymplecticSettings& settings);
+};
+
+}  // namespace enkas::simulation
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string_view>
+
+namespace enkas::tracing {
+
+/**
+ * @brief Percentiles of a latency histogram, in nanoseconds.
+ */
+struct LatencySummary {
+    uint64_t count = 0;
+    double mean_ns = 0.0;
+    uint64_t p50_ns = 0;
+    uint64_t p90_ns = 0;
+    uint64_t p99_ns = 0;
+    uint64_t p999_ns = 0;
+    uint64_t max_ns = 0;
+};
+
+/**
+ * @brief A lock-free histogram of durations with a bounded relative error.
+ *
+ * Durations are counted in log-linear buckets, as in an HDR histogram: every power of two is split
+ * into 32 equal buckets, so a percentile is off by at most about 3%. Recording is a few relaxed
+ * atomic increments and can happen from any number of threads while others read percentiles.
+ * Durations above roughly 18 minutes are counted as that.
+ */
+class LatencyHistogram {
+public:
+    static constexpr int kSubBucketBits = 5;
+    static constexpr int kMaxValueBits = 40;
+    static constexpr uint64_t kMaxValue = (uint64_t{1} << kMaxValueBits) - 1;
+    static constexpr size_t kSubBucketCount = size_t{1} << kSubBucketBits;
+    static constexpr size_t kBucketCount = (kMaxValueBits - kSubBucketBits + 1) * kSubBucketCount;
+
+    /**
+     * @brief Counts a duration. Negative durations are counted as zero.
+     */
+    void record(std::chrono::nanoseconds duration) noexcept;
+
+    /**
+     * @brief Returns the duration that @p fraction of the recorded durations do not exceed.
+     * @param fraction The percentile as a fraction in [0, 1], e.g. 0.99 for p99.
+     * @return The upper bound of the bucket that holds the percentile, in nanoseconds, or zero if
+     * nothing was recorded.
+     */
+    [[nodiscard]] uint64_t percentile(double fraction) const;
+
+    /**
+     * @brief Returns the count, mean, common percentiles and maximum in one pass.
+     */
+    [[nodiscard]] LatencySummary summary() const;
+
+    [[nodiscard]] uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+    [[nodiscard]] uint64_t max() const { return max_ns_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Returns the bucket a duration in nanoseconds is counted in.
+     */
+    [[nodiscard]] static size_t bucketIndex(uint64_t value_ns);
+
+    /**
+     * @brief Returns the largest duration in nanoseconds that is counted in a bucket.
+     */
+    [[nodiscard]] static uint64_t bucketUpperBound(size_t index);
+
+private:
+    /**
+     * @brief Copies the bucket counts and returns their sum.
+     */
+    uint64_t loadBuckets(std::array<uint64_t, kBucketCount>& counts) const;
+
+    std::array<std::atomic<uint64_t>, kBucketCount> buckets_{};
+    std::atomic<uint64_t> count_ = 0;
+    std::atomic<uint64_t> sum_ns_ = 0;
+    std::atomic<uint64_t> max_ns_ = 0;
+};
+
+/**
+ * @brief Records the time between its construction and destruction into a histogram.
+ * Does nothing, not even read the clock, if the histogram is null.
+ */
+class ScopedLatency {
+public:
+    explicit ScopedLatency(LatencyHistogram* histogram) noexcept
+        : histogram_(histogram),
+          start_(histogram ? std::chrono::steady_clock::now()
+                           : std::chrono::steady_clock::time_point{}) {}
+
+    ~ScopedLatency() {
+        if (histogram_) histogram_->record(std::chrono::steady_clock::now() - start_);
+    }
+
+    ScopedLatency(const ScopedLatency&) = delete;
+    ScopedLatency& operator=(const ScopedLatency&) = delete;
+
+private:
+    LatencyHistogram* histogram_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+/**
+ * @brief A histogram with the name it is reported under.
+ */
+struct NamedLatencyHistogram {
+    std::string_view name;
+    const LatencyHistogram* histogram;
+};
+
+/**
+ * @brief Writes the summaries of several histograms as CSV, one row per histogram.
+ * @param path The file to write.
+ * @param histograms The histograms in the order of the rows.
+ * @return True if the file was written.
+ */
+bool writeLatencyCsv(const std::filesystem::path& path,
+                     std::span<const NamedLatencyHistogram> histograms);
+
+}  // namespace enkas::tracing
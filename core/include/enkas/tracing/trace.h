@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+namespace enkas::tracing {
+
+/**
+ * @brief Whether the ENKAS_TRACE_* macros record anything in this build.
+ * Set with the CMake option ENKAS_ENABLE_TRACING.
+ */
+#ifdef ENKAS_ENABLE_TRACING
+inline constexpr bool kEnabled = true;
+#else
+inline constexpr bool kEnabled = false;
+#endif
+
+/**
+ * @brief The number of most recent events kept per thread.
+ */
+inline constexpr size_t kEventsPerThread = size_t{1} << 15;
+
+/**
+ * @brief The number of thread buffers above which buffers of exited threads are reused even if
+ * their events have not been written yet.
+ */
+inline constexpr size_t kMaxThreadBuffers = 64;
+
+/**
+ * @brief Records the wall-clock time between its construction and destruction as one event.
+ *
+ * Events go into a ring buffer owned by the calling thread, so recording never takes a lock. Each
+ * buffer keeps the most recent kEventsPerThread events. Use the ENKAS_TRACE_SCOPE macro rather
+ * than this class, so that zones vanish from builds without tracing.
+ */
+class Zone {
+public:
+    /**
+     * @param name The name of the zone. Must have static storage duration, e.g. a string literal.
+     */
+    explicit Zone(const char* name) noexcept;
+    ~Zone();
+
+    Zone(const Zone&) = delete;
+    Zone& operator=(const Zone&) = delete;
+
+private:
+    const char* name_;
+    int64_t start_ns_;
+};
+
+/**
+ * @brief Names the calling thread in the trace.
+ */
+void setThreadName(std::string name);
+
+/**
+ * @brief Writes the recorded events of all threads as Chrome trace-event JSON.
+ *
+ * The file can be opened in chrome://tracing or ui.perfetto.dev. Threads may keep recording while
+ * the trace is written, in which case the oldest events of a full buffer may be inconsistent.
+ *
+ * @param path The file to write. Missing parent directories are created.
+ * @return True if the file was written.
+ */
+bool writeChromeTrace(const std::filesystem::path& path);
+
+/**
+ * @brief Returns the number of thread buffers currently allocated.
+ *
+ * Each thread that records an event gets a buffer. When the thread exits, its buffer is reused
+ * by a new thread once its events have been written or cleared, or once kMaxThreadBuffers
+ * buffers exist.
+ */
+size_t threadBufferCount();
+
+/**
+ * @brief Discards all recorded events.
+ * Events that other threads record at the same time may be discarded as well, or kept.
+ */
+void clear();
+
+}  // namespace enkas::tracing
+
+// Macros for instrumentation
+// Without ENKAS_ENABLE_TRACING, they expand to nothing and their arguments are not evaluated.
+
+#ifdef ENKAS_ENABLE_TRACING
+#define ENKAS_TRACE_CONCAT_IMPL(a, b) a##b
+#define ENKAS_TRACE_CONCAT(a, b) ENKAS_TRACE_CONCAT_IMPL(a, b)
+#define ENKAS_TRACE_SCOPE(name) \
+    const enkas::tracing::Zone ENKAS_TRACE_CONCAT(enkas_trace_zone_, __LINE__)(name)
+#define ENKAS_TRACE_THREAD_NAME(name) enkas::tracing::setThreadName(name)
+#else
+#define ENKAS_TRACE_SCOPE(name) static_cast<void>(0)
+#define ENKAS_TRACE_THREAD_NAME(name) static_cast<void>(0)
+#endif
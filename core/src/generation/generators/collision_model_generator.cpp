@@ -1,97 +1,95 @@
 #include <enkas/data/system.h>
 #include <enkas/generation/generators/collision_model_generator.h>
 #include <enkas/generation/generators/plummer_sphere_generator.h>
-#include <enkas/logging/logger.h>
 #include <enkas/math/vector3d.h>
 #include <enkas/physics/helpers.h>
 
-#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <optional>
 
 namespace enkas::generation {
 
+namespace {
+PlummerSphereSettings sphere1Settings(const CollisionModelSettings& settings) {
+    PlummerSphereSettings plummer1_settings;
+    plummer1_settings.seed = settings.seed;
+    plummer1_settings.particle_count = settings.particle_count_1;
+    plummer1_settings.sphere_radius = settings.sphere_radius_1;
+    plummer1_settings.total_mass = settings.total_mass_1;
+    return plummer1_settings;
+}
+
+PlummerSphereSettings sphere2Settings(const CollisionModelSettings& settings) {
+    PlummerSphereSettings plummer2_settings;
+    plummer2_settings.seed = settings.seed + 1;  // Ensure different seed for second sphere
+    plummer2_settings.particle_count = settings.particle_count_2;
+    plummer2_settings.sphere_radius = settings.sphere_radius_2;
+    plummer2_settings.total_mass = settings.total_mass_2;
+    return plummer2_settings;
+}
+
+/**
+ * @brief Moves a range of particles by an offset in position and velocity.
+ */
+void shift(const data::SystemView& particles,
+           const math::Vector3D& position_offset,
+           const math::Vector3D& velocity_offset) {
+    for (size_t i = 0; i < particles.count(); ++i) {
+        particles.positions[i] += position_offset;
+        particles.velocities[i] += velocity_offset;
+    }
+}
+}  // namespace
+
 CollisionModelGenerator::CollisionModelGenerator(const CollisionModelSettings& settings)
-    : settings_(settings) {}
+    : settings_(settings),
+      sphere1_(sphere1Settings(settings)),
+      sphere2_(sphere2Settings(settings)) {}
 
-data::System CollisionModelGenerator::createSystem() {
-    auto& logger = logging::getLogger();
-    logger.info(std::source_location::current(), "Creating 'CollisionModel' system...");
+std::optional<size_t> CollisionModelGenerator::particleCount() const {
+    return *sphere1_.particleCount() + *sphere2_.particleCount();
+}
 
-    // Generate first Plummer sphere
-    PlummerSphereSettings plummer1_settings;
-    plummer1_settings.seed = settings_.seed;
-    plummer1_settings.particle_count = settings_.particle_count_1;
-    plummer1_settings.sphere_radius = settings_.sphere_radius_1;
-    plummer1_settings.total_mass = settings_.total_mass_1;
+void CollisionModelGenerator::generateRange(const data::SystemView& particles,
+                                            size_t first_index) const {
+    // Split the range at the boundary between the spheres.
+    const size_t sphere1_count = *sphere1_.particleCount();
+    const size_t end_index = first_index + particles.count();
 
-    data::System sphere1 = PlummerSphereGenerator(plummer1_settings).createSystem();
+    if (first_index < sphere1_count) {
+        const size_t count = std::min(end_index, sphere1_count) - first_index;
+        sphere1_.generateRange(particles.subview(0, count), first_index);
+    }
+    if (end_index > sphere1_count) {
+        const size_t begin_index = std::max(first_index, sphere1_count);
+        sphere2_.generateRange(
+            particles.subview(begin_index - first_index, end_index - begin_index),
+            begin_index - sphere1_count);
+    }
+}
 
-    // Generate second Plummer sphere
-    PlummerSphereSettings plummer2_settings;
-    plummer2_settings.seed = settings_.seed + 1;  // Ensure different seed for second sphere
-    plummer2_settings.particle_count = settings_.particle_count_2;
-    plummer2_settings.sphere_radius = settings_.sphere_radius_2;
-    plummer2_settings.total_mass = settings_.total_mass_2;
+void CollisionModelGenerator::finalize(const data::SystemView& particles) const {
+    const size_t sphere1_count = *sphere1_.particleCount();
+    const data::SystemView sphere1 = particles.subview(0, sphere1_count);
+    const data::SystemView sphere2 =
+        particles.subview(sphere1_count, particles.count() - sphere1_count);
 
-    data::System sphere2 = PlummerSphereGenerator(plummer2_settings).createSystem();
+    sphere1_.finalize(sphere1);
+    sphere2_.finalize(sphere2);
 
     const double avg_radius = (settings_.sphere_radius_1 + settings_.sphere_radius_2) / 2.0;
     const double separation_distance = avg_radius * 8.0;
 
-    // Move first sphere
-    for (auto& pos : sphere1.positions) {
-        pos.x += separation_distance / 2.0;
-        pos.y += settings_.impact_parameter / 2.0;
-    }
-
-    for (auto& vel : sphere1.velocities) {
-        vel.x -= settings_.relative_velocity / 2.0;
-    }
+    const math::Vector3D position_offset = {
+        separation_distance / 2.0, settings_.impact_parameter / 2.0, 0.0};
+    const math::Vector3D velocity_offset = {settings_.relative_velocity / 2.0, 0.0, 0.0};
 
-    // Move second sphere
-    for (auto& pos : sphere2.positions) {
-        pos.x -= separation_distance / 2.0;
-        pos.y -= settings_.impact_parameter / 2.0;
-    }
-
-    for (auto& vel : sphere2.velocities) {
-        vel.x += settings_.relative_velocity / 2.0;
-    }
+    // Move the spheres towards each other
+    shift(sphere1, position_offset, velocity_offset * -1.0);
+    shift(sphere2, position_offset * -1.0, velocity_offset);
 
-    // Combine both systems and center
-    data::System system;
-    const size_t total_particles = sphere1.count() + sphere2.count();
-
-    system.positions.reserve(total_particles);
-    system.velocities.reserve(total_particles);
-    system.masses.reserve(total_particles);
-
-    system.positions.insert(system.positions.end(),
-                            std::make_move_iterator(sphere1.positions.begin()),
-                            std::make_move_iterator(sphere1.positions.end()));
-    system.velocities.insert(system.velocities.end(),
-                             std::make_move_iterator(sphere1.velocities.begin()),
-                             std::make_move_iterator(sphere1.velocities.end()));
-    system.masses.insert(system.masses.end(),
-                         std::make_move_iterator(sphere1.masses.begin()),
-                         std::make_move_iterator(sphere1.masses.end()));
-
-    system.positions.insert(system.positions.end(),
-                            std::make_move_iterator(sphere2.positions.begin()),
-                            std::make_move_iterator(sphere2.positions.end()));
-    system.velocities.insert(system.velocities.end(),
-                             std::make_move_iterator(sphere2.velocities.begin()),
-                             std::make_move_iterator(sphere2.velocities.end()));
-    system.masses.insert(system.masses.end(),
-                         std::make_move_iterator(sphere2.masses.begin()),
-                         std::make_move_iterator(sphere2.masses.end()));
-
-    physics::centerSystem(system);
-
-    logger.info(std::source_location::current(),
-                "Finished 'CollisionModel' generation. Successfully loaded {} particles.",
-                system.positions.size());
-
-    return system;
+    physics::centerSystem(particles);
 }
 
 }  // namespace enkas::generation
@@ -1,10 +1,11 @@
 #include <enkas/data/system.h>
 #include <enkas/generation/generators/normal_sphere_generator.h>
-#include <enkas/logging/logger.h>
+#include <enkas/math/philox.h>
 #include <enkas/math/vector3d.h>
-#include <enkas/physics/helpers.h>
 
-#include <random>
+#include <cmath>
+#include <cstddef>
+#include <optional>
 #include <vector>
 
 namespace enkas::generation {
@@ -12,38 +13,26 @@ namespace enkas::generation {
 NormalSphereGenerator::NormalSphereGenerator(const NormalSphereSettings& settings)
     : settings_(settings) {}
 
-data::System NormalSphereGenerator::createSystem() {
-    ENKAS_LOG_INFO("Creating 'NormalSphere' system...");
-
-    data::System system;
-    const int particle_count = settings_.particle_count;
-
-    system.positions.reserve(particle_count);
-    system.velocities.reserve(particle_count);
-    system.masses.reserve(particle_count);
-
-    std::mt19937 gen(settings_.seed);
-
-    std::normal_distribution<double> pos_dist(0, settings_.position_std_dev);
-    std::normal_distribution<double> vel_dist(0, settings_.velocity_std_dev);
-    std::normal_distribution<double> mass_dist(settings_.mass_mean, settings_.mass_std_dev);
-
-    for (size_t i = 0; i < particle_count; i++) {
-        math::Vector3D position = {pos_dist(gen), pos_dist(gen), pos_dist(gen)};
-        math::Vector3D velocity = {vel_dist(gen), vel_dist(gen), vel_dist(gen)};
-        double particle_mass = std::abs(mass_dist(gen));
+std::optional<size_t> NormalSphereGenerator::particleCount() const {
+    return static_cast<size_t>(settings_.particle_count);
+}
 
-        system.positions.push_back(position);
-        system.velocities.push_back(velocity);
-        system.masses.push_back(particle_mass);
+void NormalSphereGenerator::generateRange(const data::SystemView& particles,
+                                          size_t first_index) const {
+    const double pos_std_dev = settings_.position_std_dev;
+    const double vel_std_dev = settings_.velocity_std_dev;
+
+    for (size_t i = 0; i < particles.count(); ++i) {
+        math::CounterRng gen(settings_.seed, first_index + i);
+
+        particles.positions[i] = {gen.normal(0.0, pos_std_dev),
+                                  gen.normal(0.0, pos_std_dev),
+                                  gen.normal(0.0, pos_std_dev)};
+        particles.velocities[i] = {gen.normal(0.0, vel_std_dev),
+                                   gen.normal(0.0, vel_std_dev),
+                                   gen.normal(0.0, vel_std_dev)};
+        particles.masses[i] = std::abs(gen.normal(settings_.mass_mean, settings_.mass_std_dev));
     }
-
-    physics::centerSystem(system);
-
-    ENKAS_LOG_INFO("Finished 'NormalSphere' generation. Successfully loaded {} particles.",
-                   system.positions.size());
-
-    return system;
 }
 
 }  // namespace enkas::generation
@@ -1,10 +1,11 @@
 #include <enkas/data/system.h>
 #include <enkas/generation/generators/uniform_cube_generator.h>
-#include <enkas/logging/logger.h>
+#include <enkas/math/philox.h>
 #include <enkas/math/vector3d.h>
 #include <enkas/physics/helpers.h>
 
-#include <random>
+#include <cstddef>
+#include <optional>
 #include <vector>
 
 namespace enkas::generation {
@@ -12,39 +13,39 @@ namespace enkas::generation {
 UniformCubeGenerator::UniformCubeGenerator(const UniformCubeSettings& settings)
     : settings_(settings) {}
 
-data::System UniformCubeGenerator::createSystem() {
-    ENKAS_LOG_INFO("Creating 'UniformCube' system...");
-
-    data::System system;
-    const int particle_count = settings_.particle_count;
-
-    system.positions.reserve(particle_count);
-    system.velocities.reserve(particle_count);
-    system.masses.reserve(particle_count);
+std::optional<size_t> UniformCubeGenerator::particleCount() const {
+    return static_cast<size_t>(settings_.particle_count);
+}
 
-    std::mt19937 gen(settings_.seed);
+std::optional<double> UniformCubeGenerator::potentialEnergy() const {
+    // W = -0.9411563 G M^2 / L for a homogeneous cube of side length L
+    // (Chappell, J. M. et al.; 2012; The gravitational potential energy of a cube)
+    constexpr double kCubeEnergyFactor = 0.9411563;
+    const double mass = settings_.total_mass;
+    const double continuum_energy =
+        -kCubeEnergyFactor * physics::G * mass * mass / settings_.side_length;
+    return physics::getSampledPotentialEnergy(continuum_energy, *particleCount());
+}
 
+void UniformCubeGenerator::generateRange(const data::SystemView& particles,
+                                         size_t first_index) const {
+    const int particle_count = settings_.particle_count;
     const double half_side = settings_.side_length / 2.0;
-    std::uniform_real_distribution<double> pos_dist(-half_side, half_side);
-    std::uniform_real_distribution<double> vel_dist(0.0, 1.0);
-
     const double particle_mass = settings_.total_mass / particle_count;
 
-    for (size_t i = 0; i < particle_count; i++) {
-        math::Vector3D position = {pos_dist(gen), pos_dist(gen), pos_dist(gen)};
-        math::Vector3D velocity = {vel_dist(gen), vel_dist(gen), vel_dist(gen)};
-        velocity.set_norm(settings_.initial_velocity);
-        system.positions.push_back(position);
-        system.velocities.push_back(velocity);
-        system.masses.push_back(particle_mass);
-    }
-
-    physics::centerSystem(system);
+    for (size_t i = 0; i < particles.count(); ++i) {
+        math::CounterRng gen(settings_.seed, first_index + i);
 
-    ENKAS_LOG_INFO("Finished 'UniformCube' generation. Successfully loaded {} particles.",
-                   system.positions.size());
+        const math::Vector3D position = {gen.uniform(-half_side, half_side),
+                                         gen.uniform(-half_side, half_side),
+                                         gen.uniform(-half_side, half_side)};
+        math::Vector3D velocity = {gen.uniform(), gen.uniform(), gen.uniform()};
+        velocity.set_norm(settings_.initial_velocity);
 
-    return system;
+        particles.positions[i] = position;
+        particles.velocities[i] = velocity;
+        particles.masses[i] = particle_mass;
+    }
 }
 
 }  // namespace enkas::generation
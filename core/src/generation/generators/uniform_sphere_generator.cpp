@@ -1,10 +1,11 @@
 #include <enkas/data/system.h>
 #include <enkas/generation/generators/uniform_sphere_generator.h>
-#include <enkas/logging/logger.h>
+#include <enkas/math/philox.h>
 #include <enkas/math/vector3d.h>
 #include <enkas/physics/helpers.h>
 
-#include <random>
+#include <cstddef>
+#include <optional>
 #include <vector>
 
 namespace enkas::generation {
@@ -12,45 +13,42 @@ namespace enkas::generation {
 UniformSphereGenerator::UniformSphereGenerator(const UniformSphereSettings& settings)
     : settings_(settings) {}
 
-data::System UniformSphereGenerator::createSystem() {
-    ENKAS_LOG_INFO("Creating 'UniformSphere' system...");
-
-    data::System system;
-    const int particle_count = settings_.particle_count;
-
-    system.positions.reserve(particle_count);
-    system.velocities.reserve(particle_count);
-    system.masses.reserve(particle_count);
+std::optional<size_t> UniformSphereGenerator::particleCount() const {
+    return static_cast<size_t>(settings_.particle_count);
+}
 
-    std::mt19937 gen(settings_.seed);
-    std::uniform_real_distribution<double> pos_dist(-settings_.sphere_radius,
-                                                    settings_.sphere_radius);
-    std::uniform_real_distribution<double> vel_dist(0.0, 1.0);
+std::optional<double> UniformSphereGenerator::potentialEnergy() const {
+    // W = -3 G M^2 / (5 R) for a homogeneous sphere of radius R
+    const double mass = settings_.total_mass;
+    const double continuum_energy =
+        -3.0 * physics::G * mass * mass / (5.0 * settings_.sphere_radius);
+    return physics::getSampledPotentialEnergy(continuum_energy, *particleCount());
+}
 
+void UniformSphereGenerator::generateRange(const data::SystemView& particles,
+                                           size_t first_index) const {
+    const int particle_count = settings_.particle_count;
+    const double radius = settings_.sphere_radius;
     const double particle_mass = settings_.total_mass / particle_count;
 
-    for (size_t i = 0; i < particle_count; i++) {
+    for (size_t i = 0; i < particles.count(); ++i) {
+        math::CounterRng gen(settings_.seed, first_index + i);
         math::Vector3D position;
 
         // Use a rejection technique to carve out a homogeneous sphere from a homogeneous cube.
         do {
-            position = {pos_dist(gen), pos_dist(gen), pos_dist(gen)};
-        } while (position.norm() > settings_.sphere_radius);
+            position = {gen.uniform(-radius, radius),
+                        gen.uniform(-radius, radius),
+                        gen.uniform(-radius, radius)};
+        } while (position.norm() > radius);
 
-        math::Vector3D velocity = {vel_dist(gen), vel_dist(gen), vel_dist(gen)};
+        math::Vector3D velocity = {gen.uniform(), gen.uniform(), gen.uniform()};
         velocity.set_norm(settings_.initial_velocity);
 
-        system.positions.push_back(position);
-        system.velocities.push_back(velocity);
-        system.masses.push_back(particle_mass);
+        particles.positions[i] = position;
+        particles.velocities[i] = velocity;
+        particles.masses[i] = particle_mass;
     }
-
-    physics::centerSystem(system);
-
-    ENKAS_LOG_INFO("Finished 'UniformSphere' generation. Successfully loaded {} particles.",
-                   system.positions.size());
-
-    return system;
 }
 
 }  // namespace enkas::generation
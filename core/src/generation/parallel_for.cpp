@@ -0,0 +1,34 @@
+#include <enkas/generation/parallel_for.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace enkas::generation {
+
+void parallelFor(size_t count,
+                 const std::function<void(size_t begin, size_t end)>& body,
+                 size_t thread_count,
+                 size_t min_items_per_thread) {
+    if (thread_count == 0) thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+    thread_count =
+        std::clamp<size_t>(count / std::max<size_t>(min_items_per_thread, 1), 1, thread_count);
+
+    if (thread_count == 1) {
+        if (count > 0) body(0, count);
+        return;
+    }
+
+    // The calling thread takes the first range, so only thread_count - 1 threads are started.
+    const size_t chunk_size = (count + thread_count - 1) / thread_count;
+    std::vector<std::jthread> threads;
+    threads.reserve(thread_count - 1);
+    for (size_t begin = chunk_size; begin < count; begin += chunk_size) {
+        threads.emplace_back(body, begin, std::min(begin + chunk_size, count));
+    }
+    body(0, std::min(chunk_size, count));
+}
+
+}  // namespace enkas::generation
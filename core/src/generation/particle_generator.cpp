@@ -0,0 +1,52 @@
+#include <enkas/data/system.h>
+#include <enkas/generation/parallel_for.h>
+#include <enkas/generation/particle_generator.h>
+#include <enkas/logging/logger.h>
+#include <enkas/physics/helpers.h>
+
+#include <cstddef>
+
+namespace enkas::generation {
+
+data::System ParticleGenerator::createSystem() {
+    data::System system;
+    generateInto(system);
+    return system;
+}
+
+void ParticleGenerator::generateInto(data::System& system) {
+    system.resize(particleCount().value_or(0));
+    static_cast<void>(generateInto(system.view()));
+}
+
+bool ParticleGenerator::generateInto(const data::SystemView& particles) const {
+    const size_t particle_count = particleCount().value_or(0);
+    if (particles.count() != particle_count) {
+        ENKAS_LOG_ERROR("Cannot generate {} particles of '{}' into a buffer of {} particles.",
+                        particle_count,
+                        name(),
+                        particles.count());
+        return false;
+    }
+
+    ENKAS_LOG_INFO("Creating '{}' system...", name());
+
+    parallelFor(
+        particle_count,
+        [&](size_t begin, size_t end) {
+            generateRange(particles.subview(begin, end - begin), begin);
+        },
+        thread_count_);
+    finalize(particles);
+
+    ENKAS_LOG_INFO("Finished '{}' generation. Successfully loaded {} particles.",
+                   name(),
+                   particle_count);
+    return true;
+}
+
+void ParticleGenerator::finalize(const data::SystemView& particles) const {
+    physics::centerSystem(particles);
+}
+
+}  // namespace enkas::generation
@@ -0,0 +1,102 @@
+#include <enkas/generation/generation_settings.h>
+#include <enkas/generation/settings_hash.h>
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace enkas::generation {
+
+namespace {
+constexpr uint64_t kFnvOffsetBasis = 0xCBF29CE484222325;
+constexpr uint64_t kFnvPrime = 0x100000001B3;
+
+/**
+ * @brief Appends the bytes of trivially copyable values to a byte string.
+ * Values are added field by field, so padding inside the settings structs never leaks in.
+ */
+class Serializer {
+public:
+    template <typename... Values>
+    void add(const Values&... values) {
+        (addBytes(std::bit_cast<std::array<std::byte, sizeof(Values)>>(values)), ...);
+    }
+
+    [[nodiscard]] std::vector<std::byte> take() { return std::move(bytes_); }
+
+private:
+    template <size_t N>
+    void addBytes(const std::array<std::byte, N>& bytes) {
+        bytes_.insert(bytes_.end(), bytes.begin(), bytes.end());
+    }
+
+    std::vector<std::byte> bytes_;
+};
+
+void addFields(Serializer& serializer, const NormalSphereSettings& s) {
+    serializer.add(s.seed,
+                   s.particle_count,
+                   s.position_std_dev,
+                   s.velocity_std_dev,
+                   s.mass_mean,
+                   s.mass_std_dev);
+}
+
+void addFields(Serializer& serializer, const UniformCubeSettings& s) {
+    serializer.add(s.seed, s.particle_count, s.side_length, s.initial_velocity, s.total_mass);
+}
+
+void addFields(Serializer& serializer, const UniformSphereSettings& s) {
+    serializer.add(s.seed, s.particle_count, s.sphere_radius, s.initial_velocity, s.total_mass);
+}
+
+void addFields(Serializer& serializer, const PlummerSphereSettings& s) {
+    serializer.add(s.seed, s.particle_count, s.sphere_radius, s.total_mass);
+}
+
+void addFields(Serializer& serializer, const SpiralGalaxySettings& s) {
+    serializer.add(s.seed,
+                   s.particle_count,
+                   s.num_arms,
+                   s.radius,
+                   s.total_mass,
+                   s.twist,
+                   s.black_hole_mass);
+}
+
+void addFields(Serializer& serializer, const CollisionModelSettings& s) {
+    serializer.add(s.seed,
+                   s.impact_parameter,
+                   s.relative_velocity,
+                   s.particle_count_1,
+                   s.sphere_radius_1,
+                   s.total_mass_1,
+                   s.particle_count_2,
+                   s.sphere_radius_2,
+                   s.total_mass_2);
+}
+}  // namespace
+
+std::vector<std::byte> serializeSettings(const Settings& settings) {
+    Serializer serializer;
+    serializer.add(kGeneratorVersion, static_cast<uint64_t>(settings.index()));
+    std::visit(
+        [&serializer](const auto& model_settings) { addFields(serializer, model_settings); },
+        settings);
+    return serializer.take();
+}
+
+uint64_t hashSettings(const Settings& settings) {
+    uint64_t hash = kFnvOffsetBasis;
+    for (const std::byte byte : serializeSettings(settings)) {
+        hash ^= static_cast<uint64_t>(byte);
+        hash *= kFnvPrime;
+    }
+    return hash;
+}
+
+}  // namespace enkas::generation
@@ -0,0 +1,144 @@
+#include <enkas/logging/logger.h>
+
+#include <chrono>
+#include <format>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace enkas::logging {
+
+namespace {
+/**
+ * @brief Formats a record into the line that is handed to the sink.
+ * @param out Receives the line. Its capacity is reused between records.
+ */
+void formatRecord(const LogRecord& record, std::string& out) {
+    out.clear();
+    std::format_to(std::back_inserter(out),
+                   "[{:%Y-%m-%d %H:%M:%S}] [{}:{}] [{}] {}",
+                   record.time,
+                   get_filename(record.file),
+                   record.line,
+                   logLevelToString(record.level),
+                   record.message);
+}
+}  // namespace
+
+Logger::Logger() = default;
+
+Logger::~Logger() {
+    is_shutting_down_.store(true, std::memory_order_release);
+    published_.fetch_add(1, std::memory_order_seq_cst);
+    published_.notify_one();
+    if (writer_.joinable()) writer_.join();
+}
+
+void Logger::configure(LogLevel level, std::shared_ptr<LogSink> sink) {
+    flush();
+
+    {
+        std::scoped_lock lock(sink_mutex_);
+        sink_ = std::move(sink);
+        if (!writer_.joinable()) writer_ = std::thread(&Logger::writeLoop, this);
+        level_.store(sink_ ? level : LogLevel::NONE, std::memory_order_relaxed);
+    }
+}
+
+void Logger::flush() {
+    // Records that are still being pushed count as well, the writer waits for them in order.
+    const size_t target = queue_.pushCount();
+    size_t written = written_.load(std::memory_order_acquire);
+    while (written < target) {
+        written_.wait(written, std::memory_order_acquire);
+        written = written_.load(std::memory_order_acquire);
+    }
+}
+
+void Logger::enqueue(LogRecord&& record) {
+    if (record.level >= LogLevel::CRITICAL) {
+        writeNow(record);
+        return;
+    }
+
+    if (!queue_.tryPush(std::move(record))) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        dropped_total_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    published_.fetch_add(1, std::memory_order_seq_cst);
+    if (writer_is_waiting_.exchange(false, std::memory_order_seq_cst)) {
+        published_.notify_one();
+    }
+}
+
+void Logger::writeLoop() {
+    while (true) {
+        // Read before draining, so a push after the drain changes the value and ends the wait.
+        const uint32_t published = published_.load(std::memory_order_seq_cst);
+        if (writeQueued() > 0) continue;
+        if (is_shutting_down_.load(std::memory_order_acquire)) return;
+
+        // The flag is published before the value is rechecked, so a producer either sees the flag
+        // and notifies, or this thread sees the new value and does not sleep.
+        writer_is_waiting_.store(true, std::memory_order_seq_cst);
+        if (published_.load(std::memory_order_seq_cst) == published) {
+            published_.wait(published, std::memory_order_seq_cst);
+        }
+        writer_is_waiting_.store(false, std::memory_order_relaxed);
+    }
+}
+
+size_t Logger::writeQueued() {
+    std::scoped_lock lock(sink_mutex_);
+    return writeQueuedLocked();
+}
+
+void Logger::writeNow(const LogRecord& record) {
+    std::scoped_lock lock(sink_mutex_);
+    writeQueuedLocked();  // Earlier records first, so that the order is kept
+    if (!sink_) return;
+
+    std::string line;
+    formatRecord(record, line);
+    sink_->log(record.level, line);
+    sink_->flush();
+}
+
+size_t Logger::writeQueuedLocked() {
+    LogRecord record;
+    std::string line;
+    size_t count = 0;
+    while (queue_.tryPop(record)) {
+        if (sink_) {
+            formatRecord(record, line);
+            sink_->log(record.level, line);
+        }
+        ++count;
+    }
+
+    if (const size_t dropped = dropped_.exchange(0, std::memory_order_relaxed);
+        dropped > 0 && sink_) {
+        formatRecord({.level = LogLevel::WARNING,
+                      .time = std::chrono::system_clock::now(),
+                      .file = __FILE__,
+                      .line = __LINE__,
+                      .message = std::format("Dropped {} log messages, the queue was full.",
+                                             dropped)},
+                     line);
+        sink_->log(LogLevel::WARNING, line);
+    }
+
+    if (count > 0) {
+        if (sink_) sink_->flush();
+        written_.fetch_add(count, std::memory_order_release);
+        written_.notify_all();
+    }
+    return count;
+}
+
+}  // namespace enkas::logging
@@ -0,0 +1,65 @@
+#include <enkas/data/system.h>
+#include <enkas/math/vector3d.h>
+#include <enkas/physics/morton_order.h>
+#include <enkas/tracing/trace.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace enkas::physics {
+
+namespace {
+// Number of grid cells along each axis of the bounding box, the most a 63 bit key can hold.
+constexpr double kGridSize = static_cast<double>(uint32_t{1} << 21);
+
+/**
+ * @brief Maps a coordinate to its grid cell. Values outside the grid, including NaN, are clamped.
+ */
+uint32_t toCell(double value, double min, double cells_per_unit) {
+    const double cell = (value - min) * cells_per_unit;
+    if (!(cell > 0.0)) return 0;
+    return static_cast<uint32_t>(std::min(cell, kGridSize - 1.0));
+}
+}  // namespace
+
+std::vector<size_t> getMortonOrder(const data::System& system) {
+    ENKAS_TRACE_SCOPE("Morton Order");
+    const size_t particle_count = system.count();
+    if (particle_count == 0) return {};
+
+    math::Vector3D min_point = system.positions[0];
+    math::Vector3D max_point = system.positions[0];
+    for (const auto& pos : system.positions) {
+        min_point.x = std::min(pos.x, min_point.x);
+        min_point.y = std::min(pos.y, min_point.y);
+        min_point.z = std::min(pos.z, min_point.z);
+        max_point.x = std::max(pos.x, max_point.x);
+        max_point.y = std::max(pos.y, max_point.y);
+        max_point.z = std::max(pos.z, max_point.z);
+    }
+
+    // Use cubic cells, so the curve does not favor any axis
+    const double extent = std::max({max_point.x - min_point.x,
+                                    max_point.y - min_point.y,
+                                    max_point.z - min_point.z});
+    const double cells_per_unit = extent > 0.0 ? kGridSize / extent : 0.0;
+
+    std::vector<std::pair<uint64_t, size_t>> keys(particle_count);
+    for (size_t i = 0; i < particle_count; ++i) {
+        const auto& pos = system.positions[i];
+        keys[i] = {mortonKey(toCell(pos.x, min_point.x, cells_per_unit),
+                             toCell(pos.y, min_point.y, cells_per_unit),
+                             toCell(pos.z, min_point.z, cells_per_unit)),
+                   i};
+    }
+    std::sort(keys.begin(), keys.end());
+
+    std::vector<size_t> order(particle_count);
+    for (size_t k = 0; k < particle_count; ++k) order[k] = keys[k].second;
+    return order;
+}
+
+}  // namespace enkas::physics
@@ -0,0 +1,48 @@
+#include <enkas/simulation/policies/integrators.h>
+#include <enkas/simulation/settings/symplectic_settings.h>
+
+#include <array>
+
+namespace enkas::simulation {
+
+namespace {
+// Yoshida's triple jump weight 1 / (2 - 2^(1/3)); the middle jump is 1 - 2 * kTripleJump.
+constexpr double kTripleJump = 1.3512071919596578;
+constexpr double kTripleJumpMiddle = 1.0 - 2.0 * kTripleJump;
+
+constexpr std::array kYoshidaDrifts = {0.0, kTripleJump, kTripleJumpMiddle, kTripleJump, 0.0};
+constexpr std::array kYoshidaKicks = {0.5 * kTripleJump,
+                                      0.5 * (kTripleJump + kTripleJumpMiddle),
+                                      0.5 * (kTripleJump + kTripleJumpMiddle),
+                                      0.5 * kTripleJump};
+
+constexpr std::array kForestRuthDrifts = {0.5 * kTripleJump,
+                                          0.5 * (kTripleJump + kTripleJumpMiddle),
+                                          0.5 * (kTripleJump + kTripleJumpMiddle),
+                                          0.5 * kTripleJump};
+constexpr std::array kForestRuthKicks = {kTripleJump, kTripleJumpMiddle, kTripleJump};
+
+// Coefficients of the position extended Forest-Ruth like algorithm
+constexpr double kPefrlXi = 0.1786178958448091;
+constexpr double kPefrlLambda = -0.2123418310626054;
+constexpr double kPefrlChi = -0.06626458266981849;
+
+constexpr std::array kPefrlDrifts = {
+    kPefrlXi, kPefrlChi, 1.0 - 2.0 * (kPefrlChi + kPefrlXi), kPefrlChi, kPefrlXi};
+constexpr std::array kPefrlKicks = {
+    0.5 * (1.0 - 2.0 * kPefrlLambda), kPefrlLambda, kPefrlLambda, 0.5 * (1.0 - 2.0 * kPefrlLambda)};
+}  // namespace
+
+SplittingScheme getSplittingScheme(SplittingCoefficients coefficients) {
+    switch (coefficients) {
+        case SplittingCoefficients::ForestRuth:
+            return {kForestRuthDrifts, kForestRuthKicks};
+        case SplittingCoefficients::PEFRL:
+            return {kPefrlDrifts, kPefrlKicks};
+        case SplittingCoefficients::Yoshida:
+        default:
+            return {kYoshidaDrifts, kYoshidaKicks};
+    }
+}
+
+}  // namespace enkas::simulation
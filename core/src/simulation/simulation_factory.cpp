@@ -1,17 +1,78 @@
 #include <enkas/logging/logger.h>
+#include <enkas/simulation/policies/force_backends.h>
+#include <enkas/simulation/policies/integrators.h>
 #include <enkas/simulation/simulation_factory.h>
 #include <enkas/simulation/simulation_settings.h>
 #include <enkas/simulation/simulator.h>
 #include <enkas/simulation/simulators/barneshutleapfrog_simulator.h>
+#include <enkas/simulation/simulators/barneshutsymplectic_simulator.h>
+#include <enkas/simulation/simulators/composed_simulator.h>
 #include <enkas/simulation/simulators/euler_simulator.h>
 #include <enkas/simulation/simulators/hermite_simulator.h>
 #include <enkas/simulation/simulators/hits_simulator.h>
 #include <enkas/simulation/simulators/leapfrog_simulator.h>
+#include <enkas/simulation/simulators/symplectic_simulator.h>
 
+#include <cstddef>
 #include <memory>
+#include <utility>
 
 namespace enkas::simulation {
 
+namespace {
+template <typename Integrator, typename Backend>
+std::unique_ptr<Simulator> compose(Integrator integrator,
+                                   Backend backend,
+                                   size_t reorder_interval) {
+    if constexpr (ComposableWith<Integrator, Backend>) {
+        return std::make_unique<ComposedSimulator<Integrator, Backend>>(
+            std::move(integrator), std::move(backend), reorder_interval);
+    } else {
+        ENKAS_LOG_ERROR(
+            "The {} integrator cannot use {} forces.", Integrator::kName, Backend::kName);
+        return nullptr;
+    }
+}
+
+template <typename Integrator>
+std::unique_ptr<Simulator> composeWithBackend(Integrator integrator,
+                                              const ComposedSettings& settings) {
+    switch (settings.force_method) {
+        case ForceMethod::Direct:
+            return compose(std::move(integrator),
+                           DirectForces(settings.softening_parameter),
+                           settings.reorder_interval);
+        case ForceMethod::ParallelDirect:
+            return compose(
+                std::move(integrator),
+                ParallelDirectForces(settings.softening_parameter, settings.thread_count),
+                settings.reorder_interval);
+        case ForceMethod::BarnesHut:
+            return compose(std::move(integrator),
+                           TreeForces(settings.theta_mac, settings.softening_parameter),
+                           settings.reorder_interval);
+    }
+    ENKAS_LOG_CRITICAL("Unhandled force method in Factory. No simulator created.");
+    return nullptr;
+}
+
+std::unique_ptr<Simulator> createComposed(const ComposedSettings& settings) {
+    switch (settings.integrator) {
+        case IntegratorMethod::Euler:
+            return composeWithBackend(EulerIntegrator(settings.time_step), settings);
+        case IntegratorMethod::Leapfrog:
+            return composeWithBackend(LeapfrogIntegrator(settings.time_step), settings);
+        case IntegratorMethod::Hermite:
+            return composeWithBackend(HermiteIntegrator(settings.time_step), settings);
+        case IntegratorMethod::Symplectic:
+            return composeWithBackend(
+                SplittingIntegrator(settings.time_step, settings.coefficients), settings);
+    }
+    ENKAS_LOG_CRITICAL("Unhandled integrator in Factory. No simulator created.");
+    return nullptr;
+}
+}  // namespace
+
 std::unique_ptr<Simulator> Factory::create(const Settings& settings) {
     ENKAS_LOG_INFO("Attempting to create simulator from settings...");
 
@@ -34,6 +95,12 @@ std::unique_ptr<Simulator> Factory::create(const Settings& settings) {
                 return std::make_unique<HitsSimulator>(specific_settings);
             } else if constexpr (std::is_same_v<SettingsType, BarnesHutLeapfrogSettings>) {
                 return std::make_unique<BarnesHutLeapfrogSimulator>(specific_settings);
+            } else if constexpr (std::is_same_v<SettingsType, SymplecticSettings>) {
+                return std::make_unique<SymplecticSimulator>(specific_settings);
+            } else if constexpr (std::is_same_v<SettingsType, BarnesHutSymplecticSettings>) {
+                return std::make_unique<BarnesHutSymplecticSimulator>(specific_settings);
+            } else if constexpr (std::is_same_v<SettingsType, ComposedSettings>) {
+                return createComposed(specific_settings);
             } else {
                 // Development error: if we reach here, it means we have an unsupported settings
                 // type. This should never happen if the settings are properly defined.
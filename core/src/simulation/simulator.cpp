@@ -0,0 +1,31 @@
+#include <enkas/data/system.h>
+#include <enkas/logging/logger.h>
+#include <enkas/physics/helpers.h>
+#include <enkas/simulation/simulator.h>
+
+#include <cmath>
+#include <optional>
+#include <utility>
+
+namespace enkas::simulation {
+
+void Simulator::scaleInitialSystem(data::System& system, double softening) {
+    const double e_kin = physics::getKineticEnergy(system);
+
+    // The hint only applies to the system it was set for. Small systems use the exact softened sum,
+    // which an analytic hint only approximates.
+    const auto hint = std::exchange(potential_energy_hint_, std::nullopt);
+    double e_pot = 0.0;
+    if (hint && system.count() >= kMinHintedParticles) {
+        e_pot = *hint;
+        ENKAS_LOG_DEBUG("Using the potential energy hint: {:.4e}.", e_pot);
+    } else {
+        e_pot = physics::getPotentialEnergy(system, softening) * physics::G;
+    }
+
+    const double total_energy = std::abs(e_kin + e_pot);
+    physics::scaleToHenonUnits(system, total_energy);
+    ENKAS_LOG_DEBUG("Scaling to Hénon units with total energy: {:.4e}.", total_energy);
+}
+
+}  // namespace enkas::simulation
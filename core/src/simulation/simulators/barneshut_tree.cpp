@@ -1,6 +1,7 @@
 #include <enkas/data/system.h>
 #include <enkas/math/vector3d.h>
 #include <enkas/simulation/simulators/barneshut_tree.h>
+#include <enkas/tracing/trace.h>
 
 #include <algorithm>
 #include <cmath>
@@ -228,6 +229,8 @@ BarnesHutTree::BarnesHutTree(BarnesHutTree&&) noexcept = default;
 BarnesHutTree& BarnesHutTree::operator=(BarnesHutTree&&) noexcept = default;
 
 void BarnesHutTree::build(const data::System& system) {
+    ENKAS_TRACE_SCOPE("Tree Build");
+
     if (system.count() == 0) {
         root_ = nullptr;
         return;
@@ -269,6 +272,8 @@ double BarnesHutTree::updateForces(const data::System& system,
                                    double theta_mac_sqr,
                                    double softening_sqr,
                                    std::vector<math::Vector3D>& out_acc) const {
+    ENKAS_TRACE_SCOPE("Tree Walk");
+
     const size_t particle_count = system.count();
     if (!root_ || particle_count == 0) return 0.0;
 
@@ -0,0 +1,16 @@
+#include <enkas/simulation/policies/force_backends.h>
+#include <enkas/simulation/policies/integrators.h>
+#include <enkas/simulation/simulators/barneshutsymplectic_simulator.h>
+#include <enkas/simulation/simulators/composed_simulator.h>
+
+namespace enkas::simulation {
+
+template class ComposedSimulator<SplittingIntegrator, TreeForces>;
+
+BarnesHutSymplecticSimulator::BarnesHutSymplecticSimulator(
+    const BarnesHutSymplecticSettings& settings)
+    : ComposedSimulator(SplittingIntegrator(settings.time_step, settings.coefficients),
+                        TreeForces(settings.theta_mac, settings.softening_parameter),
+                        settings.reorder_interval) {}
+
+}  // namespace enkas::simulation
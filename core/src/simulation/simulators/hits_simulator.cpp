@@ -3,6 +3,7 @@
 #include <enkas/math/vector3d.h>
 #include <enkas/physics/helpers.h>
 #include <enkas/simulation/simulators/hits_simulator.h>
+#include <enkas/tracing/trace.h>
 
 #include <cmath>
 #include <vector>
@@ -31,11 +32,7 @@ void HitsSimulator::initialize(std::shared_ptr<data::System> initial_system,
     ENKAS_LOG_DEBUG("System contains {} particles.", particle_count);
 
     // Scale particles to Hénon Units.
-    const double e_kin = physics::getKineticEnergy(*system_);
-    const double e_pot = physics::getPotentialEnergy(*system_, softening_sqr_);
-    const double total_energy = std::abs(e_kin + e_pot * physics::G);
-    physics::scaleToHenonUnits(*system_, total_energy);
-    ENKAS_LOG_DEBUG("Scaling to Hénon units with total energy: {:.4e}", total_energy);
+    scaleInitialSystem(*system_, softening_sqr_);
 
     // Update system masses after scaling
     temp_system_->masses = system_->masses;
@@ -73,6 +70,7 @@ void HitsSimulator::step(std::shared_ptr<data::System> system_buffer,
 
     // If diagnostics buffer is provided, fill it with the current diagnostics data
     if (diagnostics_buffer) {
+        ENKAS_TRACE_SCOPE("Diagnostics");
         predictSystem(*system_, *temp_system_, system_time_, true);
         physics::fillDiagnostics(*temp_system_,
                                  physics::getPotentialEnergy(*temp_system_, softening_sqr_),
@@ -99,14 +97,21 @@ void HitsSimulator::calculateNextSystemState() {
 
 [[nodiscard]] double HitsSimulator::getSystemTime() const { return system_time_; }
 
+[[nodiscard]] double HitsSimulator::getSofteningSqr() const { return softening_sqr_; }
+
 void HitsSimulator::updateParticle(size_t particle_index) {
+    ENKAS_TRACE_SCOPE("Particle Update");
+
     // Predictor
     predictSystem(*system_, *temp_system_, system_time_, false);
 
     // Evaluator
     math::Vector3D acc;
     math::Vector3D jrk;
-    calculateAccJrk(*temp_system_, particle_index, acc, jrk);
+    {
+        const tracing::ScopedLatency latency(force_latency_);
+        calculateAccJrk(*temp_system_, particle_index, acc, jrk);
+    }
 
     // Corrector
     correctParticle(*temp_system_, particle_index, acc, jrk);
@@ -0,0 +1,14 @@
+#include <enkas/simulation/policies/force_backends.h>
+#include <enkas/simulation/policies/integrators.h>
+#include <enkas/simulation/simulators/composed_simulator.h>
+#include <enkas/simulation/simulators/symplectic_simulator.h>
+
+namespace enkas::simulation {
+
+template class ComposedSimulator<SplittingIntegrator, DirectForces>;
+
+SymplecticSimulator::SymplecticSimulator(const SymplecticSettings& settings)
+    : ComposedSimulator(SplittingIntegrator(settings.time_step, settings.coefficients),
+                        DirectForces(settings.softening_parameter)) {}
+
+}  // namespace enkas::simulation
@@ -0,0 +1,143 @@
+#include <enkas/logging/logger.h>
+#include <enkas/tracing/latency_histogram.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <span>
+#include <string>
+
+namespace enkas::tracing {
+
+namespace {
+using BucketCounts = std::array<uint64_t, LatencyHistogram::kBucketCount>;
+
+/**
+ * @brief Returns the number of durations up to which a percentile reaches, at least one.
+ */
+uint64_t rankOf(double fraction, uint64_t total) {
+    const double rank = std::ceil(std::clamp(fraction, 0.0, 1.0) * static_cast<double>(total));
+    return std::max<uint64_t>(static_cast<uint64_t>(rank), 1);
+}
+
+/**
+ * @brief Finds the upper bound of the bucket that holds the duration with the given rank.
+ */
+uint64_t valueAtRank(const BucketCounts& counts, uint64_t rank) {
+    uint64_t seen = 0;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        seen += counts[i];
+        if (seen >= rank) return LatencyHistogram::bucketUpperBound(i);
+    }
+    return LatencyHistogram::kMaxValue;
+}
+}  // namespace
+
+void LatencyHistogram::record(std::chrono::nanoseconds duration) noexcept {
+    const uint64_t value = std::min<uint64_t>(std::max<int64_t>(duration.count(), 0), kMaxValue);
+
+    buckets_[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_ns_.fetch_add(value, std::memory_order_relaxed);
+
+    uint64_t max = max_ns_.load(std::memory_order_relaxed);
+    while (value > max && !max_ns_.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+    }
+}
+
+uint64_t LatencyHistogram::percentile(double fraction) const {
+    BucketCounts counts;
+    const uint64_t total = loadBuckets(counts);
+    if (total == 0) return 0;
+
+    return std::min(valueAtRank(counts, rankOf(fraction, total)), max());
+}
+
+LatencySummary LatencyHistogram::summary() const {
+    // Take one snapshot of the buckets, so that all percentiles are consistent with each other.
+    BucketCounts counts;
+    const uint64_t total = loadBuckets(counts);
+    if (total == 0) return {};
+
+    const uint64_t max_ns = max();
+    const auto at = [&](double fraction) {
+        return std::min(valueAtRank(counts, rankOf(fraction, total)), max_ns);
+    };
+
+    return {.count = total,
+            .mean_ns = static_cast<double>(sum_ns_.load(std::memory_order_relaxed)) /
+                       static_cast<double>(total),
+            .p50_ns = at(0.5),
+            .p90_ns = at(0.9),
+            .p99_ns = at(0.99),
+            .p999_ns = at(0.999),
+            .max_ns = max_ns};
+}
+
+uint64_t LatencyHistogram::loadBuckets(std::array<uint64_t, kBucketCount>& counts) const {
+    uint64_t total = 0;
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        counts[i] = buckets_[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+    return total;
+}
+
+size_t LatencyHistogram::bucketIndex(uint64_t value_ns) {
+    const uint64_t value = std::min(value_ns, kMaxValue);
+
+    // Small durations get a bucket each.
+    if (value < 2 * kSubBucketCount) return static_cast<size_t>(value);
+
+    // Above, each power of two gets kSubBucketCount buckets, selected by the bits below the
+    // highest set bit.
+    const int shift = std::bit_width(value) - 1 - kSubBucketBits;
+    const size_t sub_bucket = static_cast<size_t>(value >> shift) - kSubBucketCount;
+    return static_cast<size_t>(shift + 1) * kSubBucketCount + sub_bucket;
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t index) {
+    if (index < 2 * kSubBucketCount) return index;
+
+    const size_t shift = index / kSubBucketCount - 1;
+    const uint64_t lower = static_cast<uint64_t>(kSubBucketCount + index % kSubBucketCount)
+                           << shift;
+    return lower + (uint64_t{1} << shift) - 1;
+}
+
+bool writeLatencyCsv(const std::filesystem::path& path,
+                     std::span<const NamedLatencyHistogram> histograms) {
+    std::string csv = "stage,count,mean_ns,p50_ns,p90_ns,p99_ns,p999_ns,max_ns\n";
+    for (const auto& [name, histogram] : histograms) {
+        if (!histogram) continue;
+
+        const LatencySummary summary = histogram->summary();
+        std::format_to(std::back_inserter(csv),
+                       "{},{},{:.0f},{},{},{},{},{}\n",
+                       name,
+                       summary.count,
+                       summary.mean_ns,
+                       summary.p50_ns,
+                       summary.p90_ns,
+                       summary.p99_ns,
+                       summary.p999_ns,
+                       summary.max_ns);
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file || !file.write(csv.data(), static_cast<std::streamsize>(csv.size()))) {
+        ENKAS_LOG_ERROR("Failed to write latency file: {}", path.string());
+        return false;
+    }
+    return true;
+}
+
+}  // namespace enkas::tracing
@@ -0,0 +1,248 @@
+#include <enkas/logging/logger.h>
+#include <enkas/tracing/trace.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace enkas::tracing {
+
+namespace {
+constexpr size_t kEventMask = kEventsPerThread - 1;
+static_assert((kEventsPerThread & kEventMask) == 0, "The buffer size must be a power of two");
+
+// The fields are atomics only so that a dump may read a slot the owner is overwriting.
+struct EventSlot {
+    std::atomic<const char*> name{nullptr};
+    std::atomic<int64_t> start_ns{0};
+    std::atomic<int64_t> duration_ns{0};
+};
+
+struct ThreadBuffer {
+    uint32_t thread_id = 0;     // Guarded by the registry mutex
+    std::string name;           // Guarded by the registry mutex
+    bool in_use = true;         // Whether a thread owns the buffer, guarded by the registry mutex
+    uint64_t written_head = 0;  // head at the last trace write or clear, guarded by the mutex
+    std::unique_ptr<EventSlot[]> slots = std::make_unique<EventSlot[]>(kEventsPerThread);
+    std::atomic<uint64_t> head{0};  // Number of events recorded, written by the owner only
+
+    // Called with the registry mutex held, while no thread owns the buffer.
+    void reset(uint32_t id) {
+        thread_id = id;
+        name.clear();
+        in_use = true;
+        written_head = 0;
+        for (size_t i = 0; i < kEventsPerThread; ++i) {
+            slots[i].name.store(nullptr, std::memory_order_relaxed);
+        }
+        head.store(0, std::memory_order_relaxed);
+    }
+};
+
+/**
+ * @brief Owns the buffers of all threads that have recorded an event.
+ *
+ * Buffers outlive their threads, so a trace written at the end of a run includes the workers.
+ * Once a thread has exited and its events have been written, its buffer goes to the next new
+ * thread, so that runs which start new threads do not grow the registry.
+ */
+class Registry {
+public:
+    std::shared_ptr<ThreadBuffer> registerThread() {
+        std::scoped_lock lock(mutex_);
+        const auto id = static_cast<uint32_t>(++thread_count_);
+
+        const auto is_free = [](const auto& buffer) { return !buffer->in_use; };
+        auto it = std::find_if(buffers_.begin(), buffers_.end(), [&](const auto& buffer) {
+            return is_free(buffer) &&
+                   buffer->written_head == buffer->head.load(std::memory_order_relaxed);
+        });
+        // At the cap, the events of an exited thread are dropped rather than growing further
+        if (it == buffers_.end() && buffers_.size() >= kMaxThreadBuffers) {
+            it = std::find_if(buffers_.begin(), buffers_.end(), is_free);
+        }
+        if (it != buffers_.end()) {
+            (*it)->reset(id);
+            return *it;
+        }
+
+        auto buffer = std::make_shared<ThreadBuffer>();
+        buffer->thread_id = id;
+        buffers_.push_back(buffer);
+        return buffer;
+    }
+
+    void releaseThread(ThreadBuffer& buffer) {
+        std::scoped_lock lock(mutex_);
+        buffer.in_use = false;
+    }
+
+    int64_t nowNs() const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now() - epoch_)
+            .count();
+    }
+
+    std::mutex& mutex() { return mutex_; }
+    const std::vector<std::shared_ptr<ThreadBuffer>>& buffers() const { return buffers_; }
+
+private:
+    const std::chrono::steady_clock::time_point epoch_ = std::chrono::steady_clock::now();
+    std::mutex mutex_;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+    size_t thread_count_ = 0;  // Number of threads ever registered, for unique trace ids
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+/**
+ * @brief Holds the buffer of the calling thread and hands it back when the thread exits.
+ */
+class ThreadHandle {
+public:
+    ThreadHandle() : buffer_(registry().registerThread()) {}
+    ~ThreadHandle() { registry().releaseThread(*buffer_); }
+
+    ThreadHandle(const ThreadHandle&) = delete;
+    ThreadHandle& operator=(const ThreadHandle&) = delete;
+
+    ThreadBuffer& buffer() const { return *buffer_; }
+
+private:
+    std::shared_ptr<ThreadBuffer> buffer_;
+};
+
+ThreadBuffer& threadBuffer() {
+    thread_local const ThreadHandle handle;
+    return handle.buffer();
+}
+
+/**
+ * @brief Appends @p text as a JSON string literal.
+ */
+void appendJsonString(std::string& out, std::string_view text) {
+    out += '"';
+    for (const char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            std::format_to(std::back_inserter(out), "\\u{:04x}", static_cast<int>(c));
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+}  // namespace
+
+Zone::Zone(const char* name) noexcept : name_(name), start_ns_(registry().nowNs()) {}
+
+Zone::~Zone() {
+    const int64_t end_ns = registry().nowNs();
+    ThreadBuffer& buffer = threadBuffer();
+
+    const uint64_t head = buffer.head.load(std::memory_order_relaxed);
+    EventSlot& slot = buffer.slots[head & kEventMask];
+    slot.name.store(name_, std::memory_order_relaxed);
+    slot.start_ns.store(start_ns_, std::memory_order_relaxed);
+    slot.duration_ns.store(end_ns - start_ns_, std::memory_order_relaxed);
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+void setThreadName(std::string name) {
+    ThreadBuffer& buffer = threadBuffer();
+    std::scoped_lock lock(registry().mutex());
+    buffer.name = std::move(name);
+}
+
+bool writeChromeTrace(const std::filesystem::path& path) {
+    std::string json = R"({"displayTimeUnit":"ms","traceEvents":[)";
+    bool first = true;
+    const auto begin_event = [&] {
+        if (!first) json += ",\n";
+        first = false;
+    };
+
+    size_t event_count = 0;
+    {
+        std::scoped_lock lock(registry().mutex());
+        for (const auto& buffer : registry().buffers()) {
+            if (!buffer->name.empty()) {
+                begin_event();
+                std::format_to(std::back_inserter(json),
+                               R"({{"name":"thread_name","ph":"M","pid":1,"tid":{})"
+                               R"(,"args":{{"name":)",
+                               buffer->thread_id);
+                appendJsonString(json, buffer->name);
+                json += "}}";
+            }
+
+            const uint64_t head = buffer->head.load(std::memory_order_acquire);
+            buffer->written_head = head;
+            const uint64_t first_event = head > kEventsPerThread ? head - kEventsPerThread : 0;
+            for (uint64_t i = first_event; i < head; ++i) {
+                const EventSlot& slot = buffer->slots[i & kEventMask];
+                const char* name = slot.name.load(std::memory_order_relaxed);
+                if (name == nullptr) continue;
+
+                begin_event();
+                json += R"({"name":)";
+                appendJsonString(json, name);
+                // Chrome trace timestamps are in microseconds.
+                std::format_to(std::back_inserter(json),
+                               R"(,"cat":"enkas","ph":"X","ts":{:.3f},"dur":{:.3f})"
+                               R"(,"pid":1,"tid":{}}})",
+                               slot.start_ns.load(std::memory_order_relaxed) / 1e3,
+                               slot.duration_ns.load(std::memory_order_relaxed) / 1e3,
+                               buffer->thread_id);
+                ++event_count;
+            }
+        }
+    }
+    json += "]}\n";
+
+    std::error_code error;
+    std::filesystem::create_directories(path.parent_path(), error);
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file || !file.write(json.data(), static_cast<std::streamsize>(json.size()))) {
+        ENKAS_LOG_ERROR("Failed to write trace file: {}", path.string());
+        return false;
+    }
+
+    ENKAS_LOG_INFO("Wrote {} trace events to {}", event_count, path.string());
+    return true;
+}
+
+size_t threadBufferCount() {
+    std::scoped_lock lock(registry().mutex());
+    return registry().buffers().size();
+}
+
+void clear() {
+    std::scoped_lock lock(registry().mutex());
+    for (const auto& buffer : registry().buffers()) {
+        for (size_t i = 0; i < kEventsPerThread; ++i) {
+            buffer->slots[i].name.store(nullptr, std::memory_order_relaxed);
+        }
+        buffer->head.store(0, std::memory_order_relaxed);
+        buffer->written_head = 0;
+    }
+}
+
+}  // namespace enkas::tracing
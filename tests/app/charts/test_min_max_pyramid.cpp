@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include "core/charts/min_max_pyramid.h"
+
+namespace {
+struct Point {
+    double x_ = 0.0;
+    double y_ = 0.0;
+
+    double x() const { return x_; }
+    double y() const { return y_; }
+};
+
+// Appends points with random y-values, using the index as x.
+void appendRandom(MinMaxPyramid<Point>& pyramid, size_t count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    for (size_t i = 0; i < count; ++i) {
+        pyramid.append({static_cast<double>(pyramid.size()), uniform(rng)});
+    }
+}
+
+/**
+ * @brief Checks that the sampled points are a subset of the series in order of x, keep the first
+ * and last point, and keep the minimum and maximum of every window of @p span points.
+ */
+void expectPreservesExtremes(const std::vector<Point>& points,
+                             const std::vector<Point>& sampled,
+                             size_t span) {
+    ASSERT_FALSE(sampled.empty());
+    EXPECT_EQ(sampled.front().x(), points.front().x());
+    EXPECT_EQ(sampled.back().x(), points.back().x());
+    for (size_t i = 0; i < sampled.size(); ++i) {
+        const auto index = static_cast<size_t>(sampled[i].x());
+        ASSERT_LT(index, points.size());
+        EXPECT_EQ(sampled[i].y(), points[index].y());
+        if (i > 0) {
+            ASSERT_LT(sampled[i - 1].x(), sampled[i].x());
+        }
+    }
+
+    for (size_t first = 0; first < points.size(); first += span) {
+        const size_t last = std::min(first + span, points.size());
+        const auto [min_point, max_point] = std::ranges::minmax_element(
+            points.begin() + first, points.begin() + last, {}, &Point::y);
+
+        double sampled_min = 2.0;
+        double sampled_max = -2.0;
+        for (const Point& point : sampled) {
+            if (point.x() < first || point.x() >= last) continue;
+            sampled_min = std::min(sampled_min, point.y());
+            sampled_max = std::max(sampled_max, point.y());
+        }
+        EXPECT_EQ(sampled_min, min_point->y()) << "Window at " << first;
+        EXPECT_EQ(sampled_max, max_point->y()) << "Window at " << first;
+    }
+}
+}  // namespace
+
+TEST(MinMaxPyramidTest, ReturnsSmallSeriesUnchanged) {
+    MinMaxPyramid<Point> pyramid;
+    EXPECT_TRUE(pyramid.downsample(10).empty());
+
+    appendRandom(pyramid, 40, 1);
+    const auto sampled = pyramid.downsample(10);
+    ASSERT_EQ(sampled.size(), 40u);
+    for (size_t i = 0; i < sampled.size(); ++i) EXPECT_EQ(sampled[i].x(), static_cast<double>(i));
+}
+
+TEST(MinMaxPyramidTest, PicksFinestLevelThatFitsTheColumns) {
+    MinMaxPyramid<Point> pyramid;
+    appendRandom(pyramid, 1024, 2);
+
+    // Buckets of 8 points: 128 buckets, each with its first and last point and at most two more
+    const auto fine = pyramid.downsample(128);
+    EXPECT_GE(fine.size(), 2u * 128);
+    EXPECT_LE(fine.size(), 4u * 128);
+    expectPreservesExtremes(pyramid.points(), fine, 8);
+
+    // Buckets of 64 points: 16 buckets
+    const auto coarse = pyramid.downsample(16);
+    EXPECT_GE(coarse.size(), 2u * 16);
+    EXPECT_LE(coarse.size(), 4u * 16);
+    expectPreservesExtremes(pyramid.points(), coarse, 64);
+
+    // Zero columns are treated like a single one and use the coarsest level
+    const auto single = pyramid.downsample(0);
+    EXPECT_LE(single.size(), 4u);
+    expectPreservesExtremes(pyramid.points(), single, 1024);
+}
+
+TEST(MinMaxPyramidTest, KeepsExtremesNextToBucketBoundaries) {
+    MinMaxPyramid<Point> pyramid;
+    for (size_t i = 0; i < 256; ++i) pyramid.append({static_cast<double>(i), 0.0});
+
+    // Extremes on both sides of the boundaries between buckets of 16 and 32 points, and at the end
+    // of a single bucket on the coarsest level
+    std::vector<Point> points = pyramid.points();
+    points[15].y_ = 5.0;
+    points[16].y_ = -5.0;
+    points[63].y_ = -7.0;
+    points[64].y_ = 7.0;
+    points[255].y_ = 9.0;
+    pyramid.clear();
+    for (const Point& point : points) pyramid.append(point);
+
+    expectPreservesExtremes(pyramid.points(), pyramid.downsample(16), 16);
+    expectPreservesExtremes(pyramid.points(), pyramid.downsample(8), 32);
+    expectPreservesExtremes(pyramid.points(), pyramid.downsample(1), 256);
+}
+
+TEST(MinMaxPyramidTest, IncludesPointsAppendedAfterDownsampling) {
+    MinMaxPyramid<Point> pyramid;
+    appendRandom(pyramid, 1000, 3);
+    expectPreservesExtremes(pyramid.points(), pyramid.downsample(10), 128);
+
+    // The new points do not fill a bucket of the chosen level, so they come from every finer level
+    appendRandom(pyramid, 36, 4);
+    pyramid.append({static_cast<double>(pyramid.size()), 3.0});
+    pyramid.append({static_cast<double>(pyramid.size()), -3.0});
+    pyramid.append({static_cast<double>(pyramid.size()), 0.5});
+    ASSERT_EQ(pyramid.size(), 1039u);
+
+    const auto sampled = pyramid.downsample(10);
+    expectPreservesExtremes(pyramid.points(), sampled, 128);
+    EXPECT_NE(std::ranges::find(sampled, 3.0, &Point::y), sampled.end());
+    EXPECT_NE(std::ranges::find(sampled, -3.0, &Point::y), sampled.end());
+    EXPECT_LT(sampled.size(), 200u);
+}
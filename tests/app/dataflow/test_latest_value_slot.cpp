@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include "core/dataflow/latest_value_slot.h"
+
+namespace {
+constexpr int kValueCount = 200'000;
+
+// Every field holds the same number, so a value that mixes two writes is easy to spot.
+struct Value {
+    explicit Value(int number) { fields.fill(number); }
+    std::array<int, 16> fields;
+};
+}  // namespace
+
+TEST(LatestValueSlotTest, StartsEmpty) {
+    LatestValueSlot<int> slot;
+    EXPECT_EQ(slot.take(), nullptr);
+}
+
+TEST(LatestValueSlotTest, TakeReturnsLatestValueOnce) {
+    LatestValueSlot<int> slot;
+    slot.set(std::make_shared<int>(1));
+    slot.set(std::make_shared<int>(2));
+    slot.set(std::make_shared<int>(3));
+
+    auto value = slot.take();
+    ASSERT_TRUE(value);
+    EXPECT_EQ(*value, 3);
+    EXPECT_EQ(slot.take(), nullptr);
+
+    slot.set(std::make_shared<int>(4));
+    EXPECT_EQ(*slot.take(), 4);
+}
+
+TEST(LatestValueSlotTest, ReleasesOverwrittenValues) {
+    LatestValueSlot<int> slot;
+    auto first = std::make_shared<int>(1);
+    slot.set(first);
+    slot.set(std::make_shared<int>(2));
+    slot.set(std::make_shared<int>(3));
+
+    // The producer reuses the buffer of a value that was never taken and releases it
+    EXPECT_EQ(first.use_count(), 1);
+}
+
+TEST(LatestValueSlotTest, ConsumerNeverSeesTornOrOlderValues) {
+    LatestValueSlot<Value> slot;
+    std::atomic<bool> done = false;
+
+    std::thread producer([&] {
+        for (int i = 0; i < kValueCount; ++i) slot.set(std::make_shared<Value>(i));
+        done.store(true, std::memory_order_release);
+    });
+
+    int last = -1;
+    int taken = 0;
+    const auto check = [&](const std::shared_ptr<Value>& value) {
+        for (const int field : value->fields) ASSERT_EQ(field, value->fields[0]);
+        ASSERT_GT(value->fields[0], last);
+        last = value->fields[0];
+        ++taken;
+    };
+    while (!done.load(std::memory_order_acquire)) {
+        if (auto value = slot.take()) check(value);
+    }
+    if (auto value = slot.take()) check(value);
+    producer.join();
+
+    EXPECT_GT(taken, 0);
+    EXPECT_EQ(last, kValueCount - 1);
+}
@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "core/dataflow/lock_free_index_stack.h"
+
+namespace {
+constexpr uint32_t kIndexCount = 64;
+constexpr int kThreadCount = 4;
+constexpr int kRoundsPerThread = 50'000;
+}  // namespace
+
+TEST(LockFreeIndexStackTest, PopsInLifoOrder) {
+    LockFreeIndexStack stack(kIndexCount);
+    EXPECT_EQ(stack.pop(), std::nullopt);
+
+    stack.push(3);
+    stack.push(0);
+    stack.push(7);
+    EXPECT_EQ(stack.pop(), 7u);
+    EXPECT_EQ(stack.pop(), 0u);
+
+    stack.push(5);
+    EXPECT_EQ(stack.pop(), 5u);
+    EXPECT_EQ(stack.pop(), 3u);
+    EXPECT_EQ(stack.pop(), std::nullopt);
+}
+
+TEST(LockFreeIndexStackTest, ConcurrentPopAndPushKeepEveryIndexOnce) {
+    LockFreeIndexStack stack(kIndexCount);
+    for (uint32_t i = 0; i < kIndexCount; ++i) stack.push(i);
+
+    // Each thread pops a few indices and pushes them back, which provokes the ABA pattern.
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreadCount; ++t) {
+        threads.emplace_back([&] {
+            for (int round = 0; round < kRoundsPerThread; ++round) {
+                std::vector<uint32_t> held;
+                for (int i = 0; i < 3; ++i) {
+                    if (auto index = stack.pop()) held.push_back(*index);
+                }
+                for (const uint32_t index : held) stack.push(index);
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    std::vector<bool> seen(kIndexCount, false);
+    while (auto index = stack.pop()) {
+        ASSERT_LT(*index, kIndexCount);
+        ASSERT_FALSE(seen[*index]) << "Index " << *index << " was on the stack twice";
+        seen[*index] = true;
+    }
+    for (uint32_t i = 0; i < kIndexCount; ++i) EXPECT_TRUE(seen[i]) << "Index " << i << " was lost";
+}
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <string>
+
+#include "core/dataflow/lru_cache.h"
+
+TEST(LruCacheTest, EvictsLeastRecentlyInsertedEntry) {
+    LruCache<int, std::string> cache(2);
+    cache.put(1, "one");
+    cache.put(2, "two");
+    cache.put(3, "three");
+
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_FALSE(cache.contains(1));
+    EXPECT_EQ(cache.get(2), "two");
+    EXPECT_EQ(cache.get(3), "three");
+}
+
+TEST(LruCacheTest, GetMarksEntryAsRecentlyUsed) {
+    LruCache<int, std::string> cache(2);
+    cache.put(1, "one");
+    cache.put(2, "two");
+    EXPECT_EQ(cache.get(1), "one");
+
+    cache.put(3, "three");
+    EXPECT_TRUE(cache.contains(1));
+    EXPECT_FALSE(cache.contains(2));
+    EXPECT_TRUE(cache.contains(3));
+}
+
+TEST(LruCacheTest, ContainsDoesNotMarkEntryAsUsed) {
+    LruCache<int, std::string> cache(2);
+    cache.put(1, "one");
+    cache.put(2, "two");
+    EXPECT_TRUE(cache.contains(1));
+
+    cache.put(3, "three");
+    EXPECT_FALSE(cache.contains(1));
+    EXPECT_TRUE(cache.contains(2));
+}
+
+TEST(LruCacheTest, PutReplacesValueAndMarksEntryAsUsed) {
+    LruCache<int, std::string> cache(2);
+    cache.put(1, "one");
+    cache.put(2, "two");
+    cache.put(1, "uno");
+    EXPECT_EQ(cache.size(), 2u);
+
+    cache.put(3, "three");
+    EXPECT_EQ(cache.get(1), "uno");
+    EXPECT_FALSE(cache.contains(2));
+}
+
+TEST(LruCacheTest, ZeroCapacityDisablesCaching) {
+    LruCache<int, std::string> cache(0);
+    cache.put(1, "one");
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_EQ(cache.get(1), std::nullopt);
+}
+
+TEST(LruCacheTest, ClearRemovesAllEntries) {
+    LruCache<int, std::string> cache(2);
+    cache.put(1, "one");
+    cache.put(2, "two");
+    cache.clear();
+
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_FALSE(cache.contains(1));
+    cache.put(3, "three");
+    EXPECT_EQ(cache.get(3), "three");
+}
@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "core/dataflow/memory_pool.h"
+
+namespace {
+constexpr size_t kBufferBytes = 1024;
+
+constexpr int kThreadCount = 4;
+constexpr int kAcquiresPerThread = 20'000;
+
+// Releases are checked every 64 acquires, so this many acquires cover at least two checks.
+constexpr int kAcquiresPerReleaseCheck = 64;
+
+struct Buffer {
+    void reset() { ++reset_count; }
+    int reset_count = 0;
+    std::atomic<int> users = 0;  // Threads holding the buffer, which must never exceed one
+};
+
+using BufferPool = MemoryPool<Buffer>;
+}  // namespace
+
+TEST(MemoryPoolTest, RejectsZeroBuffers) {
+    EXPECT_THROW(BufferPool(MemoryPoolLimits{.max_buffers = 0}), std::invalid_argument);
+}
+
+TEST(MemoryPoolTest, CapacityFollowsByteBudget) {
+    const BufferPool pool(MemoryPoolLimits{
+        .max_buffers = 10, .byte_budget = 3 * kBufferBytes, .buffer_bytes = kBufferBytes});
+    EXPECT_EQ(pool.capacity(), 3u);
+    EXPECT_EQ(pool.capacityBytes(), 3 * kBufferBytes);
+
+    const BufferPool capped(MemoryPoolLimits{
+        .max_buffers = 2, .byte_budget = 3 * kBufferBytes, .buffer_bytes = kBufferBytes});
+    EXPECT_EQ(capped.capacity(), 2u);
+
+    const BufferPool minimum(MemoryPoolLimits{.max_buffers = 10,
+                                              .byte_budget = kBufferBytes / 2,
+                                              .buffer_bytes = kBufferBytes,
+                                              .min_buffers = 2});
+    EXPECT_EQ(minimum.capacity(), 2u);
+}
+
+TEST(MemoryPoolTest, AllocatesLazilyAndReusesBuffers) {
+    BufferPool pool(MemoryPoolLimits{.max_buffers = 4, .buffer_bytes = kBufferBytes});
+    EXPECT_EQ(pool.allocatedBytes(), 0u);
+    EXPECT_EQ(pool.size(), 4u);
+
+    Buffer* first = nullptr;
+    {
+        auto buffer = pool.acquire();
+        first = buffer.get();
+        EXPECT_EQ(pool.allocatedBytes(), kBufferBytes);
+        EXPECT_EQ(pool.size(), 3u);
+    }
+    EXPECT_EQ(pool.size(), 4u);
+
+    auto buffer = pool.acquire();
+    EXPECT_EQ(buffer.get(), first);
+    EXPECT_EQ(buffer->reset_count, 1);
+    EXPECT_EQ(pool.allocatedBytes(), kBufferBytes);
+}
+
+TEST(MemoryPoolTest, BlocksAtByteBudgetUntilBufferReturns) {
+    BufferPool pool(MemoryPoolLimits{
+        .max_buffers = 10, .byte_budget = 2 * kBufferBytes, .buffer_bytes = kBufferBytes});
+    auto first = pool.acquire();
+    auto second = pool.acquire();
+    EXPECT_EQ(pool.size(), 0u);
+    EXPECT_EQ(pool.allocatedBytes(), pool.capacityBytes());
+
+    std::atomic<bool> acquired = false;
+    std::thread waiter([&] {
+        auto third = pool.acquire();
+        acquired.store(true);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(acquired.load());
+
+    first.reset();
+    waiter.join();
+    EXPECT_TRUE(acquired.load());
+    EXPECT_EQ(pool.allocatedBytes(), 2 * kBufferBytes);
+    EXPECT_EQ(pool.highWatermark(), 2u);
+}
+
+TEST(MemoryPoolTest, ReleasesIdleBuffersAfterDemandDrops) {
+    BufferPool pool(MemoryPoolLimits{.max_buffers = 8,
+                                     .buffer_bytes = kBufferBytes,
+                                     .release_interval = std::chrono::nanoseconds(0)});
+    {
+        std::vector<std::shared_ptr<Buffer>> burst;
+        for (int i = 0; i < 4; ++i) burst.push_back(pool.acquire());
+    }
+    EXPECT_EQ(pool.allocatedBytes(), 4 * kBufferBytes);
+
+    // The first check still sees the burst; the next one releases everything above one buffer.
+    for (int i = 0; i < 2 * kAcquiresPerReleaseCheck; ++i) auto buffer = pool.acquire();
+    EXPECT_EQ(pool.allocatedBytes(), kBufferBytes);
+    EXPECT_EQ(pool.highWatermark(), 4u);
+    EXPECT_EQ(pool.size(), pool.capacity());
+}
+
+TEST(MemoryPoolTest, KeepsBuffersWhileDemandStaysHigh) {
+    BufferPool pool(MemoryPoolLimits{.max_buffers = 8,
+                                     .buffer_bytes = kBufferBytes,
+                                     .release_interval = std::chrono::nanoseconds(0)});
+    for (int i = 0; i < 4 * kAcquiresPerReleaseCheck; ++i) {
+        auto first = pool.acquire();
+        auto second = pool.acquire();
+        auto third = pool.acquire();
+    }
+    EXPECT_EQ(pool.allocatedBytes(), 3 * kBufferBytes);
+}
+
+TEST(MemoryPoolTest, ConcurrentAcquiresStayWithinBudget) {
+    BufferPool pool(MemoryPoolLimits{.max_buffers = 10,
+                                     .byte_budget = 3 * kBufferBytes,
+                                     .buffer_bytes = kBufferBytes,
+                                     .release_interval = std::chrono::nanoseconds(0)});
+
+    std::atomic<bool> exceeded_budget = false;
+    std::atomic<bool> shared_buffer = false;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreadCount; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < kAcquiresPerThread; ++i) {
+                auto buffer = pool.acquire();
+                if (buffer->users.fetch_add(1) != 0) shared_buffer = true;
+                if (pool.allocatedBytes() > pool.capacityBytes()) exceeded_budget = true;
+                buffer->users.fetch_sub(1);
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    EXPECT_FALSE(shared_buffer);
+    EXPECT_FALSE(exceeded_budget);
+    EXPECT_LE(pool.highWatermark(), pool.capacity());
+    EXPECT_LE(pool.allocatedBytes(), pool.capacityBytes());
+    EXPECT_EQ(pool.size(), pool.capacity());
+}
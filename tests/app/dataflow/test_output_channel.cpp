@@ -0,0 +1,95 @@
+#include <enkas/data/system.h>
+#include <enkas/math/vector3d.h>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+
+#include "core/dataflow/memory_pool.h"
+#include "core/dataflow/output_channel.h"
+#include "core/dataflow/snapshot.h"
+
+namespace {
+// A pool for systems of a million particles within a 1 GiB budget, as the simulation uses it. The
+// buffers themselves hold a few particles, only the budget is computed for the large system.
+constexpr size_t kLargeParticleCount = 1'000'000;
+constexpr size_t kBufferParticles = 4;
+constexpr size_t kPoolByteBudget = size_t{1} << 30;
+constexpr size_t kReservedBuffers = 6;
+constexpr int kSnapshotCount = 200;
+
+using SystemPool = MemoryPool<enkas::data::System, size_t>;
+
+SystemPool makeLargeSystemPool() {
+    const size_t particle_bytes = 2 * sizeof(enkas::math::Vector3D) + sizeof(double);
+    return SystemPool(MemoryPoolLimits{.max_buffers = 512,
+                                       .byte_budget = kPoolByteBudget,
+                                       .buffer_bytes = kLargeParticleCount * particle_bytes,
+                                       .min_buffers = 8},
+                      kBufferParticles);
+}
+
+class OutputChannelTest : public testing::Test {
+protected:
+    void SetUp() override {
+        dir_ = std::filesystem::temp_directory_path() /
+               testing::UnitTest::GetInstance()->current_test_info()->name();
+        std::filesystem::remove_all(dir_);
+    }
+
+    void TearDown() override { std::filesystem::remove_all(dir_); }
+
+    OutputChannelConfig spillConfig() const {
+        return {.capacity = 512,
+                .policy = BackpressurePolicy::Spill,
+                .spill_path = dir_ / "system.spill"};
+    }
+
+    std::filesystem::path dir_;
+};
+}  // namespace
+
+TEST_F(OutputChannelTest, SpillsOnceQueueIsFull) {
+    SystemOutputChannel channel({.capacity = 4,
+                                 .policy = BackpressurePolicy::Spill,
+                                 .spill_path = dir_ / "system.spill"});
+    for (int i = 0; i < 10; ++i) {
+        channel.push(std::make_shared<SystemSnapshot>(enkas::data::System(2), i));
+    }
+    EXPECT_EQ(channel.spilled(), 6u);
+    EXPECT_EQ(channel.size(), 10u);
+
+    for (int i = 0; i < 10; ++i) {
+        const auto snapshot = channel.popBlocking();
+        ASSERT_TRUE(snapshot);
+        EXPECT_DOUBLE_EQ(snapshot->time, i);
+    }
+}
+
+TEST_F(OutputChannelTest, SpillsBeforeLargeSystemPoolRunsOut) {
+    SystemPool pool = makeLargeSystemPool();
+    ASSERT_LT(pool.capacity(), 32u);
+
+    SystemOutputChannel channel(spillConfig());
+    channel.setSpillThreshold(pool.capacity() - kReservedBuffers);
+
+    // The consumer is stalled, so without spilling the pool would run out long before the queue
+    // fills up, and acquire() would block the producer.
+    for (int i = 0; i < kSnapshotCount; ++i) {
+        ASSERT_GT(pool.size(), 0u) << "acquire() would block at snapshot " << i;
+        auto system = pool.acquire();
+        system->masses[0] = i;
+        channel.push(std::make_shared<SystemSnapshot>(std::move(system), i));
+    }
+    EXPECT_LE(pool.highWatermark(), pool.capacity() - kReservedBuffers + 1);
+    EXPECT_GT(channel.spilled(), 0u);
+
+    // Spilled snapshots are lossless and keep their order
+    for (int i = 0; i < kSnapshotCount; ++i) {
+        const auto snapshot = channel.popBlocking();
+        ASSERT_TRUE(snapshot);
+        EXPECT_DOUBLE_EQ(snapshot->time, i);
+        EXPECT_DOUBLE_EQ(snapshot->data->masses[0], i);
+    }
+}
@@ -0,0 +1,87 @@
+#include <enkas/data/system.h>
+#include <gtest/gtest.h>
+
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "core/dataflow/snapshot.h"
+
+namespace {
+// The stream formatting that formatCsvField replaced.
+std::string formatWithStream(double value) {
+    std::ostringstream stream;
+    stream << std::setprecision(17) << value << ',';
+    return stream.str();
+}
+
+std::string formatWithToChars(double value) {
+    std::array<char, kMaxCsvRowLength> buffer{};
+    char* end = formatCsvField(buffer.data(), value, ',');
+    return {buffer.data(), end};
+}
+
+void expectSameAsStream(const std::vector<double>& values) {
+    for (const double value : values) {
+        EXPECT_EQ(formatWithToChars(value), formatWithStream(value))
+            << "Bits of the value: " << std::bit_cast<uint64_t>(value);
+    }
+}
+}  // namespace
+
+TEST(SnapshotCsvTest, MatchesStreamForZerosAndIntegers) {
+    expectSameAsStream({0.0, -0.0, 1.0, -1.0, 2.0, 10.0, 100.0, 1e6, 123456789.0, -987654321.0,
+                        1e15, 1e16, 1e17, 9007199254740992.0, 123456789012345678.0});
+}
+
+TEST(SnapshotCsvTest, MatchesStreamForExtremeMagnitudes) {
+    constexpr double kMax = std::numeric_limits<double>::max();
+    constexpr double kMin = std::numeric_limits<double>::min();
+    constexpr double kDenormMin = std::numeric_limits<double>::denorm_min();
+    expectSameAsStream({1e308, -1e308, 1e-308, -1e-308, kMax, -kMax, kMin, -kMin, kDenormMin,
+                        -kDenormMin, 4.9e-324, 2.225e-308, kMin / 3.0, kMin - kDenormMin,
+                        std::numeric_limits<double>::infinity(),
+                        -std::numeric_limits<double>::infinity()});
+}
+
+TEST(SnapshotCsvTest, MatchesStreamWhenRoundingAtTheLastDigit) {
+    // Values whose shortest representation is shorter than 17 digits, so the 17th digit is
+    // rounded, and values that need all 17 digits
+    expectSameAsStream({0.1, 0.2, 0.3, 1.0 / 3.0, 2.0 / 3.0, 0.1 + 0.2, 1e-5, 1e-4, 1.5e-5,
+                        0.000123456789, 99999999999999999.0, 0.99999999999999989,
+                        1.0000000000000002, 5e-324 * 3, std::nextafter(1.0, 0.0),
+                        std::nextafter(1e-4, 1.0), std::nextafter(1e17, 0.0), 9.5, 0.5, 2.5e-5});
+}
+
+TEST(SnapshotCsvTest, MatchesStreamForRandomValues) {
+    std::mt19937_64 rng(7);
+    std::uniform_real_distribution<double> mantissa(-1.0, 1.0);
+    std::uniform_int_distribution<int> exponent(-1074, 1023);
+
+    std::vector<double> values;
+    for (int i = 0; i < 20'000; ++i) values.push_back(std::ldexp(mantissa(rng), exponent(rng)));
+    expectSameAsStream(values);
+}
+
+TEST(SnapshotCsvTest, FormatsRowsLikeStream) {
+    enkas::data::System system(1);
+    system.positions[0] = {0.1, -0.0, 1e-308};
+    system.velocities[0] = {4.9e-324, 1e308, -2.5};
+    system.masses[0] = 3.0;
+    const SystemSnapshot snapshot(std::move(system), 1.0 / 3.0);
+
+    std::ostringstream expected;
+    expected << std::setprecision(17) << 1.0 / 3.0 << ',' << 0.1 << ',' << -0.0 << ',' << 1e-308
+             << ',' << 4.9e-324 << ',' << 1e308 << ',' << -2.5 << ',' << 3.0 << '\n';
+
+    std::array<char, kMaxCsvRowLength> buffer{};
+    char* end = formatCsvRow(buffer.data(), snapshot, 0);
+    EXPECT_EQ(std::string(buffer.data(), end), expected.str());
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <thread>
+
+#include "core/dataflow/spsc_queue.h"
+
+namespace {
+using IntQueue = SpscQueue<std::shared_ptr<int>>;
+
+constexpr int kItemCount = 100'000;
+}  // namespace
+
+TEST(SpscQueueTest, RoundsCapacityUpToPowerOfTwo) {
+    EXPECT_EQ(IntQueue(0).capacity(), 1u);
+    EXPECT_EQ(IntQueue(5).capacity(), 8u);
+    EXPECT_EQ(IntQueue(8).capacity(), 8u);
+}
+
+TEST(SpscQueueTest, PreservesFifoOrderAcrossThreads) {
+    IntQueue queue(8);
+
+    std::thread consumer([&] {
+        for (int i = 0; i < kItemCount; ++i) {
+            auto item = queue.popBlocking();
+            ASSERT_TRUE(item);
+            ASSERT_EQ(*item, i);
+        }
+    });
+    for (int i = 0; i < kItemCount; ++i) ASSERT_TRUE(queue.pushBlocking(std::make_shared<int>(i)));
+    consumer.join();
+
+    EXPECT_EQ(queue.size(), 0u);
+    EXPECT_FALSE(queue.tryPop());
+}
+
+TEST(SpscQueueTest, DropOldestRacingConsumerHandsOutEveryItemOnce) {
+    IntQueue queue(4);
+
+    // The producer drops the oldest item whenever the queue is full, so it never waits and keeps
+    // racing the consumer for the head.
+    size_t dropped = 0;
+    std::thread producer([&] {
+        for (int i = 0; i < kItemCount; ++i) {
+            if (queue.isFull() && queue.dropOldest()) ++dropped;
+            ASSERT_TRUE(queue.pushBlocking(std::make_shared<int>(i)));
+        }
+        queue.close();
+    });
+
+    size_t received = 0;
+    int last = -1;
+    while (auto item = queue.popBlocking()) {
+        ASSERT_GT(*item, last);
+        last = *item;
+        ++received;
+    }
+    producer.join();
+
+    EXPECT_GT(dropped, 0u);
+    EXPECT_EQ(received + dropped, static_cast<size_t>(kItemCount));
+    EXPECT_EQ(last, kItemCount - 1);
+}
+
+TEST(SpscQueueTest, DropOldestReturnsFalseWhenEmpty) {
+    IntQueue queue(2);
+    EXPECT_FALSE(queue.dropOldest());
+
+    queue.pushBlocking(std::make_shared<int>(1));
+    queue.pushBlocking(std::make_shared<int>(2));
+    EXPECT_TRUE(queue.dropOldest());
+    EXPECT_EQ(*queue.popBlocking(), 2);
+    EXPECT_FALSE(queue.dropOldest());
+}
+
+TEST(SpscQueueTest, CloseKeepsQueuedItemsPoppable) {
+    IntQueue queue(4);
+    queue.pushBlocking(std::make_shared<int>(1));
+    queue.pushBlocking(std::make_shared<int>(2));
+    queue.pushBlocking(std::make_shared<int>(3));
+
+    queue.close();
+    EXPECT_TRUE(queue.isClosed());
+    EXPECT_FALSE(queue.pushBlocking(std::make_shared<int>(4)));
+    EXPECT_EQ(queue.size(), 3u);
+
+    EXPECT_EQ(*queue.popBlocking(), 1);
+    EXPECT_EQ(**queue.tryPop(), 2);
+    EXPECT_EQ(*queue.popBlocking(), 3);
+    EXPECT_EQ(queue.popBlocking(), nullptr);
+    EXPECT_FALSE(queue.tryPop());
+}
+
+TEST(SpscQueueTest, CloseWakesBlockedConsumer) {
+    IntQueue queue(2);
+    std::thread consumer([&] { EXPECT_EQ(queue.popBlocking(), nullptr); });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    queue.close();
+    consumer.join();
+}
+
+TEST(SpscQueueTest, CloseWakesBlockedProducer) {
+    IntQueue queue(1);
+    queue.pushBlocking(std::make_shared<int>(1));
+    std::thread producer([&] { EXPECT_FALSE(queue.pushBlocking(std::make_shared<int>(2))); });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    queue.close();
+    producer.join();
+
+    EXPECT_EQ(*queue.popBlocking(), 1);
+    EXPECT_EQ(queue.popBlocking(), nullptr);
+}
@@ -0,0 +1,146 @@
+#include <enkas/data/system.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+#include "core/files/initial_system_cache.h"
+
+namespace {
+constexpr size_t kParticleCount = 100;
+
+enkas::data::System makeSystem(double offset) {
+    enkas::data::System system(kParticleCount);
+    for (size_t i = 0; i < kParticleCount; ++i) {
+        system.positions[i] = {offset + i, offset - i, offset * i};
+        system.velocities[i] = {-offset, offset + 0.5 * i, 2.0 * i};
+        system.masses[i] = offset + 1.0;
+    }
+    return system;
+}
+
+InitialSystemCache::Key makeKey(uint64_t hash, uint8_t settings) {
+    return {.hash = hash, .settings = {std::byte{1}, std::byte{settings}, std::byte{3}}};
+}
+
+class InitialSystemCacheTest : public testing::Test {
+protected:
+    void SetUp() override {
+        dir_ = std::filesystem::temp_directory_path() /
+               testing::UnitTest::GetInstance()->current_test_info()->name();
+        std::filesystem::remove_all(dir_);
+    }
+
+    void TearDown() override { std::filesystem::remove_all(dir_); }
+
+    // Moves the last use of the entry of a key @p age into the past.
+    void setAge(const InitialSystemCache& cache,
+                const InitialSystemCache::Key& key,
+                std::chrono::minutes age) const {
+        const auto entry = cache.find(key);
+        ASSERT_TRUE(entry);
+        std::filesystem::last_write_time(entry->path,
+                                         std::filesystem::file_time_type::clock::now() - age);
+    }
+
+    std::filesystem::path dir_;
+};
+}  // namespace
+
+TEST_F(InitialSystemCacheTest, StoresAndReadsSystem) {
+    const InitialSystemCache cache(dir_);
+    const auto key = makeKey(42, 2);
+    EXPECT_FALSE(cache.find(key));
+
+    const auto system = makeSystem(1.5);
+    ASSERT_TRUE(cache.store(key, system, -12.5, 1e-4));
+
+    const auto entry = cache.find(key);
+    ASSERT_TRUE(entry);
+    EXPECT_EQ(entry->particle_count, kParticleCount);
+    EXPECT_DOUBLE_EQ(entry->potential_energy, -12.5);
+    EXPECT_DOUBLE_EQ(entry->softening_sqr, 1e-4);
+
+    enkas::data::System loaded;
+    ASSERT_TRUE(cache.read(*entry, loaded));
+    ASSERT_EQ(loaded.count(), kParticleCount);
+    for (size_t i = 0; i < kParticleCount; ++i) {
+        EXPECT_EQ(loaded.positions[i], system.positions[i]);
+        EXPECT_EQ(loaded.velocities[i], system.velocities[i]);
+        EXPECT_EQ(loaded.masses[i], system.masses[i]);
+    }
+}
+
+TEST_F(InitialSystemCacheTest, IgnoresEntriesOfOtherSettings) {
+    const InitialSystemCache cache(dir_);
+    ASSERT_TRUE(cache.store(makeKey(42, 2), makeSystem(1.0), 0.0, 0.0));
+
+    // A different hash, and the same hash for different settings, as after a collision
+    EXPECT_FALSE(cache.find(makeKey(43, 2)));
+    EXPECT_FALSE(cache.find(makeKey(42, 5)));
+    EXPECT_FALSE(cache.find({.hash = 42, .settings = {std::byte{1}}}));
+    EXPECT_TRUE(cache.find(makeKey(42, 2)));
+}
+
+TEST_F(InitialSystemCacheTest, IgnoresTruncatedEntries) {
+    const InitialSystemCache cache(dir_);
+    const auto key = makeKey(42, 2);
+    ASSERT_TRUE(cache.store(key, makeSystem(1.0), 0.0, 0.0));
+    const auto entry = cache.find(key);
+    ASSERT_TRUE(entry);
+
+    std::filesystem::resize_file(entry->path, std::filesystem::file_size(entry->path) - 8);
+    EXPECT_FALSE(cache.find(key));
+
+    // An entry that was found before it was truncated fails to read
+    enkas::data::System loaded;
+    EXPECT_FALSE(cache.read(*entry, loaded));
+    std::filesystem::resize_file(entry->path, 4);
+    EXPECT_FALSE(cache.find(key));
+    EXPECT_FALSE(cache.read(*entry, loaded));
+}
+
+TEST_F(InitialSystemCacheTest, ReadFailsWhenEntryIsGone) {
+    const InitialSystemCache cache(dir_);
+    const auto key = makeKey(42, 2);
+    ASSERT_TRUE(cache.store(key, makeSystem(1.0), 0.0, 0.0));
+    const auto entry = cache.find(key);
+    ASSERT_TRUE(entry);
+
+    std::filesystem::remove(entry->path);
+    enkas::data::System loaded;
+    EXPECT_FALSE(cache.read(*entry, loaded));
+    EXPECT_EQ(loaded.count(), 0u);  // Gave up before resizing the system
+}
+
+TEST_F(InitialSystemCacheTest, EvictsLeastRecentlyUsedEntries) {
+    const auto first = makeKey(1, 1);
+    const auto second = makeKey(2, 2);
+    const auto third = makeKey(3, 3);
+
+    // Room for two entries
+    std::uintmax_t entry_bytes = 0;
+    {
+        const InitialSystemCache probe(dir_);
+        ASSERT_TRUE(probe.store(first, makeSystem(1.0), 0.0, 0.0));
+        entry_bytes = std::filesystem::file_size(probe.find(first)->path);
+    }
+    const InitialSystemCache cache(dir_, 2 * entry_bytes + entry_bytes / 2);
+    EXPECT_FALSE(cache.store(makeKey(4, 4), enkas::data::System(kParticleCount * 3), 0.0, 0.0));
+
+    ASSERT_TRUE(cache.store(second, makeSystem(2.0), 0.0, 0.0));
+    setAge(cache, first, std::chrono::minutes(20));
+    setAge(cache, second, std::chrono::minutes(10));
+
+    // Reading the first entry makes it the most recently used one
+    enkas::data::System loaded;
+    ASSERT_TRUE(cache.read(*cache.find(first), loaded));
+    ASSERT_TRUE(cache.store(third, makeSystem(3.0), 0.0, 0.0));
+
+    EXPECT_TRUE(cache.find(first));
+    EXPECT_FALSE(cache.find(second));
+    EXPECT_TRUE(cache.find(third));
+}
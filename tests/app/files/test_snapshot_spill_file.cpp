@@ -0,0 +1,138 @@
+#include <enkas/data/system.h>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+
+#include "core/dataflow/snapshot.h"
+#include "core/files/snapshot_spill_file.h"
+
+#ifdef __linux__
+#include <sys/resource.h>
+
+#include <csignal>
+#endif
+
+namespace {
+constexpr size_t kParticleCount = 1000;
+constexpr std::streamoff kCountOffset = sizeof(double);  // After the snapshot time
+
+SystemSnapshot makeSnapshot(double time) {
+    enkas::data::System system(kParticleCount);
+    for (size_t i = 0; i < kParticleCount; ++i) {
+        system.positions[i] = {time + i, time - i, time * i};
+        system.velocities[i] = {-time, 0.5 * i, 2.0 * i};
+        system.masses[i] = time + 1.0;
+    }
+    return SystemSnapshot(std::move(system), time);
+}
+
+void expectSnapshot(const std::shared_ptr<const Snapshot<enkas::data::System>>& snapshot,
+                    double time) {
+    ASSERT_TRUE(snapshot);
+    EXPECT_DOUBLE_EQ(snapshot->time, time);
+    ASSERT_EQ(snapshot->data->count(), kParticleCount);
+    EXPECT_EQ(snapshot->data->positions.back(), makeSnapshot(time).data->positions.back());
+    EXPECT_DOUBLE_EQ(snapshot->data->masses.front(), time + 1.0);
+}
+
+#ifdef __linux__
+/**
+ * @brief Lowers the file size limit of the process while in scope, so that writes past it fail
+ * like writes to a full disk.
+ */
+class FileSizeLimit {
+public:
+    explicit FileSizeLimit(rlim_t bytes) {
+        previous_handler_ = std::signal(SIGXFSZ, SIG_IGN);
+        getrlimit(RLIMIT_FSIZE, &previous_limit_);
+        rlimit limit = previous_limit_;
+        limit.rlim_cur = bytes;
+        setrlimit(RLIMIT_FSIZE, &limit);
+    }
+
+    ~FileSizeLimit() {
+        setrlimit(RLIMIT_FSIZE, &previous_limit_);
+        std::signal(SIGXFSZ, previous_handler_);
+    }
+
+    FileSizeLimit(const FileSizeLimit&) = delete;
+    FileSizeLimit& operator=(const FileSizeLimit&) = delete;
+
+private:
+    rlimit previous_limit_{};
+    void (*previous_handler_)(int) = nullptr;
+};
+#endif
+
+class SnapshotSpillFileTest : public testing::Test {
+protected:
+    void SetUp() override {
+        dir_ = std::filesystem::temp_directory_path() /
+               testing::UnitTest::GetInstance()->current_test_info()->name();
+        std::filesystem::remove_all(dir_);
+    }
+
+    void TearDown() override { std::filesystem::remove_all(dir_); }
+
+    std::filesystem::path spillPath() const { return dir_ / "system.spill"; }
+
+    std::filesystem::path dir_;
+};
+}  // namespace
+
+TEST_F(SnapshotSpillFileTest, ReadsRecordsInOrder) {
+    SnapshotSpillFile<enkas::data::System> file(spillPath());
+    ASSERT_TRUE(file.isOpen());
+    ASSERT_TRUE(file.write(makeSnapshot(1.0)));
+    ASSERT_TRUE(file.write(makeSnapshot(2.0)));
+    EXPECT_EQ(file.pending(), 2u);
+
+    expectSnapshot(file.read(), 1.0);
+    file.markRead();
+    expectSnapshot(file.read(), 2.0);
+    file.markRead();
+    EXPECT_EQ(file.pending(), 0u);
+    EXPECT_EQ(std::filesystem::file_size(spillPath()), 0u);
+}
+
+TEST_F(SnapshotSpillFileTest, DiscardsPartiallyWrittenRecord) {
+#ifdef __linux__
+    SnapshotSpillFile<enkas::data::System> file(spillPath());
+    ASSERT_TRUE(file.write(makeSnapshot(1.0)));
+    const auto record_bytes = std::filesystem::file_size(spillPath());
+
+    // The second record only fits halfway
+    {
+        const FileSizeLimit limit(record_bytes + record_bytes / 2);
+        EXPECT_FALSE(file.write(makeSnapshot(2.0)));
+    }
+    EXPECT_EQ(file.pending(), 1u);
+    EXPECT_EQ(std::filesystem::file_size(spillPath()), record_bytes);
+
+    ASSERT_TRUE(file.write(makeSnapshot(3.0)));
+    expectSnapshot(file.read(), 1.0);
+    file.markRead();
+    expectSnapshot(file.read(), 3.0);
+    file.markRead();
+#else
+    GTEST_SKIP() << "Needs a file size limit to make writes fail";
+#endif
+}
+
+TEST_F(SnapshotSpillFileTest, RejectsParticleCountBeyondFileSize) {
+    SnapshotSpillFile<enkas::data::System> file(spillPath());
+    ASSERT_TRUE(file.write(makeSnapshot(1.0)));
+    {
+        std::fstream raw(spillPath(), std::ios::in | std::ios::out | std::ios::binary);
+        raw.seekp(kCountOffset);
+        const uint64_t count = uint64_t{1} << 50;
+        raw.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    }
+
+    // Fails instead of allocating a system for the stored count
+    EXPECT_EQ(file.read(), nullptr);
+}
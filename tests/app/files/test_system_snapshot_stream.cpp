@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+
+#include "core/files/file_constants.h"
+#include "core/files/system_snapshot_stream.h"
+
+namespace {
+constexpr std::streamoff kEntryCountOffset = 24;  // After the magic, source size and mtime
+
+class SystemSnapshotStreamTest : public testing::Test {
+protected:
+    void SetUp() override {
+        dir_ = std::filesystem::temp_directory_path() /
+               testing::UnitTest::GetInstance()->current_test_info()->name();
+        std::filesystem::remove_all(dir_);
+        std::filesystem::create_directories(dir_);
+
+        // Five snapshots of three particles each
+        std::ofstream file(csvPath());
+        file << "time,pos_x,pos_y,pos_z,vel_x,vel_y,vel_z,mass\n";
+        for (int t = 0; t < 5; ++t) {
+            for (int i = 0; i < 3; ++i) file << t * 0.5 << ",1,2,3,4,5,6," << i + 1 << "\n";
+        }
+    }
+
+    void TearDown() override { std::filesystem::remove_all(dir_); }
+
+    std::filesystem::path csvPath() const { return dir_ / "system.csv"; }
+
+    std::filesystem::path indexPath() const {
+        auto path = csvPath();
+        path += file_names::index_suffix;
+        return path;
+    }
+
+    // Builds and persists the index by opening the stream once.
+    void persistIndex() const {
+        SystemSnapshotStream stream(csvPath());
+        ASSERT_TRUE(stream.initialize());
+        ASSERT_TRUE(std::filesystem::exists(indexPath()));
+    }
+
+    void expectFullIndex() const {
+        SystemSnapshotStream stream(csvPath());
+        ASSERT_TRUE(stream.initialize());
+        EXPECT_EQ(stream.getSnapshotCount(), 5u);
+
+        auto snapshot = stream.getSnapshotAtFraction(1.0);
+        ASSERT_TRUE(snapshot);
+        EXPECT_DOUBLE_EQ(snapshot->time, 2.0);
+        ASSERT_EQ(snapshot->data->count(), 3u);
+        EXPECT_DOUBLE_EQ(snapshot->data->masses[2], 3.0);
+    }
+
+    std::filesystem::path dir_;
+};
+}  // namespace
+
+TEST_F(SystemSnapshotStreamTest, ReusesPersistedIndex) {
+    persistIndex();
+    expectFullIndex();
+}
+
+TEST_F(SystemSnapshotStreamTest, RescansWhenEntryCountIsCorrupt) {
+    persistIndex();
+    {
+        std::fstream index(indexPath(), std::ios::in | std::ios::out | std::ios::binary);
+        index.seekp(kEntryCountOffset);
+        const std::uint64_t entry_count = std::uint64_t{1} << 60;
+        index.write(reinterpret_cast<const char*>(&entry_count), sizeof(entry_count));
+    }
+
+    expectFullIndex();
+}
+
+TEST_F(SystemSnapshotStreamTest, RescansWhenIndexIsTruncated) {
+    persistIndex();
+    std::filesystem::resize_file(indexPath(), std::filesystem::file_size(indexPath()) - 4);
+
+    expectFullIndex();
+}
@@ -15,9 +15,8 @@ public:
                 parseInitialSystem,
                 (const std::filesystem::path&),
                 (override));
-    MOCK_METHOD(std::optional<int>, countSnapshots, (const std::filesystem::path&), (override));
-    MOCK_METHOD(std::optional<double>,
-                retrieveSimulationDuration,
+    MOCK_METHOD(std::optional<SystemFileMetadata>,
+                parseSystemMetadata,
                 (const std::filesystem::path&),
                 (override));
 };
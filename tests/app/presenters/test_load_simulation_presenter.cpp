@@ -61,9 +61,9 @@ TEST_F(LoadSimulationPresenterTest, CheckFiles_HandlesAllFileTypes) {
     DiagnosticsSeries fake_diagnostics_series(1);
 
     EXPECT_CALL(mock_parser_, parseSettings(_)).WillOnce(Return(fake_settings));
-    EXPECT_CALL(mock_parser_, parseInitialSystem(_)).WillOnce(Return(fake_system));
-    EXPECT_CALL(mock_parser_, countSnapshots(_)).WillOnce(Return(100));
-    EXPECT_CALL(mock_parser_, retrieveSimulationDuration(_)).WillOnce(Return(50.0));
+    SystemFileMetadata fake_metadata{fake_system, 100, 50.0};
+
+    EXPECT_CALL(mock_parser_, parseSystemMetadata(_)).WillOnce(Return(fake_metadata));
     EXPECT_CALL(mock_parser_, parseDiagnosticsSeries(_)).WillOnce(Return(fake_diagnostics_series));
 
     // ASSERT: View receives parsed data from all file types
@@ -76,6 +76,50 @@ TEST_F(LoadSimulationPresenterTest, CheckFiles_HandlesAllFileTypes) {
     QCoreApplication::processEvents();
 }
 
+TEST_F(LoadSimulationPresenterTest, CheckFiles_ScansSystemFileOnceAndForwardsMetadata) {
+    // ARRANGE: View provides path to system file
+    const QString system_path = "path/to/system.csv";
+    EXPECT_CALL(mock_view_, getFilesToCheck()).WillOnce(Return(QVector<QString>{system_path}));
+
+    // ARRANGE: Parser returns metadata from a single pass
+    enkas::data::System fake_system(2);
+    SystemFileMetadata fake_metadata{fake_system, 42, 12.5};
+    EXPECT_CALL(mock_parser_, parseSystemMetadata(_)).Times(1).WillOnce(Return(fake_metadata));
+    EXPECT_CALL(mock_parser_, parseInitialSystem(_)).Times(0);
+
+    // ARRANGE: Player factory creates mock player
+    auto mock_player_ptr = std::make_unique<NiceMock<MockSimulationPlayer>>();
+    auto* raw_mock_player = mock_player_ptr.get();
+    EXPECT_CALL(mock_factory_, create()).WillOnce(Return(ByMove(std::move(mock_player_ptr))));
+
+    // ASSERT: View shows the initial system and the player receives count, duration and size
+    EXPECT_CALL(mock_view_, onInitialSystemParsed(Optional(fake_system)));
+    EXPECT_CALL(*raw_mock_player,
+                run(Optional(AllOf(Field(&ISimulationPlayer::SystemData::total_snapshots_count, 42u),
+                                   Field(&ISimulationPlayer::SystemData::simulation_duration, 12.5),
+                                   Field(&ISimulationPlayer::SystemData::particle_count, 2u))),
+                    _));
+
+    // ACT
+    presenter_->checkFiles();
+    QCoreApplication::processEvents();
+    presenter_->playSimulation();
+}
+
+TEST_F(LoadSimulationPresenterTest, CheckFiles_ReportsCorruptSystemFile) {
+    // ARRANGE: View provides path to system file that fails to parse
+    const QString system_path = "path/to/system.csv";
+    EXPECT_CALL(mock_view_, getFilesToCheck()).WillOnce(Return(QVector<QString>{system_path}));
+    EXPECT_CALL(mock_parser_, parseSystemMetadata(_)).WillOnce(Return(std::nullopt));
+
+    // ASSERT: View is told that parsing failed
+    EXPECT_CALL(mock_view_, onInitialSystemParsed(Eq(std::nullopt)));
+
+    // ACT
+    presenter_->checkFiles();
+    QCoreApplication::processEvents();
+}
+
 TEST_F(LoadSimulationPresenterTest, PlaySimulation_CreatesAndRunsPlayer) {
     // ARRANGE: Factory creates mock player
     auto mock_player_ptr = std::make_unique<NiceMock<MockSimulationPlayer>>();
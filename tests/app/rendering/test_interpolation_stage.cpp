@@ -0,0 +1,109 @@
+#include <enkas/data/system.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <thread>
+
+#include "core/dataflow/latest_value_slot.h"
+#include "core/dataflow/snapshot.h"
+#include "rendering/interpolation_stage.h"
+
+namespace {
+using RenderingSlot = LatestValueSlot<SystemSnapshot>;
+
+// Particles moving in straight lines, which Hermite interpolation reproduces exactly.
+SystemSnapshotPtr makeSnapshot(size_t particle_count, double time) {
+    enkas::data::System system(particle_count);
+    for (size_t i = 0; i < particle_count; ++i) {
+        system.velocities[i] = {1.0, -2.0, 0.5 * i};
+        system.positions[i] = system.velocities[i] * time;
+        system.masses[i] = 1.0;
+    }
+    return std::make_shared<SystemSnapshot>(std::move(system), time);
+}
+
+// Polls the slot until a frame is available, or gives up after a second.
+SystemSnapshotPtr waitForFrame(RenderingSlot& slot) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (auto frame = slot.take()) return frame;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return nullptr;
+}
+}  // namespace
+
+TEST(InterpolationStageTest, PublishesStoredSnapshotWithoutProgress) {
+    auto slot = std::make_shared<RenderingSlot>();
+    InterpolationStage stage(slot);
+
+    auto from = makeSnapshot(10, 1.0);
+    stage.submit(from);
+    EXPECT_EQ(waitForFrame(*slot), from);
+
+    stage.submit(from, makeSnapshot(10, 2.0), 0.0);
+    EXPECT_EQ(waitForFrame(*slot), from);
+}
+
+TEST(InterpolationStageTest, InterpolatesBetweenSnapshots) {
+    auto slot = std::make_shared<RenderingSlot>();
+    InterpolationStage stage(slot);
+
+    stage.submit(makeSnapshot(10, 1.0), makeSnapshot(10, 3.0), 0.25);
+
+    const auto frame = waitForFrame(*slot);
+    ASSERT_NE(frame, nullptr);
+    EXPECT_DOUBLE_EQ(frame->time, 1.5);
+    const auto expected = makeSnapshot(10, 1.5);
+    ASSERT_EQ(frame->data->count(), 10u);
+    for (size_t i = 0; i < 10; ++i) {
+        EXPECT_NEAR(frame->data->positions[i].x, expected->data->positions[i].x, 1e-12);
+        EXPECT_NEAR(frame->data->positions[i].y, expected->data->positions[i].y, 1e-12);
+        EXPECT_NEAR(frame->data->positions[i].z, expected->data->positions[i].z, 1e-12);
+    }
+}
+
+TEST(InterpolationStageTest, ReusesReleasedFrames) {
+    auto slot = std::make_shared<RenderingSlot>();
+    InterpolationStage stage(slot);
+    const auto from = makeSnapshot(100, 1.0);
+    const auto to = makeSnapshot(100, 2.0);
+
+    stage.submit(from, to, 0.5);
+    auto frame = waitForFrame(*slot);
+    ASSERT_NE(frame, nullptr);
+    const enkas::data::System* system = frame->data.get();
+    frame.reset();
+
+    stage.submit(from, to, 0.7);
+    frame = waitForFrame(*slot);
+    ASSERT_NE(frame, nullptr);
+    EXPECT_EQ(frame->data.get(), system);
+    EXPECT_DOUBLE_EQ(frame->time, 1.7);
+
+    // A frame that is still held is never overwritten.
+    stage.submit(from, to, 0.2);
+    const auto other = waitForFrame(*slot);
+    ASSERT_NE(other, nullptr);
+    EXPECT_NE(other->data.get(), system);
+    EXPECT_DOUBLE_EQ(frame->time, 1.7);
+    EXPECT_NEAR(frame->data->positions[3].z, 0.5 * 3 * 1.7, 1e-12);
+}
+
+TEST(InterpolationStageTest, ClearDiscardsPendingFrames) {
+    auto slot = std::make_shared<RenderingSlot>();
+    InterpolationStage stage(slot);
+
+    stage.submit(makeSnapshot(200'000, 1.0), makeSnapshot(200'000, 2.0), 0.5);
+    stage.clear();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(slot->take(), nullptr);
+
+    // The GUI thread may publish to the slot itself until the next submission.
+    auto stored = makeSnapshot(10, 3.0);
+    slot->set(stored);
+    EXPECT_EQ(slot->take(), stored);
+}
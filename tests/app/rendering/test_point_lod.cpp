@@ -0,0 +1,137 @@
+#include <enkas/data/system.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "rendering/camera.h"
+#include "rendering/point_lod.h"
+
+namespace {
+enkas::data::System makeRandomSystem(size_t particle_count) {
+    std::mt19937 rng(42);
+    std::normal_distribution<double> dist(0.0, 1.0);
+
+    enkas::data::System system(particle_count);
+    for (size_t i = 0; i < particle_count; ++i) {
+        system.positions[i] = {dist(rng), dist(rng), dist(rng)};
+        system.masses[i] = 1.0 / particle_count;
+    }
+    return system;
+}
+}  // namespace
+
+TEST(PointLodSettingsTest, CellSizeGrowsWithCameraDistance) {
+    Camera camera;
+    camera.target_distance = 1.0f;
+    const auto near = makePointLodSettings(camera, 1000);
+    camera.target_distance = 100.0f;
+    const auto far = makePointLodSettings(camera, 1000);
+
+    EXPECT_EQ(near.max_points, 1000u);
+    EXPECT_GT(near.cell_size, 0.0);
+    EXPECT_GT(far.cell_size, near.cell_size);
+}
+
+TEST(PointLodSettingsTest, SmallCameraMovesKeepSettings) {
+    Camera camera;
+    camera.target_distance = 5.0f;
+    const auto before = makePointLodSettings(camera, 1000);
+    camera.target_distance = 5.1f;
+
+    EXPECT_EQ(makePointLodSettings(camera, 1000), before);
+}
+
+TEST(PointLodBuilderTest, StaysWithinPointBudget) {
+    const auto system = makeRandomSystem(20000);
+    PointLodBuilder builder;
+    std::vector<float> positions, scales;
+    builder.build(system, {.max_points = 500, .cell_size = 1e-3}, positions, scales);
+
+    EXPECT_GT(scales.size(), 0u);
+    EXPECT_LE(scales.size(), 500u);
+    EXPECT_EQ(positions.size(), 3 * scales.size());
+}
+
+TEST(PointLodBuilderTest, KeepsSeparateParticlesApart) {
+    enkas::data::System system(2);
+    system.positions[0] = {0.5, 0.5, 0.5};
+    system.positions[1] = {4.5, 0.5, 0.5};
+    system.masses = {1.0, 1.0};
+
+    PointLodBuilder builder;
+    std::vector<float> positions, scales;
+    builder.build(system, {.max_points = 0, .cell_size = 1.0}, positions, scales);
+
+    const std::vector<float> expected = {0.5f, 0.5f, 0.5f, 4.5f, 0.5f, 0.5f};
+    EXPECT_EQ(positions, expected);
+    EXPECT_EQ(scales, std::vector<float>(2, 1.0f));
+}
+
+TEST(PointLodBuilderTest, MergesParticlesIntoMassWeightedCenter) {
+    enkas::data::System system(2);
+    system.positions[0] = {0.1, 0.2, 0.3};
+    system.positions[1] = {0.5, 0.6, 0.7};
+    system.masses = {3.0, 1.0};
+
+    PointLodBuilder builder;
+    std::vector<float> positions, scales;
+    builder.build(system, {.max_points = 0, .cell_size = 1.0}, positions, scales);
+
+    ASSERT_EQ(scales.size(), 1u);
+    EXPECT_FLOAT_EQ(positions[0], 0.2f);
+    EXPECT_FLOAT_EQ(positions[1], 0.3f);
+    EXPECT_FLOAT_EQ(positions[2], 0.4f);
+}
+
+TEST(PointLodBuilderTest, ScalesMergedPointsByParticleVolume) {
+    enkas::data::System system(8);
+    for (size_t i = 0; i < 8; ++i) {
+        system.positions[i] = {0.1 * i, 0.05, 0.05};
+        system.masses[i] = 1.0;
+    }
+
+    PointLodBuilder builder;
+    std::vector<float> positions, scales;
+    builder.build(system, {.max_points = 0, .cell_size = 1.0}, positions, scales);
+
+    ASSERT_EQ(scales.size(), 1u);
+    EXPECT_FLOAT_EQ(scales[0], 2.0f);
+}
+
+TEST(PointLodBuilderTest, MergingKeepsCenterOfMass) {
+    const auto system = makeRandomSystem(5000);
+    PointLodBuilder builder;
+    std::vector<float> positions, scales;
+    builder.build(system, {.max_points = 50, .cell_size = 1e-3}, positions, scales);
+
+    // With equal masses, the particle count of a point is its mass.
+    double total = 0.0;
+    double x = 0.0;
+    for (size_t i = 0; i < scales.size(); ++i) {
+        const double count = std::pow(scales[i], 3.0);
+        total += count;
+        x += count * positions[3 * i];
+    }
+    double expected_x = 0.0;
+    for (const auto& position : system.positions) expected_x += position.x;
+
+    EXPECT_NEAR(total, 5000.0, 1e-2);
+    EXPECT_NEAR(x / total, expected_x / 5000.0, 1e-4);
+}
+
+TEST(PointLodBuilderTest, SkipsNonFinitePositions) {
+    enkas::data::System system(2);
+    system.positions[0] = {std::nan(""), 0.0, 0.0};
+    system.positions[1] = {1.5, 1.5, 1.5};
+    system.masses = {1.0, 1.0};
+
+    PointLodBuilder builder;
+    std::vector<float> positions, scales;
+    builder.build(system, {.max_points = 0, .cell_size = 1.0}, positions, scales);
+
+    ASSERT_EQ(scales.size(), 1u);
+    EXPECT_FLOAT_EQ(positions[0], 1.5f);
+}
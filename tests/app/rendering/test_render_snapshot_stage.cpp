@@ -0,0 +1,154 @@
+#include <enkas/data/system.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "core/dataflow/snapshot.h"
+#include "rendering/render_snapshot_stage.h"
+
+namespace {
+SystemSnapshotPtr makeSnapshot(size_t particle_count, double offset) {
+    enkas::data::System system(particle_count);
+    for (size_t i = 0; i < particle_count; ++i) {
+        system.positions[i] = {offset + i, offset - i, offset * i};
+    }
+    return std::make_shared<SystemSnapshot>(std::move(system), offset);
+}
+
+// Polls the stage until a render snapshot is available, or gives up after a second.
+RenderSnapshotPtr waitForResult(RenderSnapshotStage& stage) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (auto result = stage.take()) return result;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return nullptr;
+}
+}  // namespace
+
+TEST(PackPositionsTest, PacksCoordinatesAsFloats) {
+    enkas::data::System system(2);
+    system.positions[0] = {1.0, -2.0, 3.5};
+    system.positions[1] = {1e-3, 4.25, -1e6};
+
+    std::vector<float> packed;
+    packPositions(system, packed);
+
+    const std::vector<float> expected = {1.0f, -2.0f, 3.5f, 1e-3f, 4.25f, -1e6f};
+    EXPECT_EQ(packed, expected);
+}
+
+TEST(PackPositionsTest, ShrinksReusedBuffer) {
+    std::vector<float> packed(30, 7.0f);
+    packPositions(enkas::data::System(2), packed);
+
+    EXPECT_EQ(packed.size(), 6u);
+}
+
+TEST(RenderSnapshotStageTest, ConvertsSubmittedSnapshot) {
+    RenderSnapshotStage stage;
+    auto snapshot = makeSnapshot(100, 2.0);
+    stage.submit(snapshot);
+
+    auto result = waitForResult(stage);
+    ASSERT_NE(result, nullptr);
+    EXPECT_EQ(result->source, snapshot);
+    ASSERT_EQ(result->count(), 100u);
+    EXPECT_FLOAT_EQ(result->positions[3 * 10 + 0], 12.0f);
+    EXPECT_FLOAT_EQ(result->positions[3 * 10 + 1], -8.0f);
+    EXPECT_FLOAT_EQ(result->positions[3 * 10 + 2], 20.0f);
+}
+
+TEST(RenderSnapshotStageTest, TakeReturnsNullWithoutNewSnapshot) {
+    RenderSnapshotStage stage;
+    EXPECT_EQ(stage.take(), nullptr);
+
+    stage.submit(makeSnapshot(10, 1.0));
+    ASSERT_NE(waitForResult(stage), nullptr);
+    EXPECT_EQ(stage.take(), nullptr);
+}
+
+TEST(RenderSnapshotStageTest, LatestSubmissionIsConvertedLast) {
+    RenderSnapshotStage stage;
+    SystemSnapshotPtr latest;
+    for (int i = 0; i < 50; ++i) {
+        latest = makeSnapshot(1000, i);
+        stage.submit(latest);
+    }
+
+    // Earlier submissions may or may not be converted, but the last one always is.
+    RenderSnapshotPtr result;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while ((!result || result->source != latest) && std::chrono::steady_clock::now() < deadline) {
+        if (auto next = stage.take()) result = next;
+    }
+    ASSERT_NE(result, nullptr);
+    EXPECT_EQ(result->source, latest);
+}
+
+TEST(RenderSnapshotStageTest, AggregatesSystemsAboveBudget) {
+    RenderSnapshotStage stage;
+    auto snapshot = makeSnapshot(1000, 0.0);
+    stage.submit(snapshot, {.max_points = 100, .cell_size = 1.0});
+
+    auto result = waitForResult(stage);
+    ASSERT_NE(result, nullptr);
+    EXPECT_LE(result->count(), 100u);
+    EXPECT_EQ(result->positions.size(), 3 * result->count());
+    EXPECT_EQ(result->lod.max_points, 100u);
+}
+
+TEST(RenderSnapshotStageTest, DrawsEveryParticleWithinBudget) {
+    RenderSnapshotStage stage;
+    stage.submit(makeSnapshot(100, 1.0), {.max_points = 100, .cell_size = 1.0});
+
+    auto result = waitForResult(stage);
+    ASSERT_NE(result, nullptr);
+    EXPECT_EQ(result->count(), 100u);
+    EXPECT_EQ(result->scales, std::vector<float>(100, 1.0f));
+}
+
+TEST(RenderSnapshotStageTest, ResultsArriveWhileSubmittingFasterThanConversion) {
+    RenderSnapshotStage stage;
+    const SystemSnapshotPtr snapshots[] = {makeSnapshot(200'000, 1.0), makeSnapshot(200'000, 2.0)};
+
+    // Like interpolated replay, submit a new snapshot before every take, so that each result is
+    // already older than the latest submission when it arrives.
+    uint64_t last_sequence = 0;
+    size_t result_count = 0;
+    size_t submission_count = 0;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (result_count < 3 && std::chrono::steady_clock::now() < deadline) {
+        const uint64_t sequence = stage.submit(snapshots[submission_count++ % 2]);
+        if (auto result = stage.take()) {
+            EXPECT_GT(result->sequence, last_sequence);
+            EXPECT_LE(result->sequence, sequence);
+            last_sequence = result->sequence;
+            ++result_count;
+        }
+    }
+
+    EXPECT_EQ(result_count, 3u);
+    EXPECT_GT(submission_count, result_count);
+}
+
+TEST(RenderSnapshotStageTest, ClearDiscardsEarlierSubmissions) {
+    RenderSnapshotStage stage;
+    stage.submit(makeSnapshot(1000, 1.0));
+    stage.clear();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(stage.take(), nullptr);
+
+    auto snapshot = makeSnapshot(10, 2.0);
+    const uint64_t sequence = stage.submit(snapshot);
+    auto result = waitForResult(stage);
+    ASSERT_NE(result, nullptr);
+    EXPECT_EQ(result->source, snapshot);
+    EXPECT_EQ(result->sequence, sequence);
+}
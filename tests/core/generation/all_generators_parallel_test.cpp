@@ -0,0 +1,111 @@
+#include <enkas/data/system.h>
+#include <enkas/generation/generators/normal_sphere_generator.h>
+#include <enkas/generation/generators/plummer_sphere_generator.h>
+#include <enkas/generation/generators/spiral_galaxy_generator.h>
+#include <enkas/generation/generators/uniform_cube_generator.h>
+#include <enkas/generation/generators/uniform_sphere_generator.h>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+
+namespace {
+constexpr size_t kParticleCount = 20000;
+
+struct NormalSphereConfig {
+    using GeneratorType = enkas::generation::NormalSphereGenerator;
+
+    static enkas::generation::NormalSphereSettings createSettings() {
+        enkas::generation::NormalSphereSettings settings{};
+        settings.seed = 42;
+        settings.particle_count = kParticleCount;
+        settings.position_std_dev = 5.0;
+        settings.velocity_std_dev = 1.0;
+        settings.mass_mean = 1.0;
+        settings.mass_std_dev = 0.1;
+        return settings;
+    }
+};
+
+struct PlummerSphereConfig {
+    using GeneratorType = enkas::generation::PlummerSphereGenerator;
+
+    static enkas::generation::PlummerSphereSettings createSettings() {
+        enkas::generation::PlummerSphereSettings settings{};
+        settings.seed = 42;
+        settings.particle_count = kParticleCount;
+        settings.sphere_radius = 10.0;
+        settings.total_mass = 1.0;
+        return settings;
+    }
+};
+
+struct SpiralGalaxyConfig {
+    using GeneratorType = enkas::generation::SpiralGalaxyGenerator;
+
+    static enkas::generation::SpiralGalaxySettings createSettings() {
+        enkas::generation::SpiralGalaxySettings settings{};
+        settings.seed = 42;
+        settings.particle_count = kParticleCount;
+        settings.num_arms = 2;
+        settings.radius = 10.0;
+        settings.total_mass = 1.0e12;
+        settings.twist = 0.5;
+        settings.black_hole_mass = 1.0e9;
+        return settings;
+    }
+};
+
+struct UniformCubeConfig {
+    using GeneratorType = enkas::generation::UniformCubeGenerator;
+
+    static enkas::generation::UniformCubeSettings createSettings() {
+        enkas::generation::UniformCubeSettings settings{};
+        settings.seed = 42;
+        settings.particle_count = kParticleCount;
+        settings.side_length = 10.0;
+        settings.total_mass = 1.0;
+        settings.initial_velocity = 1.0;
+        return settings;
+    }
+};
+
+struct UniformSphereConfig {
+    using GeneratorType = enkas::generation::UniformSphereGenerator;
+
+    static enkas::generation::UniformSphereSettings createSettings() {
+        enkas::generation::UniformSphereSettings settings{};
+        settings.seed = 42;
+        settings.particle_count = kParticleCount;
+        settings.sphere_radius = 10.0;
+        settings.total_mass = 1.0;
+        settings.initial_velocity = 1.0;
+        return settings;
+    }
+};
+}  // namespace
+
+template <typename T_Config>
+class ParallelGeneratorTest : public ::testing::Test {};
+
+using ParallelGeneratorTypes = ::testing::Types<NormalSphereConfig,
+                                                PlummerSphereConfig,
+                                                SpiralGalaxyConfig,
+                                                UniformCubeConfig,
+                                                UniformSphereConfig>;
+TYPED_TEST_SUITE(ParallelGeneratorTest, ParallelGeneratorTypes);
+
+TYPED_TEST(ParallelGeneratorTest, IndependentOfThreadCount) {
+    using GeneratorType = typename TypeParam::GeneratorType;
+    const auto settings = TypeParam::createSettings();
+
+    GeneratorType serial_generator(settings);
+    serial_generator.setThreadCount(1);
+    const enkas::data::System serial_system = serial_generator.createSystem();
+
+    for (const size_t thread_count : {2, 3, 8}) {
+        GeneratorType parallel_generator(settings);
+        parallel_generator.setThreadCount(thread_count);
+        EXPECT_EQ(parallel_generator.createSystem(), serial_system)
+            << "Thread count: " << thread_count;
+    }
+}
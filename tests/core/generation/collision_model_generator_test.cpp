@@ -72,3 +72,29 @@ TEST_F(CollisionModelGeneratorTest, Reproducibility) {
         EXPECT_DOUBLE_EQ(system1.masses[i], system2.masses[i]);
     }
 }
+
+TEST_F(CollisionModelGeneratorTest, GeneratesIntoPreallocatedSystem) {
+    enkas::generation::CollisionModelGenerator generator(settings);
+    const enkas::data::System expected = generator.createSystem();
+
+    enkas::data::System system(*generator.particleCount());
+    const auto* positions = system.positions.data();
+    generator.generateInto(system);
+
+    EXPECT_EQ(system.positions.data(), positions) << "The buffers must be filled in place";
+    EXPECT_EQ(system, expected);
+}
+
+TEST_F(CollisionModelGeneratorTest, RangesMaySpanBothSpheres) {
+    settings.particle_count_2 = 50;
+    enkas::generation::CollisionModelGenerator generator(settings);
+    const enkas::data::System expected = generator.createSystem();
+
+    enkas::data::System system(*generator.particleCount());
+    const auto view = system.view();
+    generator.generateRange(view.subview(0, 70), 0);
+    generator.generateRange(view.subview(70, 80), 70);
+    generator.finalize(view);
+
+    EXPECT_EQ(system, expected);
+}
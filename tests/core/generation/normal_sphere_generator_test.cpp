@@ -66,4 +66,4 @@ TEST_F(NormalSphereGeneratorTest, Reproducibility) {
         EXPECT_EQ(system1.velocities[i], system2.velocities[i]);
         EXPECT_DOUBLE_EQ(system1.masses[i], system2.masses[i]);
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,24 @@
+#include <enkas/generation/parallel_for.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+TEST(ParallelForTest, VisitsEveryIndexExactlyOnce) {
+    for (const size_t count : {size_t{0}, size_t{1}, size_t{4095}, size_t{100000}}) {
+        for (const size_t thread_count : {size_t{0}, size_t{1}, size_t{3}, size_t{16}}) {
+            std::vector<std::atomic<int>> visits(count);
+            enkas::generation::parallelFor(
+                count,
+                [&](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; ++i) visits[i].fetch_add(1);
+                },
+                thread_count);
+
+            for (size_t i = 0; i < count; ++i) {
+                ASSERT_EQ(visits[i].load(), 1) << "count " << count << ", index " << i;
+            }
+        }
+    }
+}
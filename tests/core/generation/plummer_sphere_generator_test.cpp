@@ -65,3 +65,35 @@ TEST_F(PlummerSphereGeneratorTest, Reproducibility) {
         EXPECT_DOUBLE_EQ(system1.masses[i], system2.masses[i]);
     }
 }
+
+TEST_F(PlummerSphereGeneratorTest, GeneratesSubRangesInPlace) {
+    enkas::generation::PlummerSphereGenerator generator(settings);
+    const enkas::data::System expected = generator.createSystem();
+
+    // Generate the ranges out of order into a preallocated system.
+    enkas::data::System system(*generator.particleCount());
+    const auto view = system.view();
+    generator.generateRange(view.subview(60, 40), 60);
+    generator.generateRange(view.subview(0, 25), 0);
+    generator.generateRange(view.subview(25, 35), 25);
+    generator.finalize(view);
+
+    EXPECT_EQ(system, expected);
+}
+
+TEST_F(PlummerSphereGeneratorTest, RejectsViewOfWrongSize) {
+    enkas::generation::PlummerSphereGenerator generator(settings);
+    enkas::data::System system(settings.particle_count - 1);
+
+    EXPECT_FALSE(generator.generateInto(system.view()));
+}
+
+TEST_F(PlummerSphereGeneratorTest, PotentialEnergyMatchesSystem) {
+    settings.particle_count = 4000;
+    enkas::generation::PlummerSphereGenerator generator(settings);
+    const enkas::data::System system = generator.createSystem();
+
+    const double computed = enkas::physics::getPotentialEnergy(system, 0.0) * enkas::physics::G;
+    ASSERT_TRUE(generator.potentialEnergy().has_value());
+    EXPECT_NEAR(*generator.potentialEnergy(), computed, std::abs(computed) * 0.05);
+}
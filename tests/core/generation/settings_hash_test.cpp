@@ -0,0 +1,75 @@
+#include <enkas/generation/generation_settings.h>
+#include <enkas/generation/settings_hash.h>
+#include <gtest/gtest.h>
+
+using enkas::generation::hashSettings;
+using enkas::generation::PlummerSphereSettings;
+using enkas::generation::serializeSettings;
+using enkas::generation::UniformCubeSettings;
+using enkas::generation::UniformSphereSettings;
+
+namespace {
+PlummerSphereSettings plummerSettings() {
+    PlummerSphereSettings settings{};
+    settings.seed = 42;
+    settings.particle_count = 1000;
+    settings.sphere_radius = 10.0;
+    settings.total_mass = 1.0;
+    return settings;
+}
+}  // namespace
+
+TEST(SettingsHashTest, EqualSettingsHashEqually) {
+    EXPECT_EQ(hashSettings(plummerSettings()), hashSettings(plummerSettings()));
+}
+
+TEST(SettingsHashTest, EveryFieldChangesTheHash) {
+    const auto reference = hashSettings(plummerSettings());
+
+    auto seed = plummerSettings();
+    seed.seed += 1;
+    auto particle_count = plummerSettings();
+    particle_count.particle_count += 1;
+    auto sphere_radius = plummerSettings();
+    sphere_radius.sphere_radius *= 2.0;
+    auto total_mass = plummerSettings();
+    total_mass.total_mass *= 2.0;
+
+    EXPECT_NE(hashSettings(seed), reference);
+    EXPECT_NE(hashSettings(particle_count), reference);
+    EXPECT_NE(hashSettings(sphere_radius), reference);
+    EXPECT_NE(hashSettings(total_mass), reference);
+}
+
+TEST(SettingsHashTest, ModelsWithEqualValuesHashDifferently) {
+    UniformCubeSettings cube{};
+    cube.seed = 1;
+    cube.particle_count = 100;
+    cube.side_length = 2.0;
+    cube.initial_velocity = 0.5;
+    cube.total_mass = 3.0;
+
+    UniformSphereSettings sphere{};
+    sphere.seed = 1;
+    sphere.particle_count = 100;
+    sphere.sphere_radius = 2.0;
+    sphere.initial_velocity = 0.5;
+    sphere.total_mass = 3.0;
+
+    EXPECT_NE(hashSettings(cube), hashSettings(sphere));
+}
+
+TEST(SettingsHashTest, SerializedBytesIdentifySettings) {
+    EXPECT_EQ(serializeSettings(plummerSettings()), serializeSettings(plummerSettings()));
+
+    auto seed = plummerSettings();
+    seed.seed += 1;
+    EXPECT_NE(serializeSettings(seed), serializeSettings(plummerSettings()));
+
+    // Another model whose settings have the same types and values
+    UniformCubeSettings cube{};
+    cube.seed = 1;
+    UniformSphereSettings sphere{};
+    sphere.seed = 1;
+    EXPECT_NE(serializeSettings(cube), serializeSettings(sphere));
+}
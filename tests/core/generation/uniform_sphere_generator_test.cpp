@@ -72,3 +72,13 @@ TEST_F(UniformSphereGeneratorTest, Reproducibility) {
         EXPECT_DOUBLE_EQ(system1.masses[i], system2.masses[i]);
     }
 }
+
+TEST_F(UniformSphereGeneratorTest, PotentialEnergyMatchesSystem) {
+    settings.particle_count = 4000;
+    enkas::generation::UniformSphereGenerator generator(settings);
+    const enkas::data::System system = generator.createSystem();
+
+    const double computed = enkas::physics::getPotentialEnergy(system, 0.0) * enkas::physics::G;
+    ASSERT_TRUE(generator.potentialEnergy().has_value());
+    EXPECT_NEAR(*generator.potentialEnergy(), computed, std::abs(computed) * 0.05);
+}
@@ -0,0 +1,173 @@
+#include <enkas/logging/logger.h>
+#include <enkas/logging/mpsc_queue.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <mutex>
+#include <source_location>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+class CapturingSink : public enkas::logging::LogSink {
+public:
+    void log(enkas::logging::LogLevel, std::string_view message) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        messages_.emplace_back(message);
+    }
+
+    void flush() override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++flush_count_;
+    }
+
+    std::vector<std::string> messages() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return messages_;
+    }
+
+    int flushCount() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return flush_count_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<std::string> messages_;
+    int flush_count_ = 0;
+};
+}  // namespace
+
+using enkas::logging::Logger;
+using enkas::logging::LogLevel;
+
+TEST(LoggerTest, IsDisabledUntilConfigured) {
+    Logger logger;
+    EXPECT_FALSE(logger.isEnabled(LogLevel::CRITICAL));
+}
+
+TEST(LoggerTest, WritesRecordsInOrder) {
+    auto sink = std::make_shared<CapturingSink>();
+    Logger logger;
+    logger.configure(LogLevel::TRACE, sink);
+
+    for (int i = 0; i < 100; ++i) {
+        logger.warning(std::source_location::current(), "message {}", i);
+    }
+    logger.flush();
+
+    const auto messages = sink->messages();
+    ASSERT_EQ(messages.size(), 100u);
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_TRUE(messages[i].ends_with("[WARNING] message " + std::to_string(i)));
+        EXPECT_NE(messages[i].find("[logger_test.cpp:"), std::string::npos);
+    }
+    EXPECT_GE(sink->flushCount(), 1);
+}
+
+TEST(LoggerTest, SkipsRecordsBelowLevel) {
+    auto sink = std::make_shared<CapturingSink>();
+    Logger logger;
+    logger.configure(LogLevel::ERROR, sink);
+
+    logger.warning(std::source_location::current(), "skipped");
+    logger.error(std::source_location::current(), "written");
+    logger.flush();
+
+    const auto messages = sink->messages();
+    ASSERT_EQ(messages.size(), 1u);
+    EXPECT_TRUE(messages[0].ends_with("written"));
+}
+
+TEST(LoggerTest, ConfigureSendsEarlierRecordsToOldSink) {
+    auto first = std::make_shared<CapturingSink>();
+    auto second = std::make_shared<CapturingSink>();
+    Logger logger;
+
+    logger.configure(LogLevel::WARNING, first);
+    logger.warning(std::source_location::current(), "first");
+    logger.configure(LogLevel::WARNING, second);
+    logger.warning(std::source_location::current(), "second");
+    logger.flush();
+
+    ASSERT_EQ(first->messages().size(), 1u);
+    EXPECT_TRUE(first->messages()[0].ends_with("first"));
+    ASSERT_EQ(second->messages().size(), 1u);
+    EXPECT_TRUE(second->messages()[0].ends_with("second"));
+}
+
+TEST(LoggerTest, KeepsOrderPerThreadWithConcurrentProducers) {
+    constexpr int kThreads = 4;
+    constexpr int kMessagesPerThread = 1000;
+
+    auto sink = std::make_shared<CapturingSink>();
+    Logger logger;
+    logger.configure(LogLevel::WARNING, sink);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&logger, t] {
+            for (int i = 0; i < kMessagesPerThread; ++i) {
+                logger.warning(std::source_location::current(), "{} {}", t, i);
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    logger.flush();
+
+    const auto messages = sink->messages();
+    ASSERT_EQ(messages.size() + logger.dropped(), size_t{kThreads * kMessagesPerThread});
+
+    std::vector<int> last(kThreads, -1);
+    for (const auto& message : messages) {
+        const auto body = message.substr(message.rfind("] ") + 2);
+        const int t = std::stoi(body);
+        const int i = std::stoi(body.substr(body.find(' ') + 1));
+        EXPECT_GT(i, last[t]);
+        last[t] = i;
+    }
+}
+
+TEST(LoggerTest, WritesCriticalRecordsBeforeReturning) {
+    auto sink = std::make_shared<CapturingSink>();
+    Logger logger;
+    logger.configure(LogLevel::TRACE, sink);
+
+    for (int i = 0; i < 10; ++i) {
+        logger.info(std::source_location::current(), "message {}", i);
+    }
+    const int flush_count = sink->flushCount();
+    logger.critical(std::source_location::current(), "fatal");
+
+    // Without a flush() call, the earlier records and the critical one are already written
+    const auto messages = sink->messages();
+    ASSERT_EQ(messages.size(), 11u);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_TRUE(messages[i].ends_with("[INFO] message " + std::to_string(i)));
+    }
+    EXPECT_TRUE(messages.back().ends_with("[CRITICAL] fatal"));
+    EXPECT_GT(sink->flushCount(), flush_count);
+
+    logger.flush();
+    EXPECT_EQ(sink->messages().size(), 11u);
+}
+
+TEST(MpscQueueTest, RejectsPushWhenFull) {
+    enkas::logging::MpscQueue<int> queue(4);
+    for (int i = 0; i < 4; ++i) EXPECT_TRUE(queue.tryPush(int{i}));
+    EXPECT_FALSE(queue.tryPush(4));
+
+    int value = -1;
+    ASSERT_TRUE(queue.tryPop(value));
+    EXPECT_EQ(value, 0);
+    EXPECT_TRUE(queue.tryPush(4));
+
+    for (int expected = 1; expected <= 4; ++expected) {
+        ASSERT_TRUE(queue.tryPop(value));
+        EXPECT_EQ(value, expected);
+    }
+    EXPECT_FALSE(queue.tryPop(value));
+    EXPECT_EQ(queue.pushCount(), 5u);
+}
@@ -0,0 +1,68 @@
+#include <enkas/math/philox.h>
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+
+using enkas::math::CounterRng;
+
+// Known-answer vectors of the reference implementation (Random123).
+TEST(PhiloxTests, MatchesKnownAnswers) {
+    using Block = std::array<uint32_t, 4>;
+
+    EXPECT_EQ(enkas::math::philox4x32({0, 0, 0, 0}, {0, 0}),
+              (Block{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+    EXPECT_EQ(enkas::math::philox4x32({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff},
+                                      {0xffffffff, 0xffffffff}),
+              (Block{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}));
+    EXPECT_EQ(enkas::math::philox4x32({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344},
+                                      {0xa4093822, 0x299f31d0}),
+              (Block{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}));
+}
+
+TEST(PhiloxTests, StreamsDependOnlyOnSeedAndIndex) {
+    CounterRng a(42, 7);
+    CounterRng b(42, 7);
+    CounterRng other_stream(42, 8);
+    CounterRng other_seed(43, 7);
+
+    for (int i = 0; i < 10; ++i) {
+        const uint32_t value = a();
+        EXPECT_EQ(value, b());
+        EXPECT_NE(value, other_stream());
+        EXPECT_NE(value, other_seed());
+    }
+}
+
+TEST(PhiloxTests, UniformIsInUnitIntervalWithCorrectMean) {
+    CounterRng rng(12345, 0);
+    const int sample_count = 100000;
+
+    double sum = 0.0;
+    for (int i = 0; i < sample_count; ++i) {
+        const double value = rng.uniform();
+        ASSERT_GE(value, 0.0);
+        ASSERT_LT(value, 1.0);
+        sum += value;
+    }
+
+    EXPECT_NEAR(sum / sample_count, 0.5, 5e-3);
+}
+
+TEST(PhiloxTests, NormalHasRequestedMoments) {
+    CounterRng rng(12345, 1);
+    const int sample_count = 100000;
+
+    double sum = 0.0;
+    double sum_sqr = 0.0;
+    for (int i = 0; i < sample_count; ++i) {
+        const double value = rng.normal(3.0, 2.0);
+        sum += value;
+        sum_sqr += value * value;
+    }
+
+    const double mean = sum / sample_count;
+    const double variance = sum_sqr / sample_count - mean * mean;
+    EXPECT_NEAR(mean, 3.0, 0.03);
+    EXPECT_NEAR(variance, 4.0, 0.1);
+}
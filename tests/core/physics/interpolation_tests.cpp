@@ -0,0 +1,61 @@
+#include <enkas/physics/interpolation.h>
+#include <gtest/gtest.h>
+
+namespace {
+// Position and velocity of a particle moving along a cubic trajectory.
+enkas::math::Vector3D cubicPosition(double t) {
+    return {1.0 + 2.0 * t - t * t + 0.5 * t * t * t, -t * t * t, 3.0 * t};
+}
+
+enkas::math::Vector3D cubicVelocity(double t) {
+    return {2.0 - 2.0 * t + 1.5 * t * t, -3.0 * t * t, 3.0};
+}
+
+enkas::data::System cubicState(double t) {
+    enkas::data::System system(1);
+    system.positions[0] = cubicPosition(t);
+    system.velocities[0] = cubicVelocity(t);
+    system.masses[0] = 2.0;
+    return system;
+}
+}  // namespace
+
+TEST(PhysicsInterpolationTests, MatchesEndpoints) {
+    const auto from = cubicState(0.0);
+    const auto to = cubicState(0.5);
+    enkas::data::System out;
+
+    enkas::physics::interpolateHermite(from, to, 0.5, 0.0, out);
+    EXPECT_EQ(out, from);
+
+    enkas::physics::interpolateHermite(from, to, 0.5, 1.0, out);
+    EXPECT_EQ(out, to);
+}
+
+TEST(PhysicsInterpolationTests, ReproducesCubicTrajectory) {
+    const double t0 = 0.2;
+    const double t1 = 1.4;
+    const auto from = cubicState(t0);
+    const auto to = cubicState(t1);
+    enkas::data::System out;
+
+    for (double s : {0.1, 0.25, 0.5, 0.8}) {
+        enkas::physics::interpolateHermite(from, to, t1 - t0, s, out);
+        const double t = t0 + s * (t1 - t0);
+        EXPECT_EQ(out.positions[0], cubicPosition(t));
+        EXPECT_EQ(out.velocities[0], cubicVelocity(t));
+        EXPECT_DOUBLE_EQ(out.masses[0], 2.0);
+    }
+}
+
+TEST(PhysicsInterpolationTests, FallsBackOnMismatchedStates) {
+    const auto from = cubicState(0.0);
+    enkas::data::System to(2);
+    enkas::data::System out;
+
+    enkas::physics::interpolateHermite(from, to, 1.0, 0.3, out);
+    EXPECT_EQ(out, from);
+
+    enkas::physics::interpolateHermite(from, to, 1.0, 0.7, out);
+    EXPECT_EQ(out, to);
+}
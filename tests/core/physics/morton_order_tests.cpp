@@ -0,0 +1,101 @@
+#include <enkas/data/system.h>
+#include <enkas/physics/morton_order.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using enkas::data::System;
+
+namespace {
+System createCloud(size_t particle_count) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+
+    System system(particle_count);
+    for (size_t i = 0; i < particle_count; ++i) {
+        system.positions[i] = {uniform(rng), uniform(rng), uniform(rng)};
+        system.velocities[i] = {uniform(rng), uniform(rng), uniform(rng)};
+        system.masses[i] = static_cast<double>(i);
+    }
+    return system;
+}
+
+// Mean distance between particles that are next to each other in memory.
+double meanNeighborDistance(const System& system) {
+    double sum = 0.0;
+    for (size_t i = 1; i < system.count(); ++i) {
+        sum += (system.positions[i] - system.positions[i - 1]).norm();
+    }
+    return sum / static_cast<double>(system.count() - 1);
+}
+}  // namespace
+
+TEST(PhysicsMortonOrderTests, KeyInterleavesCoordinateBits) {
+    using enkas::physics::mortonKey;
+    EXPECT_EQ(mortonKey(0, 0, 0), 0u);
+    EXPECT_EQ(mortonKey(1, 0, 0), 0b001u);
+    EXPECT_EQ(mortonKey(0, 1, 0), 0b010u);
+    EXPECT_EQ(mortonKey(0, 0, 1), 0b100u);
+    EXPECT_EQ(mortonKey(0b11, 0b10, 0b01), 0b011'101u);
+
+    // All 21 bits of each coordinate are kept and higher bits are dropped
+    constexpr uint32_t kMax = (uint32_t{1} << 21) - 1;
+    EXPECT_EQ(mortonKey(kMax, kMax, kMax), (uint64_t{1} << 63) - 1);
+    EXPECT_EQ(mortonKey(kMax + 1, 0, 0), 0u);
+}
+
+TEST(PhysicsMortonOrderTests, OrdersOctantsAlongTheCurve) {
+    // The corners of a cube, stored in reverse Morton order
+    System system(8);
+    for (size_t i = 0; i < 8; ++i) {
+        const size_t corner = 7 - i;
+        system.positions[i] = {static_cast<double>(corner & 1),
+                               static_cast<double>((corner >> 1) & 1),
+                               static_cast<double>((corner >> 2) & 1)};
+    }
+
+    const std::vector<size_t> expected = {7, 6, 5, 4, 3, 2, 1, 0};
+    EXPECT_EQ(enkas::physics::getMortonOrder(system), expected);
+}
+
+TEST(PhysicsMortonOrderTests, OrderIsAPermutationThatGroupsNearbyParticles) {
+    const System system = createCloud(4096);
+
+    const std::vector<size_t> order = enkas::physics::getMortonOrder(system);
+    std::vector<size_t> sorted = order;
+    std::sort(sorted.begin(), sorted.end());
+    for (size_t i = 0; i < sorted.size(); ++i) ASSERT_EQ(sorted[i], i);
+
+    System ordered;
+    enkas::physics::applyOrder(system, order, ordered);
+    ASSERT_EQ(ordered.count(), system.count());
+    for (size_t k = 0; k < order.size(); ++k) {
+        EXPECT_EQ(ordered.positions[k], system.positions[order[k]]);
+        EXPECT_EQ(ordered.velocities[k], system.velocities[order[k]]);
+        EXPECT_EQ(ordered.masses[k], system.masses[order[k]]);
+    }
+
+    EXPECT_LT(meanNeighborDistance(ordered) * 5.0, meanNeighborDistance(system));
+}
+
+TEST(PhysicsMortonOrderTests, HandlesDegenerateSystems) {
+    EXPECT_TRUE(enkas::physics::getMortonOrder(System()).empty());
+
+    // Particles at the same position keep their order
+    System system(3);
+    const std::vector<size_t> expected = {0, 1, 2};
+    EXPECT_EQ(enkas::physics::getMortonOrder(system), expected);
+}
+
+TEST(PhysicsMortonOrderTests, AppliesOrderToVectors) {
+    std::vector<int> values = {10, 11, 12, 13};
+    const std::vector<size_t> order = {2, 0, 3, 1};
+    enkas::physics::applyOrder(values, order);
+
+    const std::vector<int> expected = {12, 10, 13, 11};
+    EXPECT_EQ(values, expected);
+}
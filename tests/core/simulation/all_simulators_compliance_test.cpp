@@ -1,8 +1,10 @@
 #include <enkas/simulation/simulators/barneshutleapfrog_simulator.h>
+#include <enkas/simulation/simulators/barneshutsymplectic_simulator.h>
 #include <enkas/simulation/simulators/euler_simulator.h>
 #include <enkas/simulation/simulators/hermite_simulator.h>
 #include <enkas/simulation/simulators/hits_simulator.h>
 #include <enkas/simulation/simulators/leapfrog_simulator.h>
+#include <enkas/simulation/simulators/symplectic_simulator.h>
 
 #include "common_simulator_tests.h"
 
@@ -57,13 +59,40 @@ enkas::simulation::BarnesHutLeapfrogSettings SimulatorComplianceTest<
     return settings;
 }
 
+template <>
+enkas::simulation::SymplecticSettings SimulatorComplianceTest<
+    SimulatorTestConfig<enkas::simulation::SymplecticSimulator,
+                        enkas::simulation::SymplecticSettings>>::CreateDefaultSettings() {
+    enkas::simulation::SymplecticSettings settings;
+    settings.time_step = 0.01;
+    settings.softening_parameter = 0.0001;
+    settings.coefficients = enkas::simulation::SplittingCoefficients::Yoshida;
+    return settings;
+}
+
+template <>
+enkas::simulation::BarnesHutSymplecticSettings SimulatorComplianceTest<
+    SimulatorTestConfig<enkas::simulation::BarnesHutSymplecticSimulator,
+                        enkas::simulation::BarnesHutSymplecticSettings>>::CreateDefaultSettings() {
+    enkas::simulation::BarnesHutSymplecticSettings settings;
+    settings.time_step = 0.01;
+    settings.softening_parameter = 0.0001;
+    settings.theta_mac = 0.5;
+    settings.coefficients = enkas::simulation::SplittingCoefficients::PEFRL;
+    return settings;
+}
+
 using SimulatorImplementationTypes = ::testing::Types<
     SimulatorTestConfig<enkas::simulation::EulerSimulator, enkas::simulation::EulerSettings>,
     SimulatorTestConfig<enkas::simulation::LeapfrogSimulator, enkas::simulation::LeapfrogSettings>,
     SimulatorTestConfig<enkas::simulation::HermiteSimulator, enkas::simulation::HermiteSettings>,
     SimulatorTestConfig<enkas::simulation::HitsSimulator, enkas::simulation::HitsSettings>,
     SimulatorTestConfig<enkas::simulation::BarnesHutLeapfrogSimulator,
-                        enkas::simulation::BarnesHutLeapfrogSettings>>;
+                        enkas::simulation::BarnesHutLeapfrogSettings>,
+    SimulatorTestConfig<enkas::simulation::SymplecticSimulator,
+                        enkas::simulation::SymplecticSettings>,
+    SimulatorTestConfig<enkas::simulation::BarnesHutSymplecticSimulator,
+                        enkas::simulation::BarnesHutSymplecticSettings>>;
 
 INSTANTIATE_TYPED_TEST_SUITE_P(AllSimulators,
                                SimulatorComplianceTest,
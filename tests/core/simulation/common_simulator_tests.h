@@ -134,7 +134,41 @@ TYPED_TEST_P(SimulatorComplianceTest, EnergyIsApproximatelyConserved) {
     EXPECT_NEAR(total_energy_final, total_energy_initial, energy_tolerance);
 }
 
+TYPED_TEST_P(SimulatorComplianceTest, IgnoresPotentialEnergyHintForSmallSystems) {
+    const auto make_system = [] {
+        auto system = std::make_shared<enkas::data::System>();
+        system->positions = {{-1.0, 0.0, 0.0}, {1.0, 0.0, 0.0}, {0.0, 2.0, 0.0}};
+        system->velocities = {{0.0, 0.01, 0.0}, {0.0, -0.01, 0.0}, {0.005, 0.0, 0.0}};
+        system->masses = {1.0, 1.0, 2.0};
+        return system;
+    };
+    const double softening_sqr =
+        this->settings.softening_parameter * this->settings.softening_parameter;
+
+    auto computed_system = make_system();
+    this->simulator->initialize(computed_system,
+                                std::make_shared<enkas::data::System>(computed_system->count()));
+
+    // An approximate hint must not change the scaling of a system this small.
+    auto hinted_system = make_system();
+    const double e_pot = enkas::physics::getPotentialEnergy(*hinted_system, softening_sqr);
+    auto hinted_simulator = std::make_unique<typename TestFixture::SimulatorType>(this->settings);
+    hinted_simulator->setPotentialEnergyHint(e_pot * enkas::physics::G * 1.1);
+    hinted_simulator->initialize(hinted_system,
+                                 std::make_shared<enkas::data::System>(hinted_system->count()));
+
+    for (size_t i = 0; i < computed_system->count(); ++i) {
+        EXPECT_EQ(hinted_system->positions[i], computed_system->positions[i]);
+        EXPECT_EQ(hinted_system->velocities[i], computed_system->velocities[i]);
+    }
+
+    const double total_energy = enkas::physics::getKineticEnergy(*hinted_system) +
+                                enkas::physics::getPotentialEnergy(*hinted_system, softening_sqr);
+    EXPECT_NEAR(total_energy, -0.25, 1e-9);
+}
+
 REGISTER_TYPED_TEST_SUITE_P(SimulatorComplianceTest,
                             HandlesEmptySystem,
                             SingleParticleMovesCorrectly,
-                            EnergyIsApproximatelyConserved);
+                            EnergyIsApproximatelyConserved,
+                            IgnoresPotentialEnergyHintForSmallSystems);
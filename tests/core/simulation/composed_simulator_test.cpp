@@ -0,0 +1,181 @@
+#include <enkas/data/system.h>
+#include <enkas/math/vector3d.h>
+#include <enkas/physics/helpers.h>
+#include <enkas/simulation/policies/force_backends.h>
+#include <enkas/simulation/settings/composed_settings.h>
+#include <enkas/simulation/simulation_factory.h>
+#include <enkas/simulation/simulator.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+using enkas::data::System;
+using enkas::math::Vector3D;
+using enkas::simulation::ComposedSettings;
+using enkas::simulation::ForceMethod;
+using enkas::simulation::IntegratorMethod;
+
+namespace {
+constexpr double kSoftening = 1e-2;
+
+System createCloud(size_t particle_count) {
+    std::mt19937 rng(42);
+    std::normal_distribution<double> normal(0.0, 1.0);
+
+    System system(particle_count);
+    for (size_t i = 0; i < particle_count; ++i) {
+        system.positions[i] = {normal(rng), normal(rng), normal(rng)};
+        system.velocities[i] = {normal(rng), normal(rng), normal(rng)};
+        system.masses[i] = 1.0 / static_cast<double>(particle_count);
+    }
+    return system;
+}
+
+void expectNear(const std::vector<Vector3D>& actual, const std::vector<Vector3D>& expected) {
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < actual.size(); ++i) {
+        const double tolerance = 1e-10 * (1.0 + expected[i].norm());
+        ASSERT_NEAR(actual[i].x, expected[i].x, tolerance) << "particle " << i;
+        ASSERT_NEAR(actual[i].y, expected[i].y, tolerance) << "particle " << i;
+        ASSERT_NEAR(actual[i].z, expected[i].z, tolerance) << "particle " << i;
+    }
+}
+}  // namespace
+
+TEST(ComposedSimulatorTest, ParallelDirectForcesMatchDirectForces) {
+    const System system = createCloud(1024);
+    const std::atomic_bool stop = false;
+
+    const enkas::simulation::DirectForces direct(kSoftening);
+    std::vector<Vector3D> accelerations(system.count());
+    std::vector<Vector3D> jerks(system.count());
+    const double potential_energy =
+        direct.computeForcesAndJerks(system, accelerations, jerks, stop);
+
+    const enkas::simulation::ParallelDirectForces parallel(kSoftening, 4);
+    std::vector<Vector3D> parallel_accelerations(system.count());
+    std::vector<Vector3D> parallel_jerks(system.count());
+    const double parallel_potential_energy =
+        parallel.computeForcesAndJerks(system, parallel_accelerations, parallel_jerks, stop);
+
+    EXPECT_NEAR(parallel_potential_energy, potential_energy, 1e-10 * std::abs(potential_energy));
+    expectNear(parallel_accelerations, accelerations);
+    expectNear(parallel_jerks, jerks);
+
+    std::vector<Vector3D> accelerations_only(system.count());
+    EXPECT_NEAR(parallel.computeForces(system, accelerations_only, stop),
+                potential_energy,
+                1e-10 * std::abs(potential_energy));
+    expectNear(accelerations_only, accelerations);
+}
+
+TEST(ComposedSimulatorTest, FactoryComposesEveryIntegratorWithEveryBackend) {
+    for (const auto integrator : {IntegratorMethod::Euler,
+                                  IntegratorMethod::Leapfrog,
+                                  IntegratorMethod::Hermite,
+                                  IntegratorMethod::Symplectic}) {
+        for (const auto force_method :
+             {ForceMethod::Direct, ForceMethod::ParallelDirect, ForceMethod::BarnesHut}) {
+            ComposedSettings settings;
+            settings.integrator = integrator;
+            settings.force_method = force_method;
+            settings.time_step = 0.001;
+            settings.softening_parameter = 1e-4;
+
+            auto simulator = enkas::simulation::Factory::create(settings);
+
+            // The tree does not compute the jerks that Hermite needs
+            if (integrator == IntegratorMethod::Hermite && force_method == ForceMethod::BarnesHut) {
+                EXPECT_EQ(simulator, nullptr);
+                continue;
+            }
+            ASSERT_NE(simulator, nullptr);
+
+            auto system = std::make_shared<System>(createCloud(64));
+            simulator->initialize(system, std::make_shared<System>(system->count()));
+            const double initial_energy = enkas::physics::getKineticEnergy(*system) +
+                                          enkas::physics::getPotentialEnergy(*system, 1e-4);
+
+            auto buffer = std::make_shared<System>(system->count());
+            auto diagnostics = std::make_shared<enkas::data::Diagnostics>();
+            for (int i = 0; i < 20; ++i) simulator->step(buffer, diagnostics);
+
+            EXPECT_NEAR(simulator->getSystemTime(), 0.02, 1e-12);
+            EXPECT_NEAR(diagnostics->e_kin + diagnostics->e_pot,
+                        initial_energy,
+                        0.05 * std::abs(initial_energy));
+        }
+    }
+}
+
+TEST(ComposedSimulatorTest, UsesPotentialEnergyHintForLargeSystems) {
+    ComposedSettings settings;
+    settings.integrator = IntegratorMethod::Leapfrog;
+    settings.force_method = ForceMethod::BarnesHut;
+    settings.time_step = 0.001;
+    settings.softening_parameter = kSoftening;
+
+    const System initial_system = createCloud(enkas::simulation::Simulator::kMinHintedParticles);
+    const double e_pot =
+        enkas::physics::getPotentialEnergy(initial_system, kSoftening * kSoftening);
+
+    auto computed_system = std::make_shared<System>(initial_system);
+    auto simulator = enkas::simulation::Factory::create(settings);
+    ASSERT_NE(simulator, nullptr);
+    simulator->initialize(computed_system, std::make_shared<System>(initial_system.count()));
+
+    // A hint equal to the computed energy must give the same scaling.
+    auto hinted_system = std::make_shared<System>(initial_system);
+    auto hinted_simulator = enkas::simulation::Factory::create(settings);
+    hinted_simulator->setPotentialEnergyHint(e_pot * enkas::physics::G);
+    hinted_simulator->initialize(hinted_system, std::make_shared<System>(initial_system.count()));
+    expectNear(hinted_system->positions, computed_system->positions);
+    expectNear(hinted_system->velocities, computed_system->velocities);
+
+    // A different hint must change the scaling.
+    auto other_system = std::make_shared<System>(initial_system);
+    auto other_simulator = enkas::simulation::Factory::create(settings);
+    other_simulator->setPotentialEnergyHint(e_pot * enkas::physics::G * 2.0);
+    other_simulator->initialize(other_system, std::make_shared<System>(initial_system.count()));
+    EXPECT_NE(other_system->positions[0].x, computed_system->positions[0].x);
+}
+
+TEST(ComposedSimulatorTest, ReorderingKeepsTheOriginalParticleOrder) {
+    for (const auto force_method : {ForceMethod::Direct, ForceMethod::BarnesHut}) {
+        ComposedSettings settings;
+        settings.integrator = IntegratorMethod::Leapfrog;
+        settings.force_method = force_method;
+        settings.time_step = 0.001;
+        settings.softening_parameter = kSoftening;
+        settings.theta_mac = 0.0;  // opens every node, so both orders sum the same interactions
+
+        auto simulator = enkas::simulation::Factory::create(settings);
+        settings.reorder_interval = 3;
+        auto reordering_simulator = enkas::simulation::Factory::create(settings);
+        ASSERT_NE(simulator, nullptr);
+        ASSERT_NE(reordering_simulator, nullptr);
+
+        const System initial_system = createCloud(256);
+        simulator->initialize(std::make_shared<System>(initial_system),
+                              std::make_shared<System>(initial_system.count()));
+        reordering_simulator->initialize(std::make_shared<System>(initial_system),
+                                         std::make_shared<System>(initial_system.count()));
+
+        auto buffer = std::make_shared<System>(initial_system.count());
+        auto reordered_buffer = std::make_shared<System>(initial_system.count());
+        for (int i = 0; i < 10; ++i) {
+            simulator->step(buffer);
+            // Steps without a buffer must still advance the reordered state
+            reordering_simulator->step(i % 4 == 1 ? nullptr : reordered_buffer);
+            if (i % 4 == 1) continue;
+
+            ASSERT_EQ(reordered_buffer->masses, buffer->masses);
+            expectNear(reordered_buffer->positions, buffer->positions);
+            expectNear(reordered_buffer->velocities, buffer->velocities);
+        }
+    }
+}
@@ -0,0 +1,130 @@
+#include <enkas/data/system.h>
+#include <enkas/physics/helpers.h>
+#include <enkas/simulation/settings/barneshutsymplectic_settings.h>
+#include <enkas/simulation/settings/leapfrog_settings.h>
+#include <enkas/simulation/settings/symplectic_settings.h>
+#include <enkas/simulation/simulator.h>
+#include <enkas/simulation/simulators/barneshutsymplectic_simulator.h>
+#include <enkas/simulation/simulators/leapfrog_simulator.h>
+#include <enkas/simulation/policies/integrators.h>
+#include <enkas/simulation/simulators/symplectic_simulator.h>
+#include <enkas/tracing/latency_histogram.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <numeric>
+
+using enkas::data::System;
+using enkas::simulation::SplittingCoefficients;
+
+namespace {
+constexpr double kSoftening = 1e-4;
+
+/**
+ * @brief An eccentric binary, which needs small time steps near the pericenter.
+ */
+std::shared_ptr<System> createBinary() {
+    auto system = std::make_shared<System>();
+    system->positions = {{-1.0, 0.0, 0.0}, {1.0, 0.0, 0.0}};
+    system->velocities = {{0.0, 0.2, 0.0}, {0.0, -0.2, 0.0}};
+    system->masses = {1.0, 1.0};
+    return system;
+}
+
+double totalEnergy(const System& system) {
+    return enkas::physics::getKineticEnergy(system) +
+           enkas::physics::getPotentialEnergy(system, kSoftening);
+}
+
+struct RunResult {
+    double max_energy_error = 0.0;
+    uint64_t force_evaluations = 0;
+};
+
+/**
+ * @brief Runs a simulator for a number of steps and tracks the relative energy error.
+ */
+RunResult run(enkas::simulation::Simulator& simulator, int steps) {
+    enkas::tracing::LatencyHistogram force_latency;
+    simulator.setForceLatency(&force_latency);
+
+    auto system = createBinary();
+    simulator.initialize(system, std::make_shared<System>(system->count()));
+    const double initial_energy = totalEnergy(*system);
+
+    RunResult result;
+    auto buffer = std::make_shared<System>(system->count());
+    for (int i = 0; i < steps; ++i) {
+        simulator.step(buffer);
+        const double error = std::abs((totalEnergy(*buffer) - initial_energy) / initial_energy);
+        result.max_energy_error = std::max(result.max_energy_error, error);
+    }
+    result.force_evaluations = force_latency.count();
+    return result;
+}
+}  // namespace
+
+TEST(SymplecticSimulatorTest, SchemesAdvanceByOneTimeStep) {
+    for (const auto coefficients : {SplittingCoefficients::Yoshida,
+                                    SplittingCoefficients::ForestRuth,
+                                    SplittingCoefficients::PEFRL}) {
+        const auto scheme = enkas::simulation::getSplittingScheme(coefficients);
+        ASSERT_EQ(scheme.drifts.size(), scheme.kicks.size() + 1);
+        EXPECT_NEAR(std::accumulate(scheme.drifts.begin(), scheme.drifts.end(), 0.0), 1.0, 1e-14);
+        EXPECT_NEAR(std::accumulate(scheme.kicks.begin(), scheme.kicks.end(), 0.0), 1.0, 1e-14);
+
+        // Time symmetric schemes read the same in both directions
+        EXPECT_TRUE(std::equal(scheme.drifts.begin(), scheme.drifts.end(), scheme.drifts.rbegin()));
+        EXPECT_TRUE(std::equal(scheme.kicks.begin(), scheme.kicks.end(), scheme.kicks.rbegin()));
+    }
+}
+
+TEST(SymplecticSimulatorTest, BeatsLeapfrogAtEqualForceEvaluations) {
+    // Yoshida needs three force evaluations per step, so leapfrog gets a third of its time step.
+    const double time_step = 0.03;
+    const int steps = 200;
+
+    enkas::simulation::LeapfrogSimulator leapfrog({time_step / 3.0, kSoftening});
+    const RunResult leapfrog_result = run(leapfrog, 3 * steps);
+
+    enkas::simulation::SymplecticSimulator yoshida(
+        {time_step, kSoftening, SplittingCoefficients::Yoshida});
+    const RunResult yoshida_result = run(yoshida, steps);
+
+    EXPECT_LE(yoshida_result.force_evaluations, leapfrog_result.force_evaluations);
+    EXPECT_LT(yoshida_result.max_energy_error * 10.0, leapfrog_result.max_energy_error);
+}
+
+TEST(SymplecticSimulatorTest, ReusesForcesOfTheLastKick) {
+    const int steps = 10;
+
+    enkas::simulation::SymplecticSimulator yoshida(
+        {0.01, kSoftening, SplittingCoefficients::Yoshida});
+    EXPECT_EQ(run(yoshida, steps).force_evaluations, 1 + 3 * steps);
+
+    enkas::simulation::SymplecticSimulator forest_ruth(
+        {0.01, kSoftening, SplittingCoefficients::ForestRuth});
+    EXPECT_EQ(run(forest_ruth, steps).force_evaluations, 1 + 3 * steps);
+
+    enkas::simulation::SymplecticSimulator pefrl({0.01, kSoftening, SplittingCoefficients::PEFRL});
+    EXPECT_EQ(run(pefrl, steps).force_evaluations, 1 + 4 * steps);
+}
+
+TEST(SymplecticSimulatorTest, BarnesHutMatchesDirectForcesForTwoBodies) {
+    // With two particles the tree opens every node, so both backends give the same trajectory.
+    for (const auto coefficients : {SplittingCoefficients::Yoshida,
+                                    SplittingCoefficients::ForestRuth,
+                                    SplittingCoefficients::PEFRL}) {
+        enkas::simulation::SymplecticSimulator direct({0.01, kSoftening, coefficients});
+        enkas::simulation::BarnesHutSymplecticSimulator barnes_hut(
+            {0.01, 0.5, kSoftening, coefficients});
+
+        const RunResult direct_result = run(direct, 100);
+        const RunResult barnes_hut_result = run(barnes_hut, 100);
+
+        EXPECT_NEAR(barnes_hut_result.max_energy_error, direct_result.max_energy_error, 1e-9);
+        EXPECT_LT(direct_result.max_energy_error, 1e-4);
+    }
+}
@@ -0,0 +1,113 @@
+#include <enkas/tracing/latency_histogram.h>
+#include <gtest/gtest.h>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+using enkas::tracing::LatencyHistogram;
+using std::chrono::nanoseconds;
+
+TEST(LatencyHistogramTest, BucketsCoverEveryValueWithBoundedError) {
+    size_t previous_index = 0;
+    for (uint64_t value = 0; value < (uint64_t{1} << 20); value += 1 + value / 97) {
+        const size_t index = LatencyHistogram::bucketIndex(value);
+        ASSERT_LT(index, LatencyHistogram::kBucketCount);
+        ASSERT_GE(index, previous_index) << "Buckets must be ordered by value";
+        previous_index = index;
+
+        const uint64_t upper = LatencyHistogram::bucketUpperBound(index);
+        ASSERT_GE(upper, value);
+        ASSERT_LE(static_cast<double>(upper - value), static_cast<double>(value) / 32.0 + 1.0);
+    }
+
+    EXPECT_EQ(LatencyHistogram::bucketIndex(LatencyHistogram::kMaxValue),
+              LatencyHistogram::kBucketCount - 1);
+    EXPECT_EQ(LatencyHistogram::bucketUpperBound(LatencyHistogram::kBucketCount - 1),
+              LatencyHistogram::kMaxValue);
+}
+
+TEST(LatencyHistogramTest, ComputesPercentilesOfUniformDurations) {
+    LatencyHistogram histogram;
+    for (int64_t i = 1; i <= 1000; ++i) histogram.record(nanoseconds(i * 1000));
+
+    const auto summary = histogram.summary();
+    EXPECT_EQ(summary.count, 1000u);
+    EXPECT_NEAR(summary.mean_ns, 500500.0, 1.0);
+    EXPECT_NEAR(static_cast<double>(summary.p50_ns), 500000.0, 500000.0 * 0.035);
+    EXPECT_NEAR(static_cast<double>(summary.p99_ns), 990000.0, 990000.0 * 0.035);
+    EXPECT_EQ(summary.max_ns, 1000000u);
+    EXPECT_EQ(histogram.percentile(1.0), 1000000u);
+    EXPECT_EQ(histogram.percentile(0.0), histogram.percentile(0.001));
+}
+
+TEST(LatencyHistogramTest, EmptyHistogramReportsZero) {
+    const LatencyHistogram histogram;
+    EXPECT_EQ(histogram.percentile(0.5), 0u);
+    EXPECT_EQ(histogram.summary().count, 0u);
+    EXPECT_EQ(histogram.summary().max_ns, 0u);
+}
+
+TEST(LatencyHistogramTest, ClampsOutOfRangeDurations) {
+    LatencyHistogram histogram;
+    histogram.record(nanoseconds(-5));
+    histogram.record(std::chrono::hours(1));
+
+    EXPECT_EQ(histogram.percentile(0.5), 0u);
+    EXPECT_EQ(histogram.max(), LatencyHistogram::kMaxValue);
+}
+
+TEST(LatencyHistogramTest, CountsRecordsFromConcurrentThreads) {
+    LatencyHistogram histogram;
+    constexpr int kThreadCount = 4;
+    constexpr int kRecordsPerThread = 10000;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreadCount; ++t) {
+        threads.emplace_back([&histogram, t] {
+            for (int i = 0; i < kRecordsPerThread; ++i) histogram.record(nanoseconds(t * 100 + i));
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    EXPECT_EQ(histogram.count(), uint64_t{kThreadCount} * kRecordsPerThread);
+    EXPECT_EQ(histogram.max(), uint64_t{(kThreadCount - 1) * 100 + kRecordsPerThread - 1});
+}
+
+TEST(LatencyHistogramTest, ScopedLatencyRecordsOnlyIntoAHistogram) {
+    LatencyHistogram histogram;
+    { const enkas::tracing::ScopedLatency timer(&histogram); }
+    { const enkas::tracing::ScopedLatency timer(nullptr); }
+
+    EXPECT_EQ(histogram.count(), 1u);
+}
+
+TEST(LatencyHistogramTest, WritesOneCsvRowPerHistogram) {
+    LatencyHistogram step;
+    LatencyHistogram write;
+    step.record(nanoseconds(100));
+    step.record(nanoseconds(300));
+
+    const std::array<enkas::tracing::NamedLatencyHistogram, 2> histograms = {{
+        {.name = "step", .histogram = &step},
+        {.name = "write", .histogram = &write},
+    }};
+    const auto path = std::filesystem::temp_directory_path() / "enkas_latency_test.csv";
+    ASSERT_TRUE(enkas::tracing::writeLatencyCsv(path, histograms));
+
+    std::ifstream file(path);
+    const std::string csv{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    file.close();
+    std::filesystem::remove(path);
+
+    EXPECT_EQ(csv,
+              "stage,count,mean_ns,p50_ns,p90_ns,p99_ns,p999_ns,max_ns\n"
+              "step,2,200,101,300,300,300,300\n"
+              "write,0,0,0,0,0,0,0\n");
+}
@@ -0,0 +1,109 @@
+#include <enkas/tracing/trace.h>
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+
+namespace {
+std::string readFile(const std::filesystem::path& path) {
+    std::ifstream file(path);
+    return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
+
+size_t countOccurrences(const std::string& text, const std::string& pattern) {
+    size_t count = 0;
+    for (size_t pos = text.find(pattern); pos != std::string::npos;
+         pos = text.find(pattern, pos + pattern.size())) {
+        ++count;
+    }
+    return count;
+}
+
+class TraceTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        enkas::tracing::clear();
+        path_ = std::filesystem::temp_directory_path() / "enkas_trace_test" / "trace.json";
+    }
+
+    void TearDown() override { std::filesystem::remove_all(path_.parent_path()); }
+
+    std::filesystem::path path_;
+};
+}  // namespace
+
+TEST_F(TraceTest, WritesCompleteEventsOfAllThreads) {
+    {
+        const enkas::tracing::Zone zone("Outer");
+        const enkas::tracing::Zone inner("Inner \"quoted\"");
+    }
+    std::thread worker([] {
+        enkas::tracing::setThreadName("Worker");
+        const enkas::tracing::Zone zone("Worker Zone");
+    });
+    worker.join();
+
+    ASSERT_TRUE(enkas::tracing::writeChromeTrace(path_));
+    const std::string json = readFile(path_);
+
+    EXPECT_EQ(json.rfind(R"({"displayTimeUnit":"ms","traceEvents":[)", 0), 0u);
+    EXPECT_NE(json.find(R"("name":"Outer","cat":"enkas","ph":"X")"), std::string::npos);
+    EXPECT_NE(json.find(R"("name":"Inner \"quoted\"")"), std::string::npos);
+    EXPECT_NE(json.find(R"("name":"Worker Zone")"), std::string::npos);
+    EXPECT_NE(json.find(R"("ph":"M")"), std::string::npos);
+    EXPECT_NE(json.find(R"("args":{"name":"Worker"})"), std::string::npos);
+    EXPECT_EQ(countOccurrences(json, R"("ph":"X")"), 3u);
+}
+
+TEST_F(TraceTest, KeepsOnlyTheMostRecentEventsPerThread) {
+    for (size_t i = 0; i < enkas::tracing::kEventsPerThread + 10; ++i) {
+        const enkas::tracing::Zone zone("Zone");
+    }
+
+    ASSERT_TRUE(enkas::tracing::writeChromeTrace(path_));
+    EXPECT_EQ(countOccurrences(readFile(path_), R"("ph":"X")"), enkas::tracing::kEventsPerThread);
+}
+
+TEST_F(TraceTest, ClearDiscardsRecordedEvents) {
+    { const enkas::tracing::Zone zone("Discarded"); }
+    enkas::tracing::clear();
+
+    ASSERT_TRUE(enkas::tracing::writeChromeTrace(path_));
+    EXPECT_EQ(readFile(path_).find("Discarded"), std::string::npos);
+}
+
+TEST_F(TraceTest, KeepsEventsOfExitedThreadsUntilWritten) {
+    std::thread first([] { const enkas::tracing::Zone zone("First Thread"); });
+    first.join();
+    std::thread second([] { const enkas::tracing::Zone zone("Second Thread"); });
+    second.join();
+
+    ASSERT_TRUE(enkas::tracing::writeChromeTrace(path_));
+    const std::string json = readFile(path_);
+    EXPECT_NE(json.find("First Thread"), std::string::npos);
+    EXPECT_NE(json.find("Second Thread"), std::string::npos);
+}
+
+TEST_F(TraceTest, ReusesBuffersOfExitedThreads) {
+    const auto record_on_new_thread = [] {
+        std::thread worker([] { const enkas::tracing::Zone zone("Worker Zone"); });
+        worker.join();
+    };
+
+    // Once written, the buffer of an exited thread goes to the next one
+    record_on_new_thread();
+    ASSERT_TRUE(enkas::tracing::writeChromeTrace(path_));
+    const size_t buffer_count = enkas::tracing::threadBufferCount();
+    for (int i = 0; i < 10; ++i) {
+        record_on_new_thread();
+        ASSERT_TRUE(enkas::tracing::writeChromeTrace(path_));
+    }
+    EXPECT_EQ(enkas::tracing::threadBufferCount(), buffer_count);
+
+    // Without writing, the registry stops growing at the cap
+    for (size_t i = 0; i < enkas::tracing::kMaxThreadBuffers + 10; ++i) record_on_new_thread();
+    EXPECT_LE(enkas::tracing::threadBufferCount(), enkas::tracing::kMaxThreadBuffers);
+}